@@ -0,0 +1,255 @@
+// *************************************** BlackboxToCsv.cpp *****************************************
+
+// Converts the transmitter's blackbox.bbx (see TransmitterCode/include/Blackbox.h) to CSV, and prints a summary.
+//
+// Build:   g++ -std=c++14 -O2 -o BlackboxToCsv BlackboxToCsv.cpp
+// Use:     BlackboxToCsv blackbox.bbx [flight.csv] [--all]
+//
+// Without a CSV filename the CSV goes to stdout and the summary to stderr.
+// Only the latest session (the last power-on that recorded anything) is converted unless --all is given.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define BLACKBOXMAGIC 0x4242444C // "LDBB"
+#define BLACKBOXVERSION 2 // Version 1 files (no WriteAt) are read too
+#define BLACKBOXHEADERSIZE 512
+#define PAYLOADSIZE 6
+#define BLACKBOX_ACKED 1
+#define BLACKBOX_CHANNELS 2
+#define BLACKBOX_PARAMETERS 4
+#define BLACKBOX_MODELMATCHED 8
+#define LONGGAP 100 // ms. Gaps at least this long are counted in the summary
+
+// These two must match 1Definitions.h. (The Teensy and a PC are both little endian.)
+
+struct BlackboxFileHeader
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t RecordSize;
+    uint32_t Session;
+    uint32_t StartTime;
+    uint32_t FileSize;
+    char ModelName[32];
+    uint32_t WriteAt;
+};
+
+struct BlackboxRecord
+{
+    uint32_t Session;
+    uint32_t Sequence;
+    uint32_t Time;
+    uint16_t Channels[16];
+    uint16_t Gap;
+    uint16_t Switches;
+    uint8_t Ack[PAYLOADSIZE];
+    uint8_t HopChannel;
+    uint8_t Retries;
+    uint8_t Flags;
+    uint8_t Bank;
+    uint8_t ChannelsSent;
+    uint8_t Spare[5];
+};
+static_assert(sizeof(BlackboxRecord) == 64, "BlackboxRecord must be 64 bytes");
+
+/*********************************************************************************************************************************/
+
+bool EarlierRecord(const BlackboxRecord &a, const BlackboxRecord &b)
+{
+    if (a.Session != b.Session)
+        return a.Session < b.Session;
+    return a.Sequence < b.Sequence;
+}
+
+/*********************************************************************************************************************************/
+
+void WriteCsv(FILE *Out, const std::vector<BlackboxRecord> &Records)
+{
+    fprintf(Out, "session,sequence,time_ms");
+    for (int i = 1; i <= 16; ++i)
+        fprintf(Out, ",ch%d", i);
+    fprintf(Out, ",gap_ms,switches,trim_switches,ack_item,ack_data0,ack_data1,ack_data2,ack_data3,ack_next_hop,hop_channel,retries,"
+                 "acked,channels_in_packet,parameters_in_packet,model_matched,bank,items_sent\n");
+    for (const BlackboxRecord &R : Records)
+    {
+        fprintf(Out, "%u,%u,%u", R.Session, R.Sequence, R.Time);
+        for (int i = 0; i < 16; ++i)
+            fprintf(Out, ",%u", R.Channels[i]);
+        fprintf(Out, ",%u,0x%02X,0x%02X", R.Gap, R.Switches & 0xFF, R.Switches >> 8);
+        fprintf(Out, ",%u", R.Ack[0] & 0x7F);
+        for (int i = 1; i < PAYLOADSIZE; ++i)
+            fprintf(Out, ",%u", R.Ack[i]);
+        fprintf(Out, ",%u,%u,%d,%d,%d,%d,%u,%u\n", R.HopChannel, R.Retries, (R.Flags & BLACKBOX_ACKED) != 0,
+                (R.Flags & BLACKBOX_CHANNELS) != 0, (R.Flags & BLACKBOX_PARAMETERS) != 0, (R.Flags & BLACKBOX_MODELMATCHED) != 0,
+                R.Bank, R.ChannelsSent);
+    }
+}
+
+/*********************************************************************************************************************************/
+
+void WriteSummary(FILE *Out, const BlackboxFileHeader &Header, const std::vector<BlackboxRecord> &Records)
+{
+    uint64_t Acked = 0;
+    uint64_t RetriesTotal = 0;
+    uint64_t RetriesHistogram[16] = {0};
+    uint64_t Dropped = 0;
+    uint64_t LongGaps = 0;
+    uint64_t Hops = 0;
+    uint64_t BankChanges = 0;
+    uint32_t LongestGap = 0;
+    uint32_t LongestGapAt = 0;
+    uint16_t ChannelMin[16];
+    uint16_t ChannelMax[16];
+    bool ChannelUsed[84] = {false};
+
+    fprintf(Out, "Model:            %s\n", Header.ModelName);
+    fprintf(Out, "Records:          %zu\n", Records.size());
+    if (Records.empty())
+        return;
+    for (int i = 0; i < 16; ++i)
+    {
+        ChannelMin[i] = 0xFFFF;
+        ChannelMax[i] = 0;
+    }
+    for (size_t n = 0; n < Records.size(); ++n)
+    {
+        const BlackboxRecord &R = Records[n];
+        if (R.Flags & BLACKBOX_ACKED)
+            ++Acked;
+        RetriesTotal += R.Retries;
+        ++RetriesHistogram[R.Retries & 15];
+        if (R.Gap > LongestGap)
+        {
+            LongestGap = R.Gap;
+            LongestGapAt = R.Time;
+        }
+        if (R.HopChannel < 84)
+            ChannelUsed[R.HopChannel] = true;
+        for (int i = 0; i < 16; ++i)
+        {
+            ChannelMin[i] = std::min(ChannelMin[i], R.Channels[i]);
+            ChannelMax[i] = std::max(ChannelMax[i], R.Channels[i]);
+        }
+        if (!n || (Records[n - 1].Session != R.Session))
+            continue;
+        const BlackboxRecord &Previous = Records[n - 1];
+        if (R.Sequence > Previous.Sequence + 1)
+            Dropped += R.Sequence - Previous.Sequence - 1;
+        if (R.HopChannel != Previous.HopChannel)
+            ++Hops;
+        if (R.Bank != Previous.Bank)
+            ++BankChanges;
+        if ((R.Gap >= LONGGAP) && (Previous.Gap < LONGGAP))
+            ++LongGaps;
+    }
+    uint32_t Duration = Records.back().Time - Records.front().Time;
+    int HopChannelsUsed = 0;
+    for (int i = 0; i < 84; ++i)
+        HopChannelsUsed += ChannelUsed[i];
+
+    fprintf(Out, "Dropped records:  %llu\n", (unsigned long long)Dropped);
+    fprintf(Out, "Duration:         %u.%03u s\n", Duration / 1000, Duration % 1000);
+    if (Duration)
+        fprintf(Out, "Packet rate:      %.1f per second\n", (Records.size() - 1) * 1000.0 / Duration);
+    fprintf(Out, "Acknowledged:     %.2f%%\n", Acked * 100.0 / Records.size());
+    fprintf(Out, "Retries:          %llu (%.3f per packet)\n", (unsigned long long)RetriesTotal, (double)RetriesTotal / Records.size());
+    fprintf(Out, "Retries per packet: ");
+    for (int i = 0; i < 16; ++i)
+    {
+        if (RetriesHistogram[i])
+            fprintf(Out, " %d:%llu", i, (unsigned long long)RetriesHistogram[i]);
+    }
+    fprintf(Out, "\n");
+    fprintf(Out, "Longest gap:      %u ms (at %u ms)\n", LongestGap, LongestGapAt);
+    fprintf(Out, "Gaps >= %d ms:    %llu\n", LONGGAP, (unsigned long long)LongGaps);
+    fprintf(Out, "Hops:             %llu over %d channels\n", (unsigned long long)Hops, HopChannelsUsed);
+    fprintf(Out, "Bank changes:     %llu\n", (unsigned long long)BankChanges);
+    fprintf(Out, "Channel ranges:  ");
+    for (int i = 0; i < 16; ++i)
+        fprintf(Out, " %d:%u-%u", i + 1, ChannelMin[i], ChannelMax[i]);
+    fprintf(Out, "\n");
+}
+
+/*********************************************************************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    const char *InName = nullptr;
+    const char *CsvName = nullptr;
+    bool All = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--all") == 0)
+            All = true;
+        else if (!InName)
+            InName = argv[i];
+        else
+            CsvName = argv[i];
+    }
+    if (!InName)
+    {
+        fprintf(stderr, "Use: %s blackbox.bbx [flight.csv] [--all]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *In = fopen(InName, "rb");
+    if (!In)
+    {
+        fprintf(stderr, "Can't open %s\n", InName);
+        return 1;
+    }
+    BlackboxFileHeader Header;
+    if ((fread(&Header, sizeof(Header), 1, In) != 1) || (Header.Magic != BLACKBOXMAGIC))
+    {
+        fprintf(stderr, "%s is not a blackbox file\n", InName);
+        fclose(In);
+        return 1;
+    }
+    if ((Header.Version < 1) || (Header.Version > BLACKBOXVERSION) || (Header.RecordSize != sizeof(BlackboxRecord)))
+    {
+        fprintf(stderr, "%s is version %u with %u byte records. This converter reads up to version %d, %zu bytes.\n", InName,
+                Header.Version, Header.RecordSize, BLACKBOXVERSION, sizeof(BlackboxRecord));
+        fclose(In);
+        return 1;
+    }
+    Header.ModelName[sizeof(Header.ModelName) - 1] = 0;
+
+    // The file is a ring, and may hold records from earlier power-ons (and unwritten space). Keep the ones wanted, then sort.
+    // Without --all that's the latest session that has any records.
+    std::vector<BlackboxRecord> Records;
+    BlackboxRecord Record;
+    uint32_t Latest = 0;
+    fseek(In, BLACKBOXHEADERSIZE, SEEK_SET);
+    while (fread(&Record, sizeof(Record), 1, In) == 1)
+    {
+        if (!Record.Sequence || !Record.Session || (Record.Session > Header.Session))
+            continue;
+        Records.push_back(Record);
+        Latest = std::max(Latest, Record.Session);
+    }
+    fclose(In);
+    if (!All)
+        Records.erase(std::remove_if(Records.begin(), Records.end(), [Latest](const BlackboxRecord &R) { return R.Session != Latest; }),
+                      Records.end());
+    std::sort(Records.begin(), Records.end(), EarlierRecord);
+
+    FILE *Csv = stdout;
+    if (CsvName)
+    {
+        Csv = fopen(CsvName, "w");
+        if (!Csv)
+        {
+            fprintf(stderr, "Can't create %s\n", CsvName);
+            return 1;
+        }
+    }
+    WriteCsv(Csv, Records);
+    if (CsvName)
+        fclose(Csv);
+    WriteSummary(CsvName ? stdout : stderr, Header, Records);
+    return 0;
+}
@@ -45,6 +45,10 @@
 // #define DB_PACKETDATA     // Debug Packet Data
 // #define DB_Reconnect      // Debug reconnections
 // #define DB_BUILD_AGE_GAP  // Debug build age gap checking (set FAKE_BUILD_AGE_GAP to a value greater than MAX_ACCEPTABLE_AGE_GAP to see the message box)
+// #define DB_PIPELINE       // Debug channel pipeline (average time and number of curves recomputed per pass)
+// #define DB_SWITCHES       // Debug switch-to-air latency
+// #define DB_NEXTIONRENDER  // Debug time to send whole screens to the Nextion (log viewer page, scanner sweep)
+// #define DB_LOGVIEWCACHE   // Debug log/help viewer window cache (hit rate, fetch and scroll times)
 
 // ************************************************************************************
 //                                       General                                      *
@@ -54,6 +58,9 @@
 #define PACEMAKER_BUDDY 4                     // (BUDDY RATE) 4 ms = 250 Hz. MINIMUM ms between sent packets of data. These brief pauses allow the receiver to poll its i2c Sensor hub, and TX to ShowComms();
 #define PACKET_HISTORY_WINDOW 200             // For success rate calculation
 #define TIMEFORTXMANAGMENT 1                  // 1 is plenty. takes only 1ms or so
+#define PIPELINEFULLREFRESH 100               // ms between full recalculations of all channels (safety net for incremental evaluation)
+#define MAXBANKCROSSFADE 50                   // Longest bank crossfade in tenths of a second (5 seconds)
+#define MAXSLEWINTERVAL 50000                 // us. After a longer pause a slowed servo doesn't leap to catch up
 #define MAXRESOLUTION 4095                    // 12 BIT ADC Resolution
 #define CE_PIN 7                              // for SPI to nRF24L01
 #define CSN_PIN 8                             // for SPI to nRF24L01
@@ -91,6 +98,40 @@
 #define SHOWCOMMSDELAY 100                    // ms pauses between updated info on NEXTION
 #define WARMUPDELAY 300                       // fails at 200 so must be >200 ...
 #define SCREENCHANGEWAIT 20                   // allow 20ms for screen to appear
+#define NEXTIONQUEUESIZE 16384               // Bytes queued for the display
+#define NEXTIONCHUNK 64                       // Most bytes handed to the serial port at once
+#define NEXTIONCHUNKGAP 800                   // us between chunks so the display's parser can keep up
+#define NEXTIONSHADOWSIZE 128                 // Widgets whose last value is remembered (see Nextion.h)
+#define NEXTIONRXBUFFERSIZE 2048              // Added to the serial port's own receive buffer for the display
+#define NEXTIONTXBUFFERSIZE 4096              // Added to the serial port's own transmit buffer for the display
+#define NEXTIONMAXBAUD 921600                 // Fastest rate the Nextion accepts
+#define NEXTIONPROBETIMEOUT 50                // ms to wait for the display to answer at each baud rate
+#define NEXTIONBAUDCHANGEWAIT 100             // ms for the display to switch to a new baud rate
+#define NEXTIONEVENTRINGSIZE 4096             // Bytes of touch events waiting to be handled (must be a power of 2)
+#define NEXTIONEVENTS 16                      // Touch events waiting to be handled
+#define NEXTIONREPLYSIZE 256                  // Longest text reply from a "get"
+#define NEXTIONEVENTGAP 500                   // us of silence that ends a touch event
+#define NEXTIONREPLYTIMEOUT 100               // ms to wait for a reply to a "get"
+#define NEXTIONREPLYLATE 500                  // ms after which a reply is no longer expected
+#define NEXTIONGETRETRIES 3                   // GetValue() asks again this many times
+#define NEXTIONIDLE 0                         // Nextion input parser states (see Nextion.h)
+#define NEXTIONWORD 1                         //
+#define NEXTIONCODE 2                         //
+#define NEXTIONNUMBER 3                       //
+#define NEXTIONSTRING 4                       //
+#define FNV1A_SEED 2166136261u                // FNV-1a offset basis
+#define TEXTCOMMANDHASHBITS 9                 // 512 slots in the perfect hash of Nextion word commands
+#define MAXTEXTCOMMAND 16                     // Longest Nextion word command
+#define SCANCHANNELS 126                      // nRF24 channels the scanner sweeps (2.400 - 2.525 GHz)
+#define SCANSAMPLES 4                         // RPD readings per channel per sweep
+#define SCANSETTLE 170                        // us from RX enable to the first valid RPD reading (Tstby2a 130 + AGC 40)
+#define SCANSAMPLEGAP 40                      // us between RPD readings (RPD needs 40 us of signal)
+#define SCANMAXBACKLOG 2048                   // Skip drawing a sweep while this many bytes still wait for the display
+#define SCANBARS 0                            // Scanner display modes
+#define SCANPEAKHOLD 1                        //
+#define SCANWATERFALL 2                       //
+#define WATERFALLROWHEIGHT 4                  // pixels per sweep in the waterfall
+#define WATERFALLROWS 63                      // sweeps shown in the waterfall (63 * 4 fills the box)
 #define BATTERY_CHECK_INTERVAL 1000           // 2 seconds between battery checks
 #define POWERONOFFDELAY 1000                  // Delay after power OFF before transmit stops.
 #define POWERONOFFDELAY2 4000                 // Delay after power ON before Off is possible....
@@ -119,6 +160,9 @@
 #define BOXHEIGHT 395
 #define BOXBOTTOM BOXTOP + BOXHEIGHT
 #define BOXRIGHT BOXLEFT + BOXWIDTH
+#define CURVEDOTSIZE 4        // Radius of the control points on the graph
+#define MAXCURVESEGMENTS 64   // Line segments in one cached curve
+#define GRAPHCURVECACHESIZE 4 // Curves whose segments are remembered (see DisplayCurve())
 
 // **************************************************************************
 //      GOVERNOR (RF)                    *
@@ -324,6 +368,7 @@ uint8_t Saved_GOV_Profiles_Values[GOV_PROFILE_PAYLOAD_SIZE][4];
 #define SWITCH5 27
 #define SWITCH6 26
 #define SWITCH7 25
+#define SWITCHDEBOUNCECOUNT 3 // Passes a switch must agree on before its new position is accepted
 
 // **************************************************************************
 //                           TRIMS' GPIOs                                   *
@@ -476,10 +521,80 @@ uint8_t Saved_GOV_Profiles_Values[GOV_PROFILE_PAYLOAD_SIZE][4];
 //               SDCARD MODEL MEMORY CONSTANTS                              *
 //***************************************************************************
 
+#define TINYCARD SD           // The SD card library in use
 #define TXSIZE 512            // SD space reserved for transmitter (WAS  250)
 #define MODELSIZE 1024 * 3    // SD space reserved for each model (2k)
+#define SDBLOCKSIZE (MODELSIZE) // Largest part of models.dat read or written at once (a model or the TX params)
+#define MODELSTORESIZE (TXSIZE + ((MAXMODELNUMBER - 1) * MODELSIZE)) // All of models.dat, held in PSRAM (see ModelStore.h)
+#define MODELSTOREFLUSHDELAY 2000 // ms with no changes before the model store starts writing back to SD
+#define MODELCATALOGFILE "models.cat" // Index of the models in models.dat (see ModelCatalog.h)
+#define MODELSJOURNALFILE "models.jnl" // Copy of a block being saved, until it's safely in models.dat
+#define MODELSJOURNALMAGIC 0x4C4E524A // "JRNL"
+#define MODELFORMATVERSION 2          // Models with a section directory (see ModelSections.h)
+#define MODELDIRECTORYMAGIC 0x5249444D // "MDIR"
+#define MODELDIRECTORYOFFSET ((MODELSIZE) - 256) // Where in each slot the section directory goes
+#define MAXMODELSECTIONS 16           // Room in the directory
+#define MSEC_IDENTITY 1               // Model section IDs. Never reuse or renumber one.
+#define MSEC_CURVES 2                 //
+#define MSEC_MIXES 3                  //
+#define MSEC_TRIMS 4                  //
+#define MSEC_SETTINGS 5               //
+#define MSEC_CHANNELS 6               //
+#define MSEC_EXPO 7                   //
+#define MSEC_MACROS 8                 //
+#define MSEC_MODELID 9                //
+#define MSEC_OUTPUTS 10               //
+#define MSEC_ROTORFLIGHT 11           //
+#define MSEC_BANKS 12                 //
+#define MODELCATALOGMAGIC 0x4D434132 // "MCA2"
+#define MODELSGENERATIONMAGIC 0x4D47454E // "MGEN"
+#define MODELSGENERATIONADDRESS (TXSIZE - 8) // Last 8 bytes of the TX block: MODELSGENERATIONMAGIC then a count of writes to models.dat
+// Where each model's saved ID starts (bytes after its first byte). The sum follows the order in SaveOneModel():
+// defined flag, name, degrees, mixes, trims, servo speeds, 5 misc, subtrims, 2 + 4 + 2 + 2 + 1, input sticks, 4 + 1 + 4 + 1,
+// failsafes, channel names, expos, curve types, macros.
+#define MODELIDOFFSET (1 + 30 + (CHANNELSUSED * 4 * 5) + (MAXMIXES * 17) + (2 * (BANKS_USED + 1) * (CHANNELSUSED + 1)) + 5 + CHANNELSUSED + \
+                       11 + CHANNELSUSED + 10 + CHANNELSUSED + (CHANNELSUSED * 10) + (2 * (BANKS_USED + 1) * (CHANNELSUSED + 1)) +     \
+                       (BYTESPERMACRO * MAXMACROS))
 #define MAXFILELEN (1024 * 3) // 3?? MAX SIZE FOR HELP AND LOG FILES
-#define MAXBACKUPFILES 95
+#define BACKUPINDEXFILE "/mod/backups.idx" // Model backups (see BackupStore.h): one record per backup ...
+#define BACKUPDATAFILE "/mod/backups.dat"  // ... and their base images and deltas
+#define BACKUPINDEXTEMP "/mod/backups.tmp" // backups.idx while it's being tidied
+#define BACKUPRECORDMAGIC 0x504B4342       // "BCKP"
+#define MAXBACKUPENTRIES 512               // Records held in backups.idx (it's tidied when full)
+#define BACKUP_BASE 1                      // A whole model image
+#define BACKUP_DELTA 2                     // Changed byte ranges from a base image
+#define BACKUPDELTAMAX ((MODELSIZE) / 2)   // A delta longer than this is stored as a new base
+#define BACKUPDELTAGAP 4                   // Unchanged bytes that are cheaper to copy than to start a new run
+#define FILESLISTSIZE 150       // Files a file list can show
+#define MAXDIRENTRIES 256       // Files held in each directory's cache (see DirectoryCache.h)
+#define DIRECTORYKINDS 4        // Directories cached:
+#define DIR_LOG 0               //  /log/
+#define DIR_HELP 1              //  /help/
+#define DIR_BACKUPS 2           //  /mod/
+#define DIR_IMAGES 3            //  /Images/
+#define LOGRINGSIZE (1024 * 16) // RAM for log text waiting to go to SD (a power of two - see LogFiles.h)
+#define LOGWRITECHUNK 512       // Log text is written to SD a sector at a time
+#define LOGFLUSHDELAY 1000      // ms a log line may wait in RAM before it's written anyway
+#define LOGMARKS 16             // Times kept of lines waiting in LogRing
+#define LOGMARKGAP (LOGFLUSHDELAY / 8) // ms between them
+#define BLACKBOXFILE "/blackbox.bbx"         // Packet by packet flight record (see Blackbox.h)
+#define BLACKBOXMAGIC 0x4242444C             // "LDBB"
+#define BLACKBOXVERSION 2                    // 2: the header keeps WriteAt
+#define BLACKBOXFILESIZE (1024UL * 1024 * 64) // About 80 minutes at 200 packets a second, then it wraps around
+#define BLACKBOXHEADERSIZE 512               // The header has the first sector to itself
+#define BLACKBOXRECORDS 64                   // Records in each half of the double buffer (64 * 64 = 4K, eight sectors)
+#define BLACKBOXSYNCEVERY 8                  // Update the file's directory entry after this many buffers
+#define FLIGHTSFILE "/log/flights.dat"       // One summary per flight (see FlightSummaries.h)
+#define FLIGHTMAGIC 0x54484C46               // "FLHT"
+#define FLIGHTSREADCHUNK 32                  // Summaries read at once (32 * 128 = 4K)
+#define FLIGHTS_BY_SUCCESSRATE 0             // FindWorstFlights(): lowest success rate first
+#define FLIGHTS_BY_LONGESTGAP 1              //                     longest gap first
+#define WORSTFLIGHTSSHOWN 5                  // Sessions ShowWorstLinks() lists
+#define LOGSORT_DATE 0                       // Log files list: newest first
+#define LOGSORT_WORSTRATE 1                  //                 worst success rate first (from FlightDays[])
+#define LOGSORT_LONGESTGAP 2                 //                 longest gap first
+#define LOGSORT_FLIGHTTIME 3                 //                 most time connected first
+#define LOGSORTS 4                           //
 
 // **************************************************************************
 //                            SERVO RANGE PARAMETERS                        *
@@ -516,6 +631,25 @@ uint8_t Saved_GOV_Profiles_Values[GOV_PROFILE_PAYLOAD_SIZE][4];
 #define SMOOTHEDCURVES 1
 #define EXPONENTIALCURVES 2
 
+// **************************************************************************
+//                            Input filters                                 *
+// **************************************************************************
+
+#define FILTER_NONE 0                // Raw ADC value
+#define FILTER_MEDIAN 1              // Median of last MEDIANFILTERSIZE samples (kills spikes)
+#define FILTER_BIQUAD 2              // 2nd order Butterworth low-pass
+#define FILTER_ONEEURO 3             // One-Euro (adaptive low-pass: smooth when still, quick when moving)
+#define MEDIANFILTERSIZE 5           // Samples for median filter
+#define MEDIANNOISEGAIN 0.54f        // Median of 5 lets through this fraction of gaussian noise
+#define BIQUADCUTOFF 30.0f           // Hz for biquad low-pass
+#define ONEEURO_MINCUTOFF 12.0f      // Hz cutoff when stick is still (much lower lags a slow movement by 100 ms)
+#define ONEEURO_BETA 0.003f          // Cutoff increase per ADC count/second of stick speed
+#define ONEEURO_DCUTOFF 1.0f         // Hz cutoff for the derivative
+#define DEFAULTINPUTDEADBAND 4       // ADC counts until calibration measures the real noise
+#define MAXINPUTDEADBAND 24          // ADC counts
+#define NOISEOUTLIER 32              // Bigger sample-to-sample steps than this are movement, not noise
+#define TXFILTERSMARKER 23456        // Starts the input filter settings after the transmitter parameters' checksum
+
 // ********************* Offsets within macros' buffer ***********************
 
 #define MACROTRIGGERCHANNEL 0 // 1 - 16. 0 means dissabled.
@@ -613,6 +747,8 @@ void ZeroDataScreen();
 void RedLedOn();
 int InStrng(char *text1, char *text2);
 void ReadCheckSum32();
+void ReadInputFilterSettings();
+void SaveInputFilterSettings();
 void ResetTransmitterSettings();
 void TryToReconnect();
 void FlushFifos();
@@ -635,6 +771,11 @@ void DoScanInit();
 void DoScanEnd();
 void HopToNextChannel();
 void ScanAllChannels(bool cls);
+void CycleScanMode();
+void RescanWaveband();
+void ClearNextionCommand();
+void BuildNextionCommand(char *cmd);
+uint16_t NextionQueueUsed();
 void SendData();
 void DrawFhssBox();
 void SendText(char *tbox, char *NewWord); // needed a prototype or two here!
@@ -642,12 +783,21 @@ void RestoreBrightness();
 void ButtonWasPressed();
 void CalibrateEdgeSwitches();
 void DisplayCurve();
+uint32_t CurveSettingsKey();
+FASTRUN void MoveCurveCursor(uint16_t NewX);
 void DrawLine(int x1, int y1, int x2, int y2, int c);
 void DrawBox(int x1, int y1, int x2, int y2, int c);
 void FillBox(int x1, int y1, int w, int h, int c);
 void LogConnection();
 void LogDisConnection();
 void CloseLogFile();
+void CloseLogWriter();
+FLASHMEM void StartBlackbox();
+FASTRUN void RecordBlackbox(uint8_t Flags, uint8_t ChannelsSent, uint8_t Retries);
+void ManageBlackbox();
+void StopBlackbox();
+FASTRUN void FlushLogRing(bool All, bool Partial = false);
+FASTRUN void ManageLogRing(uint32_t RightNow);
 void LogLongestGap();
 void Force_ReDisplay();
 FASTRUN void Compress(uint16_t *compressed_buf, uint16_t *uncompressed_buf, uint8_t uncompressed_size);
@@ -677,7 +827,73 @@ void PlayPong();
 void StartPong();
 FASTRUN void ButtonWasPressed();
 bool GetButtonPress();
+FASTRUN void PumpNextionInput();
+bool NextionInputWaiting();
+void StartNextionRenderTiming(const char *Name);
+FLASHMEM void StartNextionLink();
 void EndSend();
+FASTRUN void DrainNextionQueue();
+void FlushNextionQueue();
+void QueueNextionText(const char *text);
+void QueueNextionCommand(char *tbox);
+void ForgetNextionShadows();
+uint32_t FNV1aHashByte(uint32_t Hash, uint8_t b);
+void SubTrimChannelChosen();
+void SubTrimValueEdited();
+void MainSetupChosen();
+void MarkGPSLocation();
+void DataViewEnd();
+void ClearDataView();
+void ZeroAltitude();
+void StartHelpView();
+void DecMinute();
+void IncMinute();
+void DecHour();
+void IncHour();
+void DecYear();
+void IncYear();
+void DecDate();
+void IncDate();
+void DecMonth();
+void IncMonth();
+void ReturnFromHelp();
+void CurveTypeEdited();
+void SendModelPressed();
+void SaveFailSafe();
+void StartFailSafeView();
+void StartOneSwitchView();
+void SwitchesViewEdited();
+void StartInputsView();
+void DeleteModFilePressed();
+void StartSwitchesView();
+void StartCalibrateView();
+void ExportModel();
+void ExportModelFile();
+void ImportModel();
+void ColoursSetupEnd();
+void StartTypeView();
+void RXBatteryTypeChosen();
+void StartTrimView();
+void CentreAllTrims();
+void SetupChannel();
+void FrontViewShown();
+void StartSticksView();
+void StartMixesView();
+void MixesViewEdited();
+void GraphViewShown();
+void StartDataView();
+void SelectBank1();
+void SelectBank2();
+void SelectBank3();
+void SelectBank4();
+void ResetExpo();
+void CurveClickedX();
+void CurveClickedY();
+void CalibrateButtonPressed();
+void CycleLogSort();
+void ShowWorstLinks();
+uint32_t FNV1aHash(const char *text);
+uint32_t Crc32(const uint8_t *Data, uint32_t Length, uint32_t Crc = 0);
 void ReadTheRTC();
 void swap(uint8_t *a, uint8_t *b);
 void SaveOneModel(uint32_t mnum);
@@ -721,12 +937,42 @@ void UpdateButtonLabels();
 void SDUpdate32BITS(int p_address, uint32_t p_value);
 void SDUpdate8BITS(int p_address, uint8_t p_value);
 uint32_t SDRead32BITS(int p_address);
+bool LoadSDBlock(int Start, int Length);
+void LoadModelCatalog();
+void StartModelDirectory();
+void BeginModelSection(uint8_t ID);
+void EndModelSection();
+void WriteModelDirectory();
+void ReadModelDirectory();
+bool SeekModelSection(uint8_t ID);
+uint8_t ModelSectionVersion(uint8_t ID);
+void SaveCatalogEntry(uint32_t Slot);
+bool ModelStoreInUse();
+bool ReadFromModelStore(int Start, uint8_t *Data, int Length);
+bool WriteToModelStore(int Start, const uint8_t *Data, int Length);
+bool WriteToModelsFile(int Start, const uint8_t *Data, int Length);
+void WriteModelsFileDirect(int Start, const uint8_t *Data, int Length);
+void ReplayModelsJournal();
+void MigrateOldModels();
+bool ReadModelCatalog();
+FLASHMEM void LoadModelStore();
+bool FlushModelStore(bool All);
+void ManageModelStore(uint32_t RightNow);
+void RebuildModelCatalog();
+uint32_t ReadModelsGeneration();
+void WriteModelsGeneration(uint32_t Generation);
+void NoteModelInCatalog(uint32_t Slot);
+uint32_t FindModelInCatalog(uint64_t ModelID);
+bool LoadModelByID(uint64_t ModelID);
+void SaveSDBlock();
+void ForgetSDBlock();
 void CheckSavedTrimValues();
 void CheckMacrosBuffer();
 void FixMotorChannel();
 void SendInitialSetupParams();
 void AddParameterstoQueue(uint8_t ID);
 void SetDefaultValues();
+void SetSectionDefaults(uint8_t ID);
 FASTRUN void LogThisRX();
 void CompareVersionNumbers();
 void PopulateFrontView();
@@ -758,6 +1004,7 @@ void LoadModelForRenaming();
 bool GetBackupFilename(char *goback, char *tt1, char *MMname, char *heading, char *pprompt);
 void FixFileName();
 void WriteBackup();
+void WriteModelFile();
 void RestoreCurrentModel();
 void GetYesOrNo();
 uint16_t GetText(char *TextBoxName, char *TheText, uint16_t maxlen);  // ClaudeFix-2-7-2026
@@ -769,6 +1016,25 @@ void EndLogFilesListScreen();
 void LoadNewLogFile();
 void DeleteThisLogFile();
 void SortDirectory();
+void NoteFileAdded(const char *Name);
+void NoteFileRemoved(const char *Name);
+void ForgetDirectories();
+int16_t FindBackup(const char *Name);
+bool BackupStoreInUse();
+bool BackupFileOnCard(const char *Name);
+bool ReadFromBackupStore(int Start, uint8_t *Data, int Length);
+bool WriteToBackupStore(int Start, const uint8_t *Data, int Length);
+bool ReadBackupImage(int16_t Entry, uint8_t *Image);
+bool RemoveBackup(const char *Name);
+void DeleteModelBackup(char *Name);
+void AddBackupsToDirectory(uint8_t Kind);
+uint32_t BackupFileSize(char *Name);
+void ForgetBackupStore();
+void SaveFlightSummary();
+void ForgetFlightSummaries();
+char *AddFlightsToFilename(int ff, char *stats);
+void SortLogFilesByFlights();
+const char *LogSortTitle();
 void ClearFilesList();
 FASTRUN void LogModelMatched();
 FASTRUN void LogModelFound();
@@ -789,6 +1055,12 @@ void RefreshDualRatesNew();
 void CheckDualRatesScreen(uint32_t RightNow);
 int GetIntFromTextIn(uint8_t offset);
 void ShowLogFileNew(uint16_t LinesCounter);
+void ManageLineIndex();
+void FinishLineIndex();
+void FindFinalWindow();
+void ClearWindowCache();
+bool PrefetchWindows();
+void NoteScrollTime(uint32_t Started);
 uint16_t ReadAFewLines();
 void LogVIEWNew();
 File OpenTextFileForReading();
@@ -805,6 +1077,9 @@ void ShowSendingParameters();
 float SDReadFLOAT(int p_address);
 void SDUpdateFLOAT(int p_address, float p_value);
 void GetBank();
+FASTRUN void ScanSwitchesFast();
+FASTRUN void SwitchReachedAir();
+void LogSwitchLatency();
 void LogRPM(uint32_t RPM);
 void SuccessfulPacket();
 void StartGapsView();
@@ -880,6 +1155,20 @@ void EndChooseImage();
 void ImageScrollStop();
 void GetAllInputs();
 void CalculateAllOutputs();
+FASTRUN void CalculateChangedOutputs(uint16_t Dirty);
+void BuildPipelineDependencies();
+FASTRUN uint16_t GetDirtyOutputs();
+void InvalidatePipeline();
+FASTRUN void CheckForBankCrossfade();
+void BuildSlowedChannels();
+FASTRUN void EvaluateCrossfadeBank();
+FASTRUN void BlendBanks();
+void InitInputFilters();
+void DefaultInputFilters();
+FASTRUN void ReadFilteredInputs();
+void StartInputNoiseMeasurement();
+void MeasureInputNoise(uint8_t i, uint16_t RawValue);
+void SetDeadbandsFromNoise();
 void ReduceLimits();
 void CalibrateSticks();
 void ChannelCentres();
@@ -969,7 +1258,9 @@ uint16_t TrimRepeatSpeed = 600;
 char na[] = "";
 
 uint8_t ServoSpeed[BANKS_USED + 1][CHANNELSUSED + 1]; //    Speed of servo movement
-uint16_t CurrentPosition[SENDBUFFERSIZE + 1];         //    Position from which a slow servo started (0 = not started yet)
+uint8_t ServoSpeedDown[BANKS_USED + 1][CHANNELSUSED + 1]; //  Speed when decreasing (0 = same as ServoSpeed)
+uint32_t CurrentPosition[SENDBUFFERSIZE + 1];         //    Slowed servo's position, 16.16 fixed point (0 = not started yet)
+uint16_t SlowedChannels = 0;                          //    BIT mask of channels slowed in the current bank
 uint16_t SendBuffer[SENDBUFFERSIZE + 1];              //    Data to send to rx (16 words)
 uint16_t BuddyBuffer[SENDBUFFERSIZE + 1];             //    Data from wireless buddy (16 words)
 uint16_t ShownBuffer[SENDBUFFERSIZE + 1];             //    Data shown before
@@ -977,6 +1268,15 @@ uint16_t RawDataBuffer[SENDBUFFERSIZE + 1];           //    Data as actually sen
 uint16_t InputsBuffer[CHANNELSUSED + 1];              //    Data from pots
 uint16_t LastBuffer[CHANNELSUSED + 1];                //    Used to spot any change
 uint16_t PreMixBuffer[CHANNELSUSED + 1];              //    Data collected from sticks
+uint16_t CurveCache[CHANNELSUSED + 1];                //    Each channel's curve output from last time it was calculated
+uint16_t LastRawInputs[CHANNELSUSED + 1];             //    Pre-mix inputs used last time (to spot changes)
+uint16_t CurveDeps[CHANNELSUSED];                     //    BIT mask of channels each curve depends on (via input mixes)
+bool PipelineNeedsFullRefresh = true;                 //    Force every channel to be recalculated next time
+uint16_t CrossfadeBuffer[CHANNELSUSED + 1];           //    Outputs from the OLD bank during a bank crossfade
+uint8_t BankCrossfadeTime = 0;                        //    Per model. Tenths of a second. 0 = switch banks instantly
+uint8_t CrossfadeFromBank = 0;                        //    Bank being faded out
+uint32_t CrossfadeStartTime = 0;                      //    millis() when crossfade began
+bool BankCrossfading = false;                         //    Crossfade in progress
 uint8_t MaxDegrees[5][CHANNELSUSED + 1];              //    Max degrees (180)
 uint8_t MidHiDegrees[5][CHANNELSUSED + 1];            //    MidHi degrees (135)
 uint8_t CentreDegrees[5][CHANNELSUSED + 1];           //    Middle degrees (90)
@@ -1066,10 +1366,25 @@ uint16_t ChannelMidHi[CHANNELSUSED + 1];     //    output of pots at MidHi
 uint16_t ChannelCentre[CHANNELSUSED + 1];    //    output of pots at Centre
 uint16_t ChannelMidLow[CHANNELSUSED + 1];    //    output of pots at MidLow
 uint16_t ChannelMin[CHANNELSUSED + 1];       //    output of pots at min
+uint8_t InputFilterType[PROPOCHANNELS] = {FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN, FILTER_MEDIAN}; // per input
+uint8_t InputDeadband[PROPOCHANNELS] = {DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND,
+                                        DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND, DEFAULTINPUTDEADBAND}; // ADC counts, measured at calibration
 uint16_t ChanneltoSet = 0;
 bool Connected = false;
 File LogFileNumber;
 bool LogFileOpen = false;
+char LogRing[LOGRINGSIZE];     // Log text waiting to be written
+uint32_t LogRingHead = 0;      // Bytes ever added to LogRing (free running)
+uint32_t LogRingTail = 0;      // Bytes ever written from LogRing to SD
+uint32_t LogRingOldest = 0;    // millis() when the oldest line still in LogRing was added
+uint32_t LogMarkAt[LOGMARKS];  // Where in LogRing (as LogRingHead was) ...
+uint32_t LogMarkTime[LOGMARKS]; // ... lines started arriving at this millis()
+uint8_t LogMarkFirst = 0;      //
+uint8_t LogMarkCount = 0;      //
+File LogWriteFile;             // Today's log, kept open while lines are logged
+bool LogWriteFileOpen = false; //
+char LogWriteFileName[40];     // The log file LogWriteFile has open
+uint32_t LogWriteOffset = 0;   // Where the next write to LogWriteFile lands
 uint16_t BuddyControlled = 0; // Flags
 bool BuddyHasAllSwitches = true;
 double PointsCount = 5; // This for displaying curves only
@@ -1157,6 +1472,20 @@ bool TrimSwitch[8];
 uint8_t BankSwitch = BANKSWITCH;
 uint8_t Autoswitch = Autoswitch;
 uint8_t SafetySwitch = 0;
+volatile uint32_t *SwitchPortReg[8];  // GPIO input registers used by the switches (usually fewer than 8)
+uint8_t SwitchPortsUsed = 0;          // How many of these
+uint8_t SwitchPortOf[8];              // Which port each switch uses
+uint32_t SwitchPinMask[8];            // Which BIT in that port
+uint8_t ScannedSwitchPins[8] = {0};   // Copy of SwitchNumber[] the port table was built from
+uint8_t SwitchBounceCount[8];         // Debounce counters
+uint32_t SwitchEdgeTime[8];           // micros() when each switch first showed a new position
+uint32_t LastFastSwitchScan = 0;      // millis() of last fast scan
+bool SwitchLatencyPending = false;    // A switch change has not yet been acknowledged by the RX
+uint32_t SwitchLatencyStart = 0;      // micros()
+uint32_t SwitchLatencyLast = 0;       // us
+uint32_t SwitchLatencyMax = 0;        // us
+uint32_t SwitchLatencySum = 0;        // us
+uint32_t SwitchLatencyCount = 0;      //
 uint8_t BuddySwitch = 0;
 uint8_t DualRatesSwitch = 0;
 
@@ -1187,7 +1516,21 @@ uint8_t InPutStick[17] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
 uint8_t ChannelOutPut[17] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}; // User defined channel outputs
 uint8_t InputTrim[4] = {0, 1, 2, 3};                                                // User defined trim inputs
 uint8_t ExportedFileCounter = 0;
-char TheFilesList[150][24];
+char TheFilesList[FILESLISTSIZE][24];
+uint32_t TheFilesSizes[FILESLISTSIZE]; // Size of each file in TheFilesList
+struct DirectoryEntry
+{
+    char Name[13];  // As listed
+    int32_t Date;   // Sort key for log files
+    uint32_t Size;  // Bytes
+};
+struct DirectoryCacheData
+{
+    bool Loaded;    // Directory has been read
+    uint16_t Count; //
+    DirectoryEntry Entries[MAXDIRENTRIES]; // Kept sorted
+};
+DirectoryCacheData DirectoryCache[DIRECTORYKINDS];
 uint16_t FileNumberInView = 0;
 bool FileError = false;
 uint32_t RangeTestStart = 0;
@@ -1303,6 +1646,23 @@ bool AnnounceConnected = true;
 bool CopyTrimsToAll = true;
 uint16_t ReversedChannelBITS = 0; // 16 BIT for 16 Channels
 uint16_t SavedLineX = 12345;
+uint16_t CurveCursorX = 0;    // Where the stick position line is on the graph (0 = not drawn)
+uint32_t ShownCurveKey = 0;   // CurveSettingsKey() of the curve on the graph
+uint8_t ShownCurvePoint = 0;  // Point that was selected when it was drawn
+
+struct CurveSegment
+{
+    int16_t x1, y1, x2, y2;
+};
+
+struct CachedCurve
+{
+    uint32_t Key; // CurveSettingsKey() of the curve these segments draw
+    bool Valid;   //
+    uint8_t Count;
+    CurveSegment Segment[MAXCURVESEGMENTS];
+};
+CachedCurve GraphCurveCache[GRAPHCURVECACHESIZE]; // Segments of curves drawn on the graph screen
 uint8_t ReConnectChannel = 0;
 
 bool ShowVPC = false;
@@ -1334,6 +1694,49 @@ union uMacStored
     uint32_t Val32[2];
     uint8_t Val8[8]; // Model's Mac address that had been saved on disk
 } ModelsMacUnionSaved;
+
+struct ModelCatalogEntry
+{
+    bool Defined;      // Slot holds a model
+    char Name[31];     // Model's name
+    uint64_t ID;       // Model's saved ID (ModelsMacUnionSaved)
+    uint32_t Modified; // RTC time of its last save (0 = not known)
+};
+struct
+{
+    uint32_t Magic;      // MODELCATALOGMAGIC
+    uint32_t Slots;      // MAXMODELNUMBER when written
+    uint32_t ModelsSize;       // Size of models.dat when written
+    uint32_t ModelsGeneration; // models.dat's write count when written
+} ModelCatalogHeader;
+ModelCatalogEntry ModelCatalog[MAXMODELNUMBER]; // [0] is unused, there is no model zero
+bool ModelCatalogLoaded = false;                // LoadModelCatalog() has run
+
+struct ModelSectionKind
+{
+    uint8_t ID;      // MSEC_...
+    uint8_t Version; // Current version of its content
+};
+struct ModelSectionEntry // 12 bytes each in the file
+{
+    uint8_t ID;
+    uint8_t Version;
+    uint16_t Offset; // From the start of the model's slot
+    uint16_t Length;
+    uint16_t Spare;
+    uint32_t Crc; // CRC32 of the section
+};
+struct
+{
+    uint32_t Magic;  // MODELDIRECTORYMAGIC
+    uint8_t Format;  // MODELFORMATVERSION
+    uint8_t Count;   // Sections that follow (then a CRC32 of the directory itself)
+    uint16_t Spare;
+} ModelDirectory;
+ModelSectionEntry ModelSections[MAXMODELSECTIONS];
+bool ModelDirectoryFound = false; // The model just read had a good section directory
+bool ModelNeedsMigrating = false; // The model just read is good but has no (good) section directory
+int8_t OpenModelSection = -1;     // Section SaveOneModel() is writing
 bool MotorEnabled = false;
 bool SendNoData = false;
 bool MotorWasEnabled = false;
@@ -1349,6 +1752,46 @@ uint16_t SFV = 0; // =StopFlyingVoltsPerCell * 100
 bool NewCompressNeeded = true;
 uint32_t FileCheckSum = 0;
 bool DoingCheckSm = false;
+uint8_t SDBlock[SDBLOCKSIZE];   // One model (or the TX params) as it is laid out in models.dat
+int SDBlockStart = -1;          // File address of SDBlock[0], -1 when no block is loaded
+int SDBlockLength = 0;          // Bytes of the file held in SDBlock
+uint8_t SDJournalCheck[SDBLOCKSIZE]; // Journal data read back for checking
+struct ModelsJournalHeader            // Follows the data in models.jnl
+{
+    uint32_t Magic;     // MODELSJOURNALMAGIC
+    uint32_t Start;     // Where in models.dat the data goes
+    uint32_t Length;    // How many bytes
+    uint32_t DataCrc;   // CRC32 of the data
+    uint32_t HeaderCrc; // CRC32 of the four fields above
+};
+EXTMEM uint8_t ModelStore[MODELSTORESIZE]; // models.dat in PSRAM
+bool ModelStoreLoaded = false;              // ModelStore holds models.dat
+bool ModelStoreDirty[MAXMODELNUMBER];       // Parts changed since they were written to SD ([0] = TX params)
+uint8_t ModelStoreDirtyCount = 0;           // How many parts are dirty
+uint32_t ModelStoreChangeTime = 0;          // millis() of the latest change
+struct BackupRecord // One per backup in backups.idx
+{
+    char Name[13];       // As listed, e.g. "SPITFIRE.MOD"
+    uint8_t Kind;        // BACKUP_BASE or BACKUP_DELTA
+    uint8_t Deleted;     // Deleted, or replaced by a newer backup of the same name
+    uint8_t Spare;       //
+    uint16_t Length;     // Bytes in the model image
+    uint16_t DataLength; // Bytes at DataAt
+    uint32_t ImageCrc;   // CRC32 of the whole image (so identical backups are spotted)
+    uint32_t ModelKey;   // CRC32 of the model's name (which base images a delta may use)
+    uint32_t BaseAt;     // Base image in backups.dat (same as DataAt for a base)
+    uint32_t DataAt;     // Base image or delta in backups.dat
+    uint32_t Time;       // RTC when saved
+    uint32_t Magic;      // BACKUPRECORDMAGIC
+    uint32_t RecordCrc;  // CRC32 of everything above
+};
+BackupRecord BackupIndex[MAXBACKUPENTRIES]; // All of backups.idx
+uint16_t BackupCount = 0;                   // Records in BackupIndex
+bool BackupIndexLoaded = false;             //
+bool BackupStoreSaving = false;             // WriteBackup() is saving: single model writes go to the store
+uint8_t BackupBase[SDBLOCKSIZE];            // Base image being compared or restored
+uint8_t BackupImage[SDBLOCKSIZE];           // A whole model image, rebuilt from the store
+uint8_t BackupDelta[SDBLOCKSIZE];           // A delta being made or applied
 bool RecursedAlready = false;
 bool TXLiPo = false;
 uint8_t CurrentPoint = 1;
@@ -1374,6 +1817,13 @@ uint32_t MacroStopTime[MAXMACROS];
 uint8_t PreviousMacroNumber = 1;
 bool UseMacros = false;
 uint8_t ScanSensitivity = 42;
+uint8_t ScanMode = SCANBARS;
+uint8_t AllChannels[SCANCHANNELS]; // scanner's rendered bar heights (pixels)
+uint8_t PeakHeight[SCANCHANNELS];  // scanner's tallest bars (peak hold)
+uint8_t NoCarrier[SCANCHANNELS];   // sweeps a scanner bar has been too tall
+uint32_t TotalHits[SCANCHANNELS];  // scanner samples with carrier since the scan began
+uint8_t WaterfallRow = 0;          // next row of the scanner's waterfall
+uint32_t ScanSavedTxDelay = 0;     // Radio1.txDelay before scanning
 uint8_t CurrentChannel = 0;
 uint8_t PupilIsAlive = 0;
 uint8_t MasterIsAlive = 0;
@@ -1577,6 +2027,91 @@ struct Payload
     uint8_t Ack_Payload_byte[PAYLOADSIZE];
 };
 Payload AckPayload;
+struct BlackboxFileHeader // Sector 0 of blackbox.bbx
+{
+    uint32_t Magic;      // BLACKBOXMAGIC
+    uint16_t Version;    // BLACKBOXVERSION
+    uint16_t RecordSize; // sizeof(BlackboxRecord)
+    uint32_t Session;    // Records with this Session belong to the latest power-on that recorded anything
+    uint32_t StartTime;  // RTC time of that power-on
+    uint32_t FileSize;   // Where the records wrap around
+    char ModelName[32];  // Model in use then
+    uint32_t WriteAt;    // Where that session's records had reached (the next session carries on after them)
+};
+struct BlackboxRecord // One per packet sent. 64 bytes, no padding. (Blackbox converter/BlackboxToCsv.cpp has a copy)
+{
+    uint32_t Session;                    // BlackboxFileHeader.Session
+    uint32_t Sequence;                   // Counts packets - a jump means records were dropped
+    uint32_t Time;                       // millis() when the packet was sent
+    uint16_t Channels[16];               // SendBuffer: the channel outputs
+    uint16_t Gap;                        // ms since the last ack, or the gap just ended
+    uint16_t Switches;                   // Switch[0..7] in the low byte, TrimSwitch[0..7] in the high byte
+    uint8_t Ack[PAYLOADSIZE];            // The ack payload (telemetry item and data, next hop)
+    uint8_t HopChannel;                  // CurrentChannel
+    uint8_t Retries;                     // Auto retransmits used by this packet
+    uint8_t Flags;                       // BLACKBOX_ACKED etc
+    uint8_t Bank;                        //
+    uint8_t ChannelsSent;                // Channels (or parameters) in this packet
+    uint8_t Spare[5];                    // Up to 64 bytes
+};
+#define BLACKBOX_ACKED 1        // Flags
+#define BLACKBOX_CHANNELS 2     //
+#define BLACKBOX_PARAMETERS 4   //
+#define BLACKBOX_MODELMATCHED 8 //
+BlackboxRecord BlackboxBuffer[2][BLACKBOXRECORDS]; // Double buffer: one fills while the other waits for the SD card
+uint8_t BlackboxFilling = 0;                       // Half being filled
+uint16_t BlackboxCount = 0;                        // Records in it so far
+int8_t BlackboxFull = -1;                          // Half waiting to be written, or -1
+uint32_t BlackboxSession = 0;                      //
+uint32_t BlackboxSequence = 0;                     //
+uint32_t BlackboxDropped = 0;                      // Records lost because the SD card fell behind
+uint32_t BlackboxWriteAt = BLACKBOXHEADERSIZE;     // File position for the next buffer
+uint8_t BlackboxUnsynced = 0;                      // Buffers written since the last sync()
+bool BlackboxOpen = false;                         //
+bool BlackboxSessionStarted = false;               // A record has been made since StartBlackbox()
+bool BlackboxHeaderDue = false;                    // The header must be written with the next buffer
+uint32_t BlackboxStartTime = 0;                    // RTC time of this power-on
+FsFile BlackboxFile;                               // SdFat file, for preAllocate()
+struct FlightSummary // One per flight (connection) in flights.dat. 128 bytes, no padding.
+{
+    uint32_t Magic;          // FLIGHTMAGIC
+    uint32_t EndTime;        // RTC time of the disconnection
+    uint32_t Duration;       // Seconds connected
+    uint32_t MotorOnSeconds; //
+    uint64_t ModelID;        // ModelsMacUnionSaved
+    char ModelName[32];      //
+    char LogFile[13];        // The day's log file, e.g. "23-08-24.LOG"
+    uint8_t RxType;          // Receiver_type
+    uint16_t RXSwaps;        // RadioSwaps
+    uint32_t MaxRPM;         // Max_RotorRPM
+    float MaxAmps;           // Max_Battery_Amps
+    float MaxESCTemp;        // Max_ESC_Temp
+    float mAh;               // Battery_mAh
+    float BaroAltitude;      // RXMAXModelAltitude
+    float GPSAltitude;       // GPS_RX_Maxaltitude
+    float GPSDistance;       // GPS_RX_MaxDistance
+    float GPSSpeed;          // GPS_RX_MaxSpeed
+    uint16_t SuccessRate;    // Packet success rate in hundredths of a percent (9950 = 99.50%)
+    uint16_t LongestGap;     // ms
+    uint16_t AverageGap;     // ms
+    uint16_t Spare1;         //
+    uint32_t LostPackets;    // TotalLostPackets
+    uint32_t PacketsSent;    // TotalPacketsAttempted
+    uint8_t Spare[4];        // Up to 128 bytes
+    uint32_t RecordCrc;      // CRC32 of everything above
+};
+struct FlightDay // The flights in one log file, for the log files list
+{
+    char LogFile[13];     //
+    uint16_t Flights;     //
+    uint32_t Seconds;     // Total time connected
+    uint16_t WorstRate;   // Lowest SuccessRate
+    uint16_t LongestGap;  // ms
+};
+FlightDay FlightDays[MAXDIRENTRIES]; // Built from flights.dat the first time log files are listed
+uint16_t FlightDayCount = 0;         //
+bool FlightDaysLoaded = false;       //
+uint8_t LogSortOrder = LOGSORT_DATE; // How the log files list is sorted (LogSort cycles it)
 
 struct spd // Special Packet Data for Wireless Buddy functions
 {
@@ -0,0 +1,472 @@
+// *************************************** BackupStore.h *****************************************
+
+// Every backup made by WriteBackup() is kept here, and nowhere else, in two files shared by all of them:
+// backups.dat holds model images and deltas, and backups.idx holds one small record per backup.
+// The first backup of a model stores its whole image (a base). Later backups of the same model store only the byte
+// ranges that differ from that base. A backup identical to one already stored (same CRC32, checked byte for byte)
+// stores nothing new. Each backup is read back and checked before its record is written.
+// Nothing in backups.dat is ever overwritten: deleting a backup only marks its record.
+// While SingleModelFlag is set, LoadSDBlock() and SaveSDBlock() come here for any backup in the store (and for every save
+// by WriteBackup()). Ordinary .MOD files are written only by WriteModelFile() (to take to a PC) and by receiving a model,
+// and either one removes any backup of the same name, just as WriteBackup() removes any file. So a name is never in both.
+// The backups list shows both kinds, and the store's backups are listed without opening any files.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef BACKUP_STORE_H
+#define BACKUP_STORE_H
+
+/*********************************************************************************************************************************/
+
+uint32_t BackupRecordCrc(const BackupRecord *Record)
+{
+    return Crc32((const uint8_t *)Record, sizeof(BackupRecord) - 4);
+}
+
+/*********************************************************************************************************************************/
+// Reads backups.idx into BackupIndex[]. A record with a bad CRC (a write cut short) ends it.
+
+void LoadBackupIndex()
+{
+    BackupCount = 0;
+    BackupIndexLoaded = true;
+    if (!TINYCARD.exists(BACKUPINDEXFILE) && TINYCARD.exists(BACKUPINDEXTEMP))
+        TINYCARD.rename(BACKUPINDEXTEMP, BACKUPINDEXFILE); // Power was cut while it was being tidied
+    File IndexFile = TINYCARD.open(BACKUPINDEXFILE, FILE_READ);
+    if (!IndexFile)
+        return;
+    while ((BackupCount < MAXBACKUPENTRIES) && (IndexFile.read(&BackupIndex[BackupCount], sizeof(BackupRecord)) == sizeof(BackupRecord)))
+    {
+        BackupRecord *Record = &BackupIndex[BackupCount];
+        if ((Record->Magic != BACKUPRECORDMAGIC) || (Record->RecordCrc != BackupRecordCrc(Record)))
+            break;
+        ++BackupCount;
+    }
+    IndexFile.close();
+#ifdef DB_SD
+    Serial.print(BackupCount);
+    Serial.println(" backup records loaded.");
+#endif
+}
+
+/*********************************************************************************************************************************/
+
+void EnsureBackupIndex()
+{
+    if (!BackupIndexLoaded)
+        LoadBackupIndex();
+}
+
+/*********************************************************************************************************************************/
+// After the card is (re)started.
+
+void ForgetBackupStore()
+{
+    BackupIndexLoaded = false;
+    BackupCount = 0;
+}
+
+/*********************************************************************************************************************************/
+// The newest backup of that name that hasn't been deleted, or -1.
+
+int16_t FindBackup(const char *Name)
+{
+    char EntryName[13];
+    EnsureBackupIndex();
+    MakeEntryName(EntryName, Name);
+    for (int16_t i = BackupCount - 1; i >= 0; --i)
+    {
+        if (!BackupIndex[i].Deleted && (strcasecmp(BackupIndex[i].Name, EntryName) == 0))
+            return i;
+    }
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+
+bool BackupFileOnCard(const char *Name)
+{
+    char Path[24];
+    snprintf(Path, sizeof(Path), "/mod/%s", Name);
+    return TINYCARD.exists(Path);
+}
+
+/*********************************************************************************************************************************/
+// True when the single model file being read or written is (or is about to be) in the store.
+
+bool BackupStoreInUse()
+{
+    if (!SingleModelFlag)
+        return false;
+    if (BackupStoreSaving)
+        return true;
+    return FindBackup(SingleModelFile) >= 0;
+}
+
+/*********************************************************************************************************************************/
+// A delta is a list of runs: offset (2 bytes), length (2 bytes), then that many new bytes.
+
+bool ApplyBackupDelta(uint8_t *Image, const uint8_t *Delta, uint16_t DeltaLength, uint16_t Length)
+{
+    uint16_t i = 0;
+    while (i + 4 <= DeltaLength)
+    {
+        uint16_t Offset = Delta[i] | (Delta[i + 1] << 8);
+        uint16_t Count = Delta[i + 2] | (Delta[i + 3] << 8);
+        i += 4;
+        if ((Offset + Count > Length) || (i + Count > DeltaLength))
+            return false;
+        memcpy(Image + Offset, Delta + i, Count);
+        i += Count;
+    }
+    return i == DeltaLength;
+}
+
+/*********************************************************************************************************************************/
+// Returns the length of the delta from Base to Image (made in BackupDelta[]), or -1 if it would be longer than BACKUPDELTAMAX.
+// Differences separated by fewer than BACKUPDELTAGAP unchanged bytes go in the same run.
+
+int32_t MakeBackupDelta(const uint8_t *Base, const uint8_t *Image, uint16_t Length)
+{
+    uint16_t DeltaLength = 0;
+    uint16_t i = 0;
+    while (i < Length)
+    {
+        if (Base[i] == Image[i])
+        {
+            ++i;
+            continue;
+        }
+        uint16_t Start = i;
+        uint16_t End = i + 1;
+        for (uint16_t j = End; (j < Length) && (j - End < BACKUPDELTAGAP); ++j)
+        {
+            if (Base[j] != Image[j])
+                End = j + 1;
+        }
+        uint16_t Count = End - Start;
+        if (DeltaLength + 4 + Count > BACKUPDELTAMAX)
+            return -1;
+        BackupDelta[DeltaLength++] = Start & 0xFF;
+        BackupDelta[DeltaLength++] = Start >> 8;
+        BackupDelta[DeltaLength++] = Count & 0xFF;
+        BackupDelta[DeltaLength++] = Count >> 8;
+        memcpy(BackupDelta + DeltaLength, Image + Start, Count);
+        DeltaLength += Count;
+        i = End;
+    }
+    return DeltaLength;
+}
+
+/*********************************************************************************************************************************/
+// Rebuilds a backup's whole image: its base, then its delta (if any). False unless the result matches its CRC32.
+
+bool ReadBackupImage(int16_t Entry, uint8_t *Image)
+{
+    if ((Entry < 0) || (Entry >= BackupCount))
+        return false;
+    BackupRecord *Record = &BackupIndex[Entry];
+    if ((Record->Length > SDBLOCKSIZE) || (Record->DataLength > SDBLOCKSIZE))
+        return false;
+    File DataFile = TINYCARD.open(BACKUPDATAFILE, FILE_READ);
+    if (!DataFile)
+        return false;
+    bool Good = DataFile.seek(Record->BaseAt) && (DataFile.read(Image, Record->Length) == Record->Length);
+    if (Good && (Record->Kind == BACKUP_DELTA))
+    {
+        Good = DataFile.seek(Record->DataAt) && (DataFile.read(BackupDelta, Record->DataLength) == Record->DataLength) &&
+               ApplyBackupDelta(Image, BackupDelta, Record->DataLength, Record->Length);
+    }
+    DataFile.close();
+    return Good && (Crc32(Image, Record->Length) == Record->ImageCrc);
+}
+
+/*********************************************************************************************************************************/
+// Adds Data to the end of backups.dat, and says where.
+
+bool AppendBackupData(const uint8_t *Data, uint16_t Length, uint32_t *At)
+{
+    File DataFile = TINYCARD.open(BACKUPDATAFILE, FILE_WRITE);
+    if (!DataFile)
+        return false;
+    *At = DataFile.size();
+    DataFile.seek(*At);
+    bool Good = (DataFile.write(Data, Length) == Length);
+    DataFile.flush();
+    DataFile.close();
+    return Good;
+}
+
+/*********************************************************************************************************************************/
+
+bool WriteBackupRecord(uint16_t Entry)
+{
+    BackupRecord *Record = &BackupIndex[Entry];
+    Record->Magic = BACKUPRECORDMAGIC;
+    Record->RecordCrc = BackupRecordCrc(Record);
+    File IndexFile = TINYCARD.open(BACKUPINDEXFILE, FILE_WRITE);
+    if (!IndexFile)
+        return false;
+    IndexFile.seek(Entry * sizeof(BackupRecord));
+    bool Good = (IndexFile.write((uint8_t *)Record, sizeof(BackupRecord)) == sizeof(BackupRecord));
+    IndexFile.flush();
+    IndexFile.close();
+    return Good;
+}
+
+/*********************************************************************************************************************************/
+// When backups.idx is full, the records of deleted backups are dropped. The new index is written to a temporary file
+// first, so a power cut leaves one good copy or the other. (Their data stays in backups.dat, where it can still be a base.)
+
+void TidyBackupIndex()
+{
+    uint16_t Kept = 0;
+    for (uint16_t i = 0; i < BackupCount; ++i)
+    {
+        if (!BackupIndex[i].Deleted)
+            BackupIndex[Kept++] = BackupIndex[i];
+    }
+    File IndexFile = TINYCARD.open(BACKUPINDEXTEMP, FILE_WRITE);
+    if (!IndexFile)
+        return;
+    IndexFile.truncate(0);
+    IndexFile.write((uint8_t *)BackupIndex, Kept * sizeof(BackupRecord));
+    IndexFile.flush();
+    IndexFile.close();
+    TINYCARD.remove(BACKUPINDEXFILE);
+    TINYCARD.rename(BACKUPINDEXTEMP, BACKUPINDEXFILE);
+#ifdef DB_SD
+    Serial.print("Backup index tidied: ");
+    Serial.print(BackupCount - Kept);
+    Serial.println(" deleted records dropped.");
+#endif
+    BackupCount = Kept;
+}
+
+/*********************************************************************************************************************************/
+// Returns its entry, or -1 if there's no room.
+
+int16_t AddBackupRecord(const BackupRecord *Record)
+{
+    if (BackupCount >= MAXBACKUPENTRIES)
+        TidyBackupIndex();
+    if (BackupCount >= MAXBACKUPENTRIES)
+        return -1;
+    BackupIndex[BackupCount] = *Record;
+    if (!WriteBackupRecord(BackupCount))
+        return -1;
+    return BackupCount++;
+}
+
+/*********************************************************************************************************************************/
+// An earlier backup with exactly this image, or -1.
+
+int16_t FindSameBackupImage(const uint8_t *Image, uint16_t Length, uint32_t ImageCrc)
+{
+    for (int16_t i = BackupCount - 1; i >= 0; --i)
+    {
+        if ((BackupIndex[i].ImageCrc == ImageCrc) && (BackupIndex[i].Length == Length) && ReadBackupImage(i, BackupBase) &&
+            (memcmp(BackupBase, Image, Length) == 0))
+            return i;
+    }
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+// The newest base image of this model, or -1. (Deleted backups' bases are still there to be used.)
+
+int16_t FindBackupBase(uint32_t ModelKey, uint16_t Length)
+{
+    for (int16_t i = BackupCount - 1; i >= 0; --i)
+    {
+        if ((BackupIndex[i].Kind == BACKUP_BASE) && (BackupIndex[i].ModelKey == ModelKey) && (BackupIndex[i].Length == Length))
+            return i;
+    }
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+// Marks every other backup of that name deleted. True if there were any.
+
+bool RemoveOtherBackups(const char *Name, int16_t Keep)
+{
+    bool Found = false;
+    for (int16_t i = 0; i < BackupCount; ++i)
+    {
+        if ((i != Keep) && !BackupIndex[i].Deleted && (strcasecmp(BackupIndex[i].Name, Name) == 0))
+        {
+            BackupIndex[i].Deleted = 1;
+            WriteBackupRecord(i);
+            Found = true;
+        }
+    }
+    return Found;
+}
+
+/*********************************************************************************************************************************/
+
+bool RemoveBackup(const char *Name)
+{
+    char EntryName[13];
+    EnsureBackupIndex();
+    MakeEntryName(EntryName, Name);
+    return RemoveOtherBackups(EntryName, -1);
+}
+
+/*********************************************************************************************************************************/
+// Called by LoadSDBlock(). Single model files start at address 0. Returns false (with Data all 255) if there's no such
+// backup yet, or if it can't be rebuilt.
+
+bool ReadFromBackupStore(int Start, uint8_t *Data, int Length)
+{
+    memset(Data, 0xFF, Length);
+    int16_t Entry = FindBackup(SingleModelFile);
+    if ((Entry < 0) || (Start < 0))
+        return false;
+    if (!ReadBackupImage(Entry, BackupImage))
+    {
+        FileError = true;
+        return false;
+    }
+    if (Start < BackupIndex[Entry].Length)
+        memcpy(Data, BackupImage + Start, min(Length, BackupIndex[Entry].Length - Start));
+    return true;
+}
+
+/*********************************************************************************************************************************/
+// Called by SaveSDBlock(). Stores the image as nothing (if it's unchanged), as a reference to identical data, as a delta
+// from this model's base image, or as a new base image - whichever is smallest.
+
+bool WriteToBackupStore(int Start, const uint8_t *Data, int Length)
+{
+    BackupRecord Record;
+    if ((Start != 0) || (Length > SDBLOCKSIZE))
+    {
+        FileError = true;
+        return false;
+    }
+#ifdef DB_SD
+    uint32_t StartTime = micros();
+#endif
+    memset(&Record, 0, sizeof(Record));
+    MakeEntryName(Record.Name, SingleModelFile);
+    Record.Length = Length;
+    Record.ImageCrc = Crc32(Data, Length);
+    Record.ModelKey = Crc32((uint8_t *)ModelName, strlen(ModelName));
+    Record.Time = RTC.get();
+
+    int16_t Previous = FindBackup(Record.Name);
+    if ((Previous >= 0) && (BackupIndex[Previous].ImageCrc == Record.ImageCrc) && ReadBackupImage(Previous, BackupImage) &&
+        (memcmp(BackupImage, Data, Length) == 0))
+        return true; // Saved already
+
+    int16_t Same = FindSameBackupImage(Data, Length, Record.ImageCrc);
+    if (Same >= 0)
+    {
+        Record.Kind = BackupIndex[Same].Kind;
+        Record.BaseAt = BackupIndex[Same].BaseAt;
+        Record.DataAt = BackupIndex[Same].DataAt;
+        Record.DataLength = BackupIndex[Same].DataLength;
+    }
+    else
+    {
+        int16_t Base = FindBackupBase(Record.ModelKey, Length);
+        int32_t DeltaLength = -1;
+        if ((Base >= 0) && ReadBackupImage(Base, BackupBase))
+            DeltaLength = MakeBackupDelta(BackupBase, Data, Length);
+        bool Good;
+        if (DeltaLength >= 0)
+        {
+            Record.Kind = BACKUP_DELTA;
+            Record.BaseAt = BackupIndex[Base].DataAt;
+            Record.DataLength = DeltaLength;
+            Good = AppendBackupData(BackupDelta, DeltaLength, &Record.DataAt);
+        }
+        else
+        {
+            Record.Kind = BACKUP_BASE;
+            Record.DataLength = Length;
+            Good = AppendBackupData(Data, Length, &Record.DataAt);
+            Record.BaseAt = Record.DataAt;
+        }
+        if (!Good)
+        {
+            FileError = true;
+            return false;
+        }
+    }
+
+    int16_t Entry = AddBackupRecord(&Record);
+    if ((Entry < 0) || !ReadBackupImage(Entry, BackupImage) || (memcmp(BackupImage, Data, Length) != 0))
+    {
+        if (Entry >= 0)
+        {
+            BackupIndex[Entry].Deleted = 1;
+            WriteBackupRecord(Entry);
+        }
+        FileError = true;
+        return false;
+    }
+    RemoveOtherBackups(Record.Name, Entry);
+#ifdef DB_SD
+    Serial.print("Backup ");
+    Serial.print(Record.Name);
+    Serial.print((Same >= 0) ? " is a copy" : (Record.Kind == BACKUP_DELTA) ? " is a delta" : " is a base");
+    Serial.print(" of ");
+    Serial.print(Record.DataLength);
+    Serial.print(" bytes, saved in ");
+    Serial.print(micros() - StartTime);
+    Serial.println(" us.");
+#endif
+    return true;
+}
+
+/*********************************************************************************************************************************/
+// Deletes a backup, from the store or the card.
+
+void DeleteModelBackup(char *Name)
+{
+    RemoveBackup(Name);
+    AddPath(Name);
+    if (TINYCARD.exists(SearchFile))
+        TINYCARD.remove(SearchFile);
+    NoteFileRemoved(Name);
+}
+
+/*********************************************************************************************************************************/
+// Called by ScanDirectory() for /mod/.
+
+void AddBackupsToDirectory(uint8_t Kind)
+{
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    EnsureBackupIndex();
+    for (uint16_t i = 0; (i < BackupCount) && (Cache->Count < MAXDIRENTRIES); ++i)
+    {
+        if (BackupIndex[i].Deleted)
+            continue;
+        int16_t Found = FindDirectoryEntry(Kind, BackupIndex[i].Name);
+        if (Found >= 0)
+        {
+            Cache->Entries[Found].Size = BackupIndex[i].Length; // An older file of that name: the backup is the one used
+            continue;
+        }
+        DirectoryEntry *Entry = &Cache->Entries[Cache->Count];
+        strcpy(Entry->Name, BackupIndex[i].Name);
+        Entry->Date = FileDateKey(Entry->Name);
+        Entry->Size = BackupIndex[i].Length;
+        ++Cache->Count;
+    }
+}
+
+/*********************************************************************************************************************************/
+
+uint32_t BackupFileSize(char *Name)
+{
+    int16_t Entry = FindBackup(Name);
+    if (Entry >= 0)
+        return BackupIndex[Entry].Length;
+    return GetFileSize(Name);
+}
+
+#endif
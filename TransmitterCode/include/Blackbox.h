@@ -0,0 +1,209 @@
+// *************************************** Blackbox.h *****************************************
+
+// A binary record of every packet sent: channel outputs, the ack payload, gaps, hop channel, retries, bank and switches.
+// Records are 64 bytes. SendData() adds one to half of a double buffer; when that half is full ManageBlackbox() writes
+// it (4K, eight whole sectors) to blackbox.bbx while the other half fills.
+// blackbox.bbx is allocated in one contiguous piece the first time logging (UseLog) is on, and after that it's reused as a
+// ring: the header keeps where the last session stopped, and the next one carries on from there (plus the most that might
+// not have been noted before a power cut) and wraps around at BLACKBOXFILESIZE. So the last flight is only overwritten
+// once the ring comes round to it. A session starts with its first record, so a power-on that never sent a packet
+// doesn't become the "latest session".
+// "Blackbox converter/BlackboxToCsv.cpp" turns the file into CSV and a summary on a PC.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+/*********************************************************************************************************************************/
+// Called once at boot, after the SD card is checked, and again if logging is turned on.
+
+FLASHMEM void StartBlackbox()
+{
+    BlackboxFileHeader Header;
+    if (BlackboxOpen || !UseLog)
+        return;
+    BlackboxFile = TINYCARD.sdfs.open(BLACKBOXFILE, O_RDWR | O_CREAT);
+    if (!BlackboxFile)
+        return;
+    BlackboxWriteAt = BLACKBOXHEADERSIZE;
+    if (BlackboxFile.fileSize() == 0)
+    {
+        if (!BlackboxFile.preAllocate(BLACKBOXFILESIZE)) // So that writes never have to look for free clusters
+        {
+#ifdef DB_SD
+            Serial.println("Blackbox file not preallocated.");
+#endif
+        }
+        BlackboxSession = 0;
+    }
+    else
+    {
+        memset(&Header, 0, sizeof(Header));
+        BlackboxFile.seekSet(0);
+        if ((BlackboxFile.read(&Header, sizeof(Header)) == sizeof(Header)) && (Header.Magic == BLACKBOXMAGIC))
+        {
+            BlackboxSession = Header.Session;
+            if ((Header.Version == BLACKBOXVERSION) && (Header.WriteAt >= BLACKBOXHEADERSIZE) && (Header.WriteAt < BLACKBOXFILESIZE))
+            {
+                BlackboxWriteAt = Header.WriteAt + (BLACKBOXSYNCEVERY * sizeof(BlackboxBuffer[0])); // past any unnoted writes
+                if (BlackboxWriteAt >= BLACKBOXFILESIZE)
+                    BlackboxWriteAt = BLACKBOXHEADERSIZE + (BlackboxWriteAt - BLACKBOXFILESIZE);
+                BlackboxWriteAt -= (BlackboxWriteAt - BLACKBOXHEADERSIZE) % sizeof(BlackboxBuffer[0]);
+            }
+        }
+    }
+    BlackboxStartTime = RTC.get();
+    BlackboxSessionStarted = false; // The session number goes up with the first record
+    BlackboxFilling = 0;
+    BlackboxCount = 0;
+    BlackboxFull = -1;
+    BlackboxSequence = 0;
+    BlackboxDropped = 0;
+    BlackboxUnsynced = 0;
+    BlackboxOpen = true;
+}
+
+/*********************************************************************************************************************************/
+// Notes the session and where it has got to. Written with the first buffer of a session and then with every sync.
+
+void WriteBlackboxHeader()
+{
+    BlackboxFileHeader Header;
+    memset(&Header, 0, sizeof(Header));
+    Header.Magic = BLACKBOXMAGIC;
+    Header.Version = BLACKBOXVERSION;
+    Header.RecordSize = sizeof(BlackboxRecord);
+    Header.Session = BlackboxSession;
+    Header.StartTime = BlackboxStartTime;
+    Header.FileSize = BLACKBOXFILESIZE;
+    strncpy(Header.ModelName, ModelName, sizeof(Header.ModelName) - 1);
+    Header.WriteAt = BlackboxWriteAt;
+    BlackboxFile.seekSet(0);
+    BlackboxFile.write(&Header, sizeof(Header)); // (The rest of the header's sector is never written)
+}
+
+/*********************************************************************************************************************************/
+// Called by SendData() for every packet. Only copies into RAM.
+
+FASTRUN void RecordBlackbox(uint8_t Flags, uint8_t ChannelsSent, uint8_t Retries)
+{
+    if (!BlackboxOpen || !UseLog)
+        return;
+    if (!BlackboxSessionStarted)
+    {
+        ++BlackboxSession; // Records left from earlier sessions are told apart by this
+        BlackboxSessionStarted = true;
+        BlackboxHeaderDue = true;
+    }
+    ++BlackboxSequence;
+    if (BlackboxCount >= BLACKBOXRECORDS)
+    {
+        ++BlackboxDropped; // Both halves full: the SD card is behind
+        return;
+    }
+    BlackboxRecord *Record = &BlackboxBuffer[BlackboxFilling][BlackboxCount];
+    Record->Session = BlackboxSession;
+    Record->Sequence = BlackboxSequence;
+    Record->Time = LastPacketSentTime;
+    for (uint8_t i = 0; i < 16; ++i)
+        Record->Channels[i] = SendBuffer[i];
+    uint32_t Gap = GapStart ? (millis() - GapStart) : ThisGap;
+    Record->Gap = (Gap > 0xFFFF) ? 0xFFFF : Gap;
+    Record->Switches = 0;
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        if (Switch[i])
+            Record->Switches |= (1 << i);
+        if (TrimSwitch[i])
+            Record->Switches |= (1 << (i + 8));
+    }
+    memcpy(Record->Ack, AckPayload.Ack_Payload_byte, PAYLOADSIZE);
+    Record->HopChannel = CurrentChannel;
+    Record->Retries = Retries;
+    Record->Flags = Flags;
+    if (ModelMatched)
+        Record->Flags |= BLACKBOX_MODELMATCHED;
+    Record->Bank = Bank;
+    Record->ChannelsSent = ChannelsSent;
+    memset(Record->Spare, 0, sizeof(Record->Spare));
+
+    if ((++BlackboxCount >= BLACKBOXRECORDS) && (BlackboxFull < 0))
+    {
+        BlackboxFull = BlackboxFilling; // Hand it to ManageBlackbox() ...
+        BlackboxFilling ^= 1;           // ... and fill the other half
+        BlackboxCount = 0;
+    }
+}
+
+/*********************************************************************************************************************************/
+
+void WriteBlackboxBuffer(uint8_t Half, uint16_t Records)
+{
+    uint32_t Length = Records * sizeof(BlackboxRecord);
+    if (BlackboxWriteAt + Length > BLACKBOXFILESIZE)
+        BlackboxWriteAt = BLACKBOXHEADERSIZE; // Wrap around
+    BlackboxFile.seekSet(BlackboxWriteAt);
+    BlackboxFile.write(BlackboxBuffer[Half], Length);
+    BlackboxWriteAt += Length;
+    if (BlackboxHeaderDue || (++BlackboxUnsynced >= BLACKBOXSYNCEVERY))
+    {
+        WriteBlackboxHeader();
+        BlackboxFile.sync(); // So that a power cut loses only the last few seconds
+        BlackboxUnsynced = 0;
+        BlackboxHeaderDue = false;
+    }
+}
+
+/*********************************************************************************************************************************/
+// Called from ManageTransmitter(). Writes a full half of the buffer, if there is one.
+
+void ManageBlackbox()
+{
+    if (!BlackboxOpen || (BlackboxFull < 0))
+        return;
+#ifdef DB_SD
+    uint32_t StartTime = micros();
+#endif
+    WriteBlackboxBuffer(BlackboxFull, BLACKBOXRECORDS);
+    if (BlackboxCount >= BLACKBOXRECORDS) // The other half filled up meanwhile
+    {
+        BlackboxFilling = BlackboxFull;
+        BlackboxFull ^= 1;
+        BlackboxCount = 0;
+    }
+    else
+    {
+        BlackboxFull = -1;
+    }
+#ifdef DB_SD
+    Serial.print("Blackbox 4K write took ");
+    Serial.print(micros() - StartTime);
+    Serial.print(" us. Dropped so far: ");
+    Serial.println(BlackboxDropped);
+#endif
+}
+
+/*********************************************************************************************************************************/
+// Before power off: everything still in RAM goes to SD.
+
+void StopBlackbox()
+{
+    if (!BlackboxOpen)
+        return;
+    if (BlackboxFull >= 0)
+        ManageBlackbox();
+    if (BlackboxFull >= 0)
+        ManageBlackbox(); // (if the other half was full too)
+    if (BlackboxCount)
+        WriteBlackboxBuffer(BlackboxFilling, BlackboxCount);
+    BlackboxCount = 0;
+    if (BlackboxSessionStarted)
+        WriteBlackboxHeader();
+    BlackboxFile.sync();
+    BlackboxFile.close();
+    BlackboxOpen = false;
+}
+
+#endif
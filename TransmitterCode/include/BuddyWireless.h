@@ -29,20 +29,10 @@ bool LoadCorrectModel(uint64_t ModelID)
     static uint64_t FailedID = 0;            //  The ID of the model that failed to be found
     if (ModelID == FailedID)
         return false; // If the model failed to load, then don't try again
-    ModelMatched = false;
-    ModelNumber = 0;                                            //  Start from the first model
-    while (!ModelMatched && (ModelNumber < MAXMODELNUMBER - 1)) //  Try to match the ID with a saved one
-    {
-        ++ModelNumber;
-        ReadOneModel(ModelNumber);
-        if ((ModelID == ModelsMacUnionSaved.Val64))
-        {
-            ModelMatched = true; //  Found it!
-            PlaySound(MMFOUND);  //  Play the sound
-        }
-    }
+    ModelMatched = LoadModelByID(ModelID); //  Try to match the ID with a saved one
     if (ModelMatched)
     {                                 //  Found it!
+        PlaySound(MMFOUND);           //  Play the sound
         UpdateModelsNameEveryWhere(); //  Show it everywhere.
         SaveAllParameters();          //  Save it
         CheckModelName();             //  Check if the model name is valid and change it if not
@@ -50,6 +50,7 @@ void ChannelCentres()
     for (int i = 0; i < PROPOCHANNELS; ++i)
     {
         ChannelCentre[i] = AnalogueReed(i);
+        MeasureInputNoise(i, ChannelCentre[i]);
         ChannelMidHi[i] = ChannelCentre[i] + ((ChannelMax[i] - ChannelCentre[i]) / 2);
         ChannelMidLow[i] = ChannelMin[i] + ((ChannelCentre[i] - ChannelMin[i]) / 2);
     }
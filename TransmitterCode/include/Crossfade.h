@@ -0,0 +1,101 @@
+// *************************************** Crossfade.h *****************************************
+
+// Crossfading between banks. While a fade runs, GetNewChannelValues() evaluates the OLD bank as well as the new one and
+// blends the two. test/CrossfadeBenchmark.cpp times a whole crossfade pass against the packet budget (PaceMaker).
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef CROSSFADE_H
+#define CROSSFADE_H
+
+/*********************************************************************************************************************************/
+// Bank crossfade. For BankCrossfadeTime tenths of a second after a bank change, the old bank is evaluated too and the two
+// results are blended, so collective and pitch curves etc. don't jump. Going back to the old bank mid-fade reverses the fade smoothly.
+// Bank 4 is forced by the Auto switch (hold / autorotation), so going into or out of it, or any change of the motor switch,
+// cuts over at once.
+FASTRUN void CheckForBankCrossfade()
+{
+    static uint8_t LastPipelineBank = 0;
+    static uint32_t LastPipelineModel = 0;
+    static bool LastPipelineMotor = false;
+    uint32_t Duration = BankCrossfadeTime * 100;
+
+    if (ModelNumber != LastPipelineModel) // never crossfade between models
+    {
+        LastPipelineModel = ModelNumber;
+        LastPipelineBank = Bank;
+        BankCrossfading = false;
+    }
+    if ((MotorEnabled != LastPipelineMotor) || (Bank == 4) || (LastPipelineBank == 4))
+    {
+        LastPipelineMotor = MotorEnabled;
+        LastPipelineBank = Bank;
+        BankCrossfading = false; // forced: no fade
+    }
+    if (Bank != LastPipelineBank)
+    {
+        if (BankCrossfading && (Bank == CrossfadeFromBank))
+        {
+            uint32_t Elapsed = millis() - CrossfadeStartTime;
+            CrossfadeStartTime = millis() - (Duration - Elapsed); // same blend, just the other way
+            CrossfadeFromBank = LastPipelineBank;
+        }
+        else if (Duration)
+        {
+            CrossfadeFromBank = LastPipelineBank;
+            CrossfadeStartTime = millis();
+            BankCrossfading = true;
+        }
+        LastPipelineBank = Bank;
+    }
+    if (BankCrossfading && (millis() - CrossfadeStartTime >= Duration))
+        BankCrossfading = false;
+}
+
+/*********************************************************************************************************************************/
+// Must be called after GetDirtyOutputs() and BEFORE MixInputs(). Runs the bank dependent stages for the OLD bank and leaves
+// the results in CrossfadeBuffer. InputsBuffer[] and CurveCache[] are left as they were for the new bank's pass.
+// Slowed servos are only applied to the new bank.
+FASTRUN void EvaluateCrossfadeBank()
+{
+    uint16_t SavedInputs[CHANNELSUSED];
+    uint8_t NewBank = Bank;
+
+    memcpy(SavedInputs, InputsBuffer, sizeof(SavedInputs));
+    Bank = CrossfadeFromBank;
+    MixInputs();
+    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
+    {
+        GetCurveDots(OutputChannel, DualRateValue);
+        PreMixBuffer[OutputChannel] = Interpolate[InterpolationTypes[Bank][OutputChannel]](InputsBuffer[OutputChannel], InPutStick[OutputChannel], OutputChannel);
+        SendBuffer[OutputChannel] = PreMixBuffer[OutputChannel];
+    }
+    MixOutputs();
+    DoTrimsAndSubtrims();
+    memcpy(CrossfadeBuffer, SendBuffer, sizeof(SavedInputs));
+    Bank = NewBank;
+    memcpy(InputsBuffer, SavedInputs, sizeof(SavedInputs));
+}
+
+/*********************************************************************************************************************************/
+// Must be called after DoTrimsAndSubtrims() for the new bank. Blends linearly from the old bank's outputs to the new bank's.
+// The motor channel is never blended: it goes straight to the new bank's value.
+FASTRUN void BlendBanks()
+{
+    uint32_t Duration = BankCrossfadeTime * 100;
+    uint32_t Elapsed = millis() - CrossfadeStartTime;
+    if (!Duration || Elapsed >= Duration)
+        return;
+    int32_t Weight = (Elapsed * 256) / Duration; // 0 = all old bank, 256 = all new bank
+    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
+    {
+        if (OutputChannel == MotorChannel)
+            continue;
+        int32_t Old = CrossfadeBuffer[OutputChannel];
+        SendBuffer[OutputChannel] = Old + ((((int32_t)SendBuffer[OutputChannel] - Old) * Weight) / 256);
+        PreMixBuffer[OutputChannel] = SendBuffer[OutputChannel];
+    }
+}
+
+#endif
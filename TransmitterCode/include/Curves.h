@@ -0,0 +1,118 @@
+// *************************************** Curves.h *****************************************
+
+// The curve stage of the channel pipeline: each output channel's input is put through its bank's curve (straight lines,
+// Catmull spline or exponential), then trims and subtrims are added after the output mixes.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef CURVES_H
+#define CURVES_H
+
+/*********************************************************************************************************************************/
+uint16_t CatmullSplineInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
+{
+    xPoints[0] = ChannelMin[InputChannel];
+    xPoints[1] = ChannelMidLow[InputChannel];
+    xPoints[2] = ChannelCentre[InputChannel];
+    xPoints[3] = ChannelMidHi[InputChannel];
+    xPoints[4] = ChannelMax[InputChannel];
+    yPoints[4] = IntoHigherRes(CurveDots[4]);
+    yPoints[3] = IntoHigherRes(CurveDots[3]);
+    yPoints[2] = IntoHigherRes(CurveDots[2]);
+    yPoints[1] = IntoHigherRes(CurveDots[1]);
+    yPoints[0] = IntoHigherRes(CurveDots[0]);
+    return Interpolation::CatmullSpline(xPoints, yPoints, PointsCount, InputValue);
+}
+/*********************************************************************************************************************************/
+uint16_t StraightLineInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
+{
+    uint16_t k = 0;
+    if (InputValue >= ChannelMidHi[InputChannel])
+    {
+        k = map(InputValue, ChannelMidHi[InputChannel], ChannelMax[InputChannel], IntoHigherRes(CurveDots[3]), IntoHigherRes(CurveDots[4]));
+    }
+
+    if (InputValue >= ChannelCentre[InputChannel] && InputValue <= (ChannelMidHi[InputChannel]))
+    {
+        k = map(InputValue, ChannelCentre[InputChannel], ChannelMidHi[InputChannel], IntoHigherRes(CurveDots[2]), IntoHigherRes(CurveDots[3]));
+    }
+
+    if (InputValue >= ChannelMidLow[InputChannel] && InputValue <= ChannelCentre[InputChannel])
+    {
+        k = map(InputValue, ChannelMidLow[InputChannel], ChannelCentre[InputChannel], IntoHigherRes(CurveDots[1]), IntoHigherRes(CurveDots[2]));
+    }
+
+    if (InputValue <= ChannelMidLow[InputChannel])
+    {
+        k = map(InputValue, ChannelMin[InputChannel], ChannelMidLow[InputChannel], IntoHigherRes(CurveDots[0]), IntoHigherRes(CurveDots[1]));
+    }
+
+    return k;
+}
+/*********************************************************************************************************************************/
+uint16_t ExponentialInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
+{
+    uint16_t k = 0;
+    if (InputValue >= ChannelCentre[InputChannel])
+    {
+        k = MapWithExponential(InputValue - ChannelCentre[InputChannel], 0, ChannelMax[InputChannel] - ChannelCentre[InputChannel], 0, IntoHigherRes(CurveDots[4]) - IntoHigherRes(CurveDots[2]), Exponential[Bank][OutputChannel]) + IntoHigherRes(CurveDots[2]);
+    }
+    else
+    {
+        k = MapWithExponential(ChannelCentre[InputChannel] - InputValue, 0, ChannelCentre[InputChannel] - ChannelMin[InputChannel], IntoHigherRes(CurveDots[2]) - IntoHigherRes(CurveDots[0]), 0, Exponential[Bank][OutputChannel]) + IntoHigherRes(CurveDots[0]);
+    }
+    return k;
+}
+
+/*********************************************************************************************************************************/
+// ************* Small function pointer array for interpolation types ************************************************************
+
+uint16_t (*Interpolate[3])(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel){
+    StraightLineInterpolation,  // 0
+    CatmullSplineInterpolation, // 1
+    ExponentialInterpolation    // 2
+};
+
+/*********************************************************************************************************************************/
+
+void DoTrimsAndSubtrims()
+{
+
+    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
+    {
+        uint16_t InputChannel = InPutStick[OutputChannel]; // Input sticks knobs & switches are mapped by user
+        // ClaudeFix-2-7-2026 Signed maths! SendBuffer is uint16_t: a low curve value plus a negative
+        // subtrim/trim used to wrap below zero to ~65000, and constrain then
+        // clamped it to MAXMICROS -- FULL deflection in the WRONG direction.
+        int TrimmedValue = (int)SendBuffer[OutputChannel];
+        TrimmedValue += (SubTrims[OutputChannel] - 127) * 5;                       // ADD SUBTRIM to output channel, (Range 0 - 127 - 254) multiplier is always 5 otherwise subtrim might keep changing
+        TrimmedValue += GetTrimAmount(InputChannel);                               // ADD TRIM to output channel
+        SendBuffer[OutputChannel] = constrain(TrimmedValue, MINMICROS, MAXMICROS); // Keep within limits
+        PreMixBuffer[OutputChannel] = SendBuffer[OutputChannel];                   // premixbuffer will be needed again...
+    }
+}
+
+/*********************************************************************************************************************************/
+// Only channels whose BIT is set in Dirty get their curve recomputed. The others reuse the value cached last time.
+FASTRUN void CalculateChangedOutputs(uint16_t Dirty)
+{
+    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
+    {
+        if (Dirty & (1 << OutputChannel))
+        {
+            GetCurveDots(OutputChannel, DualRateValue);                                                                                                              // This for the Dual Rates function
+            CurveCache[OutputChannel] = Interpolate[InterpolationTypes[Bank][OutputChannel]](InputsBuffer[OutputChannel], InPutStick[OutputChannel], OutputChannel); // Use function pointer array to invoke selected interpolation.
+        }
+        PreMixBuffer[OutputChannel] = CurveCache[OutputChannel];
+        SendBuffer[OutputChannel] = PreMixBuffer[OutputChannel]; // Copy now to SendBuffer in case no mixes are needed
+    }
+}
+
+/*********************************************************************************************************************************/
+void CalculateAllOutputs()
+{
+    CalculateChangedOutputs(0xFFFF);
+}
+
+#endif
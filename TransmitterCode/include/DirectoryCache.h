@@ -0,0 +1,261 @@
+// *************************************** DirectoryCache.h *****************************************
+
+// The file lists (log files, help files, backups, images) come from here instead of reading the SD card's
+// directory every time. Each directory is read once, the first time it's listed, with each file's sort key
+// (its name, the date in a log file's name) and its size. It's sorted once (qsort) and then kept sorted:
+// when this code adds or deletes a file it calls NoteFileAdded() or NoteFileRemoved(), which update just that
+// entry. (Nothing else writes to the card while the transmitter is running.)
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef DIRECTORY_CACHE_H
+#define DIRECTORY_CACHE_H
+
+/*********************************************************************************************************************************/
+// Which cache a filename or extension belongs in (as AddPath() decides its directory), or -1.
+
+int8_t DirectoryKind(const char *Name)
+{
+    if (InStrng((char *)".LOG", (char *)Name))
+        return DIR_LOG;
+    if (InStrng((char *)".TXT", (char *)Name))
+        return DIR_HELP;
+    if (InStrng((char *)".MOD", (char *)Name))
+        return DIR_BACKUPS;
+    if (InStrng((char *)".jpg", (char *)Name))
+        return DIR_IMAGES;
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+// Log files are named by date: 23-08-24.LOG is 23rd August '24. The key is 23 + (8 * 31) + (24 * 31 * 12).
+
+int32_t FileDateKey(const char *Name)
+{
+    char Part[3];
+    int32_t DateKey = 0;
+    Part[2] = 0;
+    Part[0] = Name[0];
+    Part[1] = Name[1];
+    DateKey = atoi(Part); // the DAY
+    Part[0] = Name[3];
+    Part[1] = Name[4];
+    DateKey += atoi(Part) * 31; // the MONTH
+    Part[0] = Name[6];
+    Part[1] = Name[7];
+    DateKey += atoi(Part) * 31 * 12; // the YEAR
+    return DateKey;
+}
+
+/*********************************************************************************************************************************/
+
+int CompareByName(const void *a, const void *b)
+{
+    return strcmp(((const DirectoryEntry *)a)->Name, ((const DirectoryEntry *)b)->Name);
+}
+
+/*********************************************************************************************************************************/
+
+int CompareByDateDescending(const void *a, const void *b) // so recent log files are at the top
+{
+    const DirectoryEntry *A = (const DirectoryEntry *)a;
+    const DirectoryEntry *B = (const DirectoryEntry *)b;
+    if (A->Date != B->Date)
+        return (A->Date < B->Date) ? 1 : -1;
+    return strcmp(A->Name, B->Name);
+}
+
+/*********************************************************************************************************************************/
+
+int CompareDirectoryEntries(uint8_t Kind, const DirectoryEntry *a, const DirectoryEntry *b)
+{
+    if (Kind == DIR_LOG)
+        return CompareByDateDescending(a, b);
+    return CompareByName(a, b);
+}
+
+/*********************************************************************************************************************************/
+// Names are kept as they're listed: no more than 12 characters, and no trailing spaces (the list pads them).
+
+void MakeEntryName(char *EntryName, const char *Name)
+{
+    strncpy(EntryName, Name, 12);
+    EntryName[12] = 0;
+    int8_t i = strlen(EntryName) - 1;
+    while ((i >= 0) && (EntryName[i] == ' '))
+        EntryName[i--] = 0;
+}
+
+/*********************************************************************************************************************************/
+
+bool WantedInList(uint8_t Kind, const char *Name)
+{
+    return (DirectoryKind(Name) == Kind) && !InStrng((char *)"._", (char *)Name);
+}
+
+/*********************************************************************************************************************************/
+
+void SortDirectory()
+{
+    int8_t Kind = DirectoryKind(MOD);
+    if (Kind < 0)
+        return;
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    qsort(Cache->Entries, Cache->Count, sizeof(DirectoryEntry), (Kind == DIR_LOG) ? CompareByDateDescending : CompareByName);
+}
+
+/*********************************************************************************************************************************/
+// Reads the whole directory once.
+
+void ScanDirectory(uint8_t Kind)
+{
+    const char *Paths[DIRECTORYKINDS] = {"/log/", "/help/", "/mod/", "/Images/"};
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+#ifdef DB_SD
+    uint32_t StartTime = millis();
+#endif
+    Cache->Count = 0;
+    File dir = TINYCARD.open(Paths[Kind]);
+    while (dir)
+    {
+        File entry = dir.openNextFile();
+        if (!entry)
+            break;
+        if (WantedInList(Kind, entry.name()) && (Cache->Count < MAXDIRENTRIES))
+        {
+            DirectoryEntry *Entry = &Cache->Entries[Cache->Count];
+            MakeEntryName(Entry->Name, entry.name());
+            Entry->Date = FileDateKey(Entry->Name);
+            Entry->Size = entry.size();
+            ++Cache->Count;
+        }
+        entry.close();
+        KickTheDog();
+    }
+    dir.close();
+    if (Kind == DIR_BACKUPS)
+        AddBackupsToDirectory(Kind); // (The backup store's are listed from its index)
+    Cache->Loaded = true;
+    SortDirectory();
+#ifdef DB_SD
+    Serial.print("Directory ");
+    Serial.print(Paths[Kind]);
+    Serial.print(" read: ");
+    Serial.print(Cache->Count);
+    Serial.print(" files in ");
+    Serial.print(millis() - StartTime);
+    Serial.println(" ms");
+#endif
+}
+
+/*********************************************************************************************************************************/
+
+int16_t FindDirectoryEntry(uint8_t Kind, const char *EntryName)
+{
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    for (uint16_t i = 0; i < Cache->Count; ++i)
+    {
+        if (strcmp(Cache->Entries[i].Name, EntryName) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+// Call after this code creates (or rewrites) a file. Its size is read from the card. The entry goes straight into
+// its sorted place.
+
+void NoteFileAdded(const char *Name)
+{
+    int8_t Kind = DirectoryKind(Name);
+    if ((Kind < 0) || !DirectoryCache[Kind].Loaded || !WantedInList(Kind, Name))
+        return;
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    DirectoryEntry NewEntry;
+    MakeEntryName(NewEntry.Name, Name);
+    NewEntry.Date = FileDateKey(NewEntry.Name);
+    NewEntry.Size = (Kind == DIR_BACKUPS) ? BackupFileSize(NewEntry.Name) : GetFileSize(NewEntry.Name);
+    int16_t Found = FindDirectoryEntry(Kind, NewEntry.Name);
+    if (Found >= 0)
+    {
+        Cache->Entries[Found].Size = NewEntry.Size;
+        return;
+    }
+    if (Cache->Count >= MAXDIRENTRIES)
+        return;
+    uint16_t Low = 0; // Binary search for the first entry that sorts after the new one
+    uint16_t High = Cache->Count;
+    while (Low < High)
+    {
+        uint16_t Middle = (Low + High) / 2;
+        if (CompareDirectoryEntries(Kind, &Cache->Entries[Middle], &NewEntry) <= 0)
+            Low = Middle + 1;
+        else
+            High = Middle;
+    }
+    memmove(&Cache->Entries[Low + 1], &Cache->Entries[Low], (Cache->Count - Low) * sizeof(DirectoryEntry));
+    Cache->Entries[Low] = NewEntry;
+    ++Cache->Count;
+}
+
+/*********************************************************************************************************************************/
+// Call after this code deletes a file.
+
+void NoteFileRemoved(const char *Name)
+{
+    char EntryName[13];
+    int8_t Kind = DirectoryKind(Name);
+    if ((Kind < 0) || !DirectoryCache[Kind].Loaded)
+        return;
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    MakeEntryName(EntryName, Name);
+    int16_t Found = FindDirectoryEntry(Kind, EntryName);
+    if (Found < 0)
+        return;
+    memmove(&Cache->Entries[Found], &Cache->Entries[Found + 1], (Cache->Count - Found - 1) * sizeof(DirectoryEntry));
+    --Cache->Count;
+}
+
+/*********************************************************************************************************************************/
+// After the card is (re)started nothing cached can be trusted.
+
+void ForgetDirectories()
+{
+    for (uint8_t i = 0; i < DIRECTORYKINDS; ++i)
+    {
+        DirectoryCache[i].Loaded = false;
+        DirectoryCache[i].Count = 0;
+    }
+}
+
+/*********************************************************************************************************************************/
+// Fills TheFilesList[] (and TheFilesSizes[]) with the files whose extension is MOD, already sorted.
+
+void BuildDirectory()
+{
+    ExportedFileCounter = 0;
+    int8_t Kind = DirectoryKind(MOD);
+    if (Kind < 0)
+        return;
+    DirectoryCacheData *Cache = &DirectoryCache[Kind];
+    if (!Cache->Loaded)
+        ScanDirectory(Kind);
+    if ((Kind == DIR_LOG) && LogWriteFileOpen)
+    {
+        FlushLogRing(true); // Today's log keeps growing: show its real size
+        int16_t Found = FindDirectoryEntry(Kind, LogWriteFileName);
+        if (Found >= 0)
+            Cache->Entries[Found].Size = LogWriteOffset;
+    }
+    for (uint16_t i = 0; (i < Cache->Count) && (ExportedFileCounter < FILESLISTSIZE); ++i)
+    {
+        strcpy(TheFilesList[ExportedFileCounter], Cache->Entries[i].Name);
+        TheFilesSizes[ExportedFileCounter] = Cache->Entries[i].Size;
+        ++ExportedFileCounter;
+    }
+    if (Kind == DIR_LOG)
+        SortLogFilesByFlights();
+}
+
+#endif
@@ -231,7 +231,7 @@ void CheckDualRatesScreen(uint32_t RightNow)
     if (RightNow - LastRatesPoll < 600)
         return;
     LastRatesPoll = RightNow;
-    if (NEXTION.available())
+    if (NextionInputWaiting())
         return;   // a button press is waiting — never poll over it
     for (uint8_t i = 0; i < 8; ++i)
     {
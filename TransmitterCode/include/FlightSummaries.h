@@ -0,0 +1,329 @@
+// *************************************** FlightSummaries.h *****************************************
+
+// At the end of every flight (when the connection ends) one 128 byte FlightSummary is added to flights.dat: model,
+// duration, max RPM, amps, altitude, mAh, packet success rate, longest gap and so on. These are the figures that
+// LogDisConnection() writes as text, but here they can be read without finding and parsing the text.
+// The log files list shows each day's flights, time connected and worst success rate from FlightDays[], which is
+// built from flights.dat (4K at a time) the first time it's needed and then kept up to date. LogSort re-sorts the list
+// by those figures (worst link, longest gap, most flying), and WorstLinks lists this model's worst sessions.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef FLIGHT_SUMMARIES_H
+#define FLIGHT_SUMMARIES_H
+
+/*********************************************************************************************************************************/
+
+uint32_t FlightRecordCrc(const FlightSummary *Flight)
+{
+    return Crc32((const uint8_t *)Flight, sizeof(FlightSummary) - 4);
+}
+
+/*********************************************************************************************************************************/
+// Records that fail their CRC (a write cut short) are skipped.
+
+bool FlightRecordGood(const FlightSummary *Flight)
+{
+    return (Flight->Magic == FLIGHTMAGIC) && (Flight->RecordCrc == FlightRecordCrc(Flight));
+}
+
+/*********************************************************************************************************************************/
+
+int16_t FindFlightDay(const char *LogFile)
+{
+    char EntryName[13];
+    MakeEntryName(EntryName, LogFile);
+    for (uint16_t i = 0; i < FlightDayCount; ++i)
+    {
+        if (strcmp(FlightDays[i].LogFile, EntryName) == 0)
+            return i;
+    }
+    return -1;
+}
+
+/*********************************************************************************************************************************/
+// Adds one flight to its day's totals.
+
+void NoteFlight(const FlightSummary *Flight)
+{
+    if (!Flight->LogFile[0])
+        return; // Not logged, so not in any log file
+    int16_t Day = FindFlightDay(Flight->LogFile);
+    if (Day < 0)
+    {
+        if (FlightDayCount >= MAXDIRENTRIES)
+            return;
+        Day = FlightDayCount++;
+        memset(&FlightDays[Day], 0, sizeof(FlightDay));
+        MakeEntryName(FlightDays[Day].LogFile, Flight->LogFile);
+        FlightDays[Day].WorstRate = 0xFFFF;
+    }
+    FlightDay *ThisDay = &FlightDays[Day];
+    ++ThisDay->Flights;
+    ThisDay->Seconds += Flight->Duration;
+    if (Flight->SuccessRate < ThisDay->WorstRate)
+        ThisDay->WorstRate = Flight->SuccessRate;
+    if (Flight->LongestGap > ThisDay->LongestGap)
+        ThisDay->LongestGap = Flight->LongestGap;
+}
+
+/*********************************************************************************************************************************/
+// Reads all of flights.dat once.
+
+void LoadFlightSummaries()
+{
+    FlightSummary Chunk[FLIGHTSREADCHUNK];
+    FlightDayCount = 0;
+    FlightDaysLoaded = true;
+#ifdef DB_SD
+    uint32_t StartTime = millis();
+    uint32_t Flights = 0;
+#endif
+    File FlightsFile = TINYCARD.open(FLIGHTSFILE, FILE_READ);
+    if (!FlightsFile)
+        return;
+    int Got;
+    while ((Got = FlightsFile.read((uint8_t *)Chunk, sizeof(Chunk))) >= (int)sizeof(FlightSummary))
+    {
+        for (uint16_t i = 0; i < Got / sizeof(FlightSummary); ++i)
+        {
+            if (FlightRecordGood(&Chunk[i]))
+                NoteFlight(&Chunk[i]);
+#ifdef DB_SD
+            ++Flights;
+#endif
+        }
+        KickTheDog();
+    }
+    FlightsFile.close();
+#ifdef DB_SD
+    Serial.print(Flights);
+    Serial.print(" flight summaries read in ");
+    Serial.print(millis() - StartTime);
+    Serial.println(" ms");
+#endif
+}
+
+/*********************************************************************************************************************************/
+
+bool FlightIsWorse(const FlightSummary *a, const FlightSummary *b, uint8_t OrderBy)
+{
+    if (OrderBy == FLIGHTS_BY_LONGESTGAP)
+        return a->LongestGap > b->LongestGap;
+    return a->SuccessRate < b->SuccessRate;
+}
+
+/*********************************************************************************************************************************/
+// The MaxFlights worst sessions in flights.dat for one model (ModelID 0 = every model), worst first, by success rate or
+// by longest gap. One pass over the file, 4K at a time, keeping only the worst so far. Returns how many were found.
+
+uint16_t FindWorstFlights(uint64_t ModelID, uint8_t OrderBy, FlightSummary *Worst, uint16_t MaxFlights)
+{
+    FlightSummary Chunk[FLIGHTSREADCHUNK];
+    uint16_t Count = 0;
+    if (!MaxFlights)
+        return 0;
+    File FlightsFile = TINYCARD.open(FLIGHTSFILE, FILE_READ);
+    if (!FlightsFile)
+        return 0;
+    int Got;
+    while ((Got = FlightsFile.read((uint8_t *)Chunk, sizeof(Chunk))) >= (int)sizeof(FlightSummary))
+    {
+        for (uint16_t i = 0; i < Got / sizeof(FlightSummary); ++i)
+        {
+            if (!FlightRecordGood(&Chunk[i]) || (ModelID && (Chunk[i].ModelID != ModelID)))
+                continue;
+            if ((Count == MaxFlights) && !FlightIsWorse(&Chunk[i], &Worst[Count - 1], OrderBy))
+                continue;
+            uint16_t j = (Count < MaxFlights) ? Count++ : Count - 1; // insertion: the list is short
+            while ((j > 0) && FlightIsWorse(&Chunk[i], &Worst[j - 1], OrderBy))
+            {
+                Worst[j] = Worst[j - 1];
+                --j;
+            }
+            Worst[j] = Chunk[i];
+        }
+        KickTheDog();
+    }
+    FlightsFile.close();
+    return Count;
+}
+
+/*********************************************************************************************************************************/
+// After the card is (re)started.
+
+void ForgetFlightSummaries()
+{
+    FlightDaysLoaded = false;
+    FlightDayCount = 0;
+}
+
+/*********************************************************************************************************************************/
+// Called from RedLedOn() when a connection ends, before the figures are cleared.
+
+void SaveFlightSummary()
+{
+    FlightSummary Flight;
+    memset(&Flight, 0, sizeof(Flight));
+    Flight.Magic = FLIGHTMAGIC;
+    Flight.EndTime = RTC.get();
+    Flight.Duration = (millis() - LedGreenMoment) / 1000;
+    Flight.MotorOnSeconds = MotorOnSeconds;
+    Flight.ModelID = ModelsMacUnionSaved.Val64;
+    strncpy(Flight.ModelName, ModelName, sizeof(Flight.ModelName) - 1);
+    if (UseLog && LogWriteFileOpen)
+        MakeEntryName(Flight.LogFile, LogWriteFileName);
+    Flight.RxType = Receiver_type;
+    Flight.RXSwaps = RadioSwaps;
+    Flight.MaxRPM = Max_RotorRPM;
+    Flight.MaxAmps = Max_Battery_Amps;
+    Flight.MaxESCTemp = Max_ESC_Temp;
+    Flight.mAh = Battery_mAh;
+    Flight.BaroAltitude = RXMAXModelAltitude;
+    if (GPS_RX_FIX)
+    {
+        Flight.GPSAltitude = GPS_RX_Maxaltitude;
+        Flight.GPSDistance = GPS_RX_MaxDistance;
+        Flight.GPSSpeed = GPS_RX_MaxSpeed;
+    }
+    float Rate = GetOverallSuccessRate();
+    if (Rate > 100)
+        Rate = 100;
+    Flight.SuccessRate = Rate * 100;
+    Flight.LongestGap = (GapLongest > 0xFFFF) ? 0xFFFF : GapLongest;
+    Flight.AverageGap = (GapAverage > 0xFFFF) ? 0xFFFF : GapAverage;
+    Flight.LostPackets = TotalLostPackets;
+    Flight.PacketsSent = TotalPacketsAttempted;
+    Flight.RecordCrc = FlightRecordCrc(&Flight);
+
+    File FlightsFile = TINYCARD.open(FLIGHTSFILE, FILE_WRITE);
+    if (!FlightsFile)
+        return;
+    FlightsFile.seek((FlightsFile.size() / sizeof(FlightSummary)) * sizeof(FlightSummary)); // (after any torn record)
+    FlightsFile.write((uint8_t *)&Flight, sizeof(Flight));
+    FlightsFile.flush();
+    FlightsFile.close();
+    if (FlightDaysLoaded)
+        NoteFlight(&Flight);
+}
+
+/*********************************************************************************************************************************/
+// Adds " 3x 42m 97%" (flights, minutes connected, worst success rate) for a log file in the list.
+
+char *AddFlightsToFilename(int ff, char *stats)
+{
+    char Part[24];
+    if (!FlightDaysLoaded)
+        LoadFlightSummaries();
+    int16_t Day = FindFlightDay(TheFilesList[ff]);
+    if (Day < 0)
+        return stats;
+    snprintf(Part, sizeof(Part), " %ux %lum %u%%", FlightDays[Day].Flights, (unsigned long)(FlightDays[Day].Seconds / 60),
+             FlightDays[Day].WorstRate / 100);
+    strcat(stats, Part);
+    return stats;
+}
+
+/*********************************************************************************************************************************/
+// Log files list sort key from FlightDays[]: bigger sorts first. Days with no flights come last (-1).
+
+int32_t LogSortKey(uint16_t f)
+{
+    int16_t Day = FindFlightDay(TheFilesList[f]);
+    if (Day < 0)
+        return -1;
+    switch (LogSortOrder)
+    {
+    case LOGSORT_WORSTRATE:
+        return 10000 - FlightDays[Day].WorstRate;
+    case LOGSORT_LONGESTGAP:
+        return FlightDays[Day].LongestGap;
+    default:
+        return FlightDays[Day].Seconds;
+    }
+}
+
+/*********************************************************************************************************************************/
+// Called by BuildDirectory() once TheFilesList[] holds the log files, newest first. The sort is stable, so days that tie
+// stay newest first. The directory cache itself stays in date order.
+
+void SortLogFilesByFlights()
+{
+    int32_t Keys[FILESLISTSIZE];
+    if (LogSortOrder == LOGSORT_DATE)
+        return;
+    if (!FlightDaysLoaded)
+        LoadFlightSummaries();
+    for (uint16_t f = 0; f < ExportedFileCounter; ++f)
+        Keys[f] = LogSortKey(f);
+    for (uint16_t i = 1; i < ExportedFileCounter; ++i)
+    {
+        int32_t Key = Keys[i];
+        uint32_t Size = TheFilesSizes[i];
+        char Name[sizeof(TheFilesList[0])];
+        strcpy(Name, TheFilesList[i]);
+        int16_t j = i - 1;
+        while ((j >= 0) && (Keys[j] < Key))
+        {
+            Keys[j + 1] = Keys[j];
+            TheFilesSizes[j + 1] = TheFilesSizes[j];
+            strcpy(TheFilesList[j + 1], TheFilesList[j]);
+            --j;
+        }
+        Keys[j + 1] = Key;
+        TheFilesSizes[j + 1] = Size;
+        strcpy(TheFilesList[j + 1], Name);
+    }
+}
+
+/*********************************************************************************************************************************/
+
+const char *LogSortTitle()
+{
+    static const char *Titles[LOGSORTS] = {"All log files", "Worst link first", "Longest gap first", "Most flying first"};
+    return Titles[LogSortOrder];
+}
+
+/*********************************************************************************************************************************/
+// "LogSort" from the log files list: next sort order.
+
+void CycleLogSort()
+{
+    char t0[] = "t0";
+    if ((CurrentView != LOGFILESLISTVIEW) || strcmp(MOD, ".LOG"))
+        return;
+    LogSortOrder = (LogSortOrder + 1) % LOGSORTS;
+    SendText(t0, (char *)LogSortTitle());
+    BuildDirectory();
+    LoadFileSelector();
+}
+
+/*********************************************************************************************************************************/
+// "WorstLinks" from the log files list: this model's worst sessions by success rate, with their log files.
+
+void ShowWorstLinks()
+{
+    FlightSummary Worst[WORSTFLIGHTSSHOWN];
+    char Message[64 + WORSTFLIGHTSSHOWN * 48];
+    char Line[48];
+    char t0[] = "t0";
+    if (CurrentView != LOGFILESLISTVIEW)
+        return;
+    uint16_t Found = FindWorstFlights(ModelsMacUnionSaved.Val64, FLIGHTS_BY_SUCCESSRATE, Worst, WORSTFLIGHTSSHOWN);
+    snprintf(Message, sizeof(Message), "Worst links for %s:\r\n", ModelName);
+    if (!Found)
+        strcat(Message, "(No flights logged)");
+    for (uint16_t i = 0; i < Found; ++i)
+    {
+        snprintf(Line, sizeof(Line), "%s %u.%02u%% gap %ums\r\n", Worst[i].LogFile[0] ? Worst[i].LogFile : "(no log)",
+                 Worst[i].SuccessRate / 100, Worst[i].SuccessRate % 100, Worst[i].LongestGap);
+        strcat(Message, Line);
+    }
+    MsgBox((char *)"page LogFiles", Message);
+    DelayWithDog(70);
+    SendText(t0, (char *)LogSortTitle());
+    LoadFileSelector();
+}
+
+#endif
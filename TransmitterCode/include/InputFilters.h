@@ -0,0 +1,263 @@
+// *************************************** InputFilters.h *****************************************
+
+// This is the per-input filter stage that sits between sampling the sticks & knobs and MixInputs().
+// Each of the 8 analogue inputs is read ONCE per pipeline pass, passed through its selected filter
+// (none, median, biquad low-pass or One-Euro) and then through an adaptive deadband whose width
+// was measured from that input's own noise while the sticks were centred during calibration.
+// The deadband is applied AFTER the filter, so it is scaled down by however much of that noise
+// the filter has already removed; otherwise a filtered stick would be held back twice.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef INPUTFILTERS_H
+#define INPUTFILTERS_H
+
+struct InputFilterState
+{
+    uint16_t MedianHistory[MEDIANFILTERSIZE]; // Last few raw samples (ring)
+    uint8_t MedianIndex;                      // Next slot in the ring
+    float BiquadZ1;                           // Biquad (transposed direct form II) state
+    float BiquadZ2;                           //
+    float EuroX;                              // One-Euro filtered value
+    float EuroDx;                             // One-Euro filtered derivative
+    uint16_t Output;                          // Value after the deadband (what the pipeline sees)
+    uint8_t Deadband;                         // InputDeadband scaled by the noise this filter lets through
+    bool Primed;                              // false until the first sample has been taken
+};
+
+InputFilterState InputFilter[PROPOCHANNELS];
+uint16_t FilteredInput[PROPOCHANNELS]; // Filtered and deadbanded input values used by GetAllInputs()
+float BiquadB0, BiquadB1, BiquadB2, BiquadA1, BiquadA2;
+uint32_t LastInputFilterTime = 0;
+
+// Noise measurement while sticks are centred
+uint32_t NoiseSum[PROPOCHANNELS];
+uint32_t NoiseCount[PROPOCHANNELS];
+uint16_t NoiseLastSample[PROPOCHANNELS];
+
+/*********************************************************************************************************************************/
+// Smoothing factor of an exponential average with this cutoff (One-Euro is two of them).
+
+FASTRUN float EuroAlpha(float Cutoff, float dt)
+{
+    float Tau = 1.0f / (2.0f * PI * Cutoff);
+    return 1.0f / (1.0f + Tau / dt);
+}
+
+/*********************************************************************************************************************************/
+// How much of an input's (white) noise gets through its filter with the stick still, as a fraction of the noise's
+// standard deviation. The biquad's comes from its impulse response; One-Euro's is an exponential average's at its
+// minimum cutoff.
+
+float FilterNoiseGain(uint8_t FilterType)
+{
+    float dt = FHSS_data::PaceMaker * 0.001f;
+    switch (FilterType)
+    {
+    case FILTER_MEDIAN:
+        return MEDIANNOISEGAIN;
+    case FILTER_BIQUAD:
+    {
+        float x = 1.0f, z1 = 0, z2 = 0, Sum = 0; // feed it one impulse
+        for (uint16_t n = 0; n < 500; ++n)
+        {
+            float y = BiquadB0 * x + z1;
+            z1 = BiquadB1 * x - BiquadA1 * y + z2;
+            z2 = BiquadB2 * x - BiquadA2 * y;
+            Sum += y * y;
+            x = 0;
+        }
+        return sqrtf(Sum);
+    }
+    case FILTER_ONEEURO:
+    {
+        float Alpha = EuroAlpha(ONEEURO_MINCUTOFF, dt);
+        return sqrtf(Alpha / (2.0f - Alpha));
+    }
+    default:
+        return 1.0f;
+    }
+}
+
+/*********************************************************************************************************************************/
+// Butterworth low-pass coefficients for the current pipeline rate. The pipeline runs once per packet so the sample rate follows PaceMaker.
+
+void InitInputFilters()
+{
+    float SampleRate = 1000.0f / (float)FHSS_data::PaceMaker;
+    float Fc = BIQUADCUTOFF;
+    if (Fc > SampleRate * 0.4f)
+        Fc = SampleRate * 0.4f; // keep well below Nyquist
+    float K = tanf(PI * Fc / SampleRate);
+    float Norm = 1.0f / (1.0f + K * 1.41421356f + K * K);
+    BiquadB0 = K * K * Norm;
+    BiquadB1 = 2.0f * BiquadB0;
+    BiquadB2 = BiquadB0;
+    BiquadA1 = 2.0f * (K * K - 1.0f) * Norm;
+    BiquadA2 = (1.0f - K * 1.41421356f + K * K) * Norm;
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        InputFilter[i].Primed = false;
+        InputFilterType[i] = CheckRange(InputFilterType[i], FILTER_NONE, FILTER_ONEEURO);
+        InputDeadband[i] = CheckRange(InputDeadband[i], 0, MAXINPUTDEADBAND);
+        InputFilter[i].Deadband = lroundf(InputDeadband[i] * FilterNoiseGain(InputFilterType[i]));
+        if (InputDeadband[i] && !InputFilter[i].Deadband)
+            InputFilter[i].Deadband = 1; // quantisation still flickers the last bit
+    }
+    LastInputFilterTime = 0;
+}
+
+/*********************************************************************************************************************************/
+// For files saved before the filter settings were added: median for everything. It passes a step after only
+// MEDIANFILTERSIZE / 2 samples, which One-Euro and the biquad can't match (test/InputFiltersTest.cpp).
+
+void DefaultInputFilters()
+{
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        InputFilterType[i] = FILTER_MEDIAN;
+        InputDeadband[i] = DEFAULTINPUTDEADBAND;
+    }
+}
+
+/*********************************************************************************************************************************/
+
+void PrimeInputFilter(uint8_t i, uint16_t RawValue)
+{
+    InputFilterState *f = &InputFilter[i];
+    for (uint8_t j = 0; j < MEDIANFILTERSIZE; ++j)
+        f->MedianHistory[j] = RawValue;
+    f->MedianIndex = 0;
+    f->BiquadZ1 = RawValue * (1.0f - BiquadB0);      // steady state for a constant input
+    f->BiquadZ2 = RawValue * (BiquadB2 - BiquadA2); //
+    f->EuroX = RawValue;
+    f->EuroDx = 0;
+    f->Output = RawValue;
+    f->Primed = true;
+}
+
+/*********************************************************************************************************************************/
+
+FASTRUN uint16_t MedianFilter(InputFilterState *f, uint16_t RawValue)
+{
+    uint16_t Sorted[MEDIANFILTERSIZE];
+    f->MedianHistory[f->MedianIndex] = RawValue;
+    if (++f->MedianIndex >= MEDIANFILTERSIZE)
+        f->MedianIndex = 0;
+    for (uint8_t j = 0; j < MEDIANFILTERSIZE; ++j) // insertion sort: only 5 values
+    {
+        uint16_t v = f->MedianHistory[j];
+        int8_t k = j - 1;
+        while (k >= 0 && Sorted[k] > v)
+        {
+            Sorted[k + 1] = Sorted[k];
+            --k;
+        }
+        Sorted[k + 1] = v;
+    }
+    return Sorted[MEDIANFILTERSIZE / 2];
+}
+
+/*********************************************************************************************************************************/
+
+FASTRUN uint16_t BiquadFilter(InputFilterState *f, uint16_t RawValue)
+{
+    float y = BiquadB0 * RawValue + f->BiquadZ1;
+    f->BiquadZ1 = BiquadB1 * RawValue - BiquadA1 * y + f->BiquadZ2;
+    f->BiquadZ2 = BiquadB2 * RawValue - BiquadA2 * y;
+    return (uint16_t)constrain(y + 0.5f, 0.0f, (float)MAXRESOLUTION);
+}
+
+/*********************************************************************************************************************************/
+// One-Euro filter: heavy smoothing when the stick is still, very little lag when it moves quickly.
+
+FASTRUN uint16_t OneEuroFilter(InputFilterState *f, uint16_t RawValue, float dt)
+{
+    float dx = (RawValue - f->EuroX) / dt;
+    f->EuroDx += EuroAlpha(ONEEURO_DCUTOFF, dt) * (dx - f->EuroDx);
+    float Cutoff = ONEEURO_MINCUTOFF + ONEEURO_BETA * fabsf(f->EuroDx);
+    f->EuroX += EuroAlpha(Cutoff, dt) * (RawValue - f->EuroX);
+    return (uint16_t)constrain(f->EuroX + 0.5f, 0.0f, (float)MAXRESOLUTION);
+}
+
+/*********************************************************************************************************************************/
+// Read each stick and knob once, filter it and apply its deadband. Results go into FilteredInput[].
+
+FASTRUN void ReadFilteredInputs()
+{
+    uint32_t RightNow = micros();
+    float dt = (RightNow - LastInputFilterTime) * 0.000001f;
+    if (!LastInputFilterTime || dt <= 0.0f || dt > 0.1f)
+        dt = FHSS_data::PaceMaker * 0.001f; // first pass, or after a long pause
+    LastInputFilterTime = RightNow;
+
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        uint16_t RawValue = AnalogueReed(i);
+        InputFilterState *f = &InputFilter[i];
+        if (!f->Primed)
+            PrimeInputFilter(i, RawValue);
+        uint16_t Value = RawValue;
+        switch (InputFilterType[i])
+        {
+        case FILTER_MEDIAN:
+            Value = MedianFilter(f, RawValue);
+            break;
+        case FILTER_BIQUAD:
+            Value = BiquadFilter(f, RawValue);
+            break;
+        case FILTER_ONEEURO:
+            Value = OneEuroFilter(f, RawValue, dt);
+            break;
+        default:
+            break;
+        }
+        if (abs(Value - f->Output) > f->Deadband) // Movement bigger than this input's (filtered) noise is real
+            f->Output = Value;
+        FilteredInput[i] = f->Output;
+    }
+}
+
+/*********************************************************************************************************************************/
+// Noise is measured while the sticks are centred (CENTRESTICKS). Mean absolute difference between successive samples
+// is robust against the slow deliberate movements made while centring knobs and switches.
+
+void StartInputNoiseMeasurement()
+{
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        NoiseSum[i] = 0;
+        NoiseCount[i] = 0;
+        NoiseLastSample[i] = AnalogueReed(i);
+    }
+}
+
+/*********************************************************************************************************************************/
+
+void MeasureInputNoise(uint8_t i, uint16_t RawValue)
+{
+    uint16_t Difference = abs(RawValue - NoiseLastSample[i]);
+    NoiseLastSample[i] = RawValue;
+    if (Difference > NOISEOUTLIER)
+        return; // that's a deliberate movement, not noise
+    NoiseSum[i] += Difference;
+    ++NoiseCount[i];
+}
+
+/*********************************************************************************************************************************/
+// Deadband ~ 3 sigma. (For gaussian noise sigma is about 0.89 x the mean absolute successive difference.)
+
+void SetDeadbandsFromNoise()
+{
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        if (NoiseCount[i] < 100)
+            continue; // too few samples to trust. Keep the old value.
+        uint32_t Deadband = ((NoiseSum[i] * 8) / (NoiseCount[i] * 3)) + 1;
+        InputDeadband[i] = CheckRange(Deadband, 1, MAXINPUTDEADBAND);
+    }
+    InitInputFilters();
+}
+
+#endif
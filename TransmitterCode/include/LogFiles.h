@@ -152,13 +152,18 @@ FASTRUN void LogRXsTotalTimes()
 }
 
 // ************************************************************************
+// Log lines are queued in LogRing and written to SD a sector at a time by ManageLogRing(), so logging a line costs a
+// memcpy instead of an open, four writes and a close. The log file stays open until the power goes off or the
+// filename changes.
+
 FASTRUN void CheckLogFileIsOpen()
 {
-    if (!LogFileOpen)
-    {
-        MakeTextFileName(); // Create a "today" filename
-        OpenLogFileW();     // Open file for writing
-    }
+    MakeTextFileName(); // Create a "today" filename
+    if (LogWriteFileOpen && (strcmp(LogWriteFileName, TextFileName) == 0))
+        return;
+    CloseLogWriter(); // Lines already queued belong to the old file
+    strcpy(LogWriteFileName, TextFileName);
+    OpenLogFileW(); // Open file for writing
 }
 
 /************************************************************************************************************/
@@ -167,6 +172,7 @@ FASTRUN void DeleteLogFile1()
     char LogTeXt1[] = "LogText";
     char BlankText[] = " ";
     CloseLogFile();
+    CloseLogWriter();
     MakeTextFileName();
     DeleteLogFile();
     SendText1(LogTeXt1, BlankText);
@@ -181,12 +187,129 @@ FASTRUN void CloseLogFile()
     LogFileOpen = false;
 }
 /************************************************************************************************************/
+// LogRingOldest is when the oldest line still in LogRing was added. Lines are marked with the time they arrived (at
+// most one mark per LOGMARKGAP ms, so a line may look a little older than it is, never younger) and marks are dropped
+// as the writes pass them.
+
+FASTRUN void MarkLogLine(uint32_t RightNow)
+{
+    if (LogRingHead == LogRingTail)
+        LogMarkCount = 0; // Empty: the next line is the oldest
+    if (LogMarkCount)
+    {
+        uint8_t Last = (LogMarkFirst + LogMarkCount - 1) % LOGMARKS;
+        if ((RightNow - LogMarkTime[Last] < LOGMARKGAP) || (LogMarkCount >= LOGMARKS))
+            return; // Counts as the last mark's time
+    }
+    else
+    {
+        LogMarkFirst = 0;
+        LogRingOldest = RightNow;
+    }
+    uint8_t Next = (LogMarkFirst + LogMarkCount) % LOGMARKS;
+    LogMarkAt[Next] = LogRingHead;
+    LogMarkTime[Next] = RightNow;
+    ++LogMarkCount;
+}
+
+/************************************************************************************************************/
+FASTRUN void DropWrittenLogMarks()
+{
+    while (LogMarkCount > 1 && (int32_t)(LogRingTail - LogMarkAt[(LogMarkFirst + 1) % LOGMARKS]) >= 0)
+    {
+        LogMarkFirst = (LogMarkFirst + 1) % LOGMARKS;
+        --LogMarkCount;
+    }
+    if (LogRingHead == LogRingTail)
+        LogMarkCount = 0;
+    if (LogMarkCount)
+        LogRingOldest = LogMarkTime[LogMarkFirst];
+}
+
+/************************************************************************************************************/
+// Adds to LogRing. (LOGRINGSIZE is a power of two, so Head and Tail just count up and are masked to find their place.)
+
 FASTRUN void WriteToLogFile(char *SomeData, uint16_t len)
 {
-    char txt[] = ".TXT";
-    if (InStrng(txt, TextFileName))
-        return; // Don't write to a HELP file
-    LogFileNumber.write(SomeData, len);
+    if (len > LOGRINGSIZE - (LogRingHead - LogRingTail))
+        FlushLogRing(true); // Full! Write it all now, as every line used to be
+    if (len > LOGRINGSIZE)
+        return;
+    MarkLogLine(millis());
+    uint32_t At = LogRingHead & (LOGRINGSIZE - 1);
+    uint32_t First = min((uint32_t)len, LOGRINGSIZE - At); // Up to the end of the ring ...
+    memcpy(LogRing + At, SomeData, First);
+    memcpy(LogRing, SomeData + First, len - First); // ... and the rest at its start
+    LogRingHead += len;
+}
+
+/************************************************************************************************************/
+// Writes from LogRing: the first write tops up the file's last sector, after that each one is a full, aligned sector.
+// All = true writes everything, including a part sector at the end, and flushes the file. Otherwise one sector at most
+// is written, and a part sector only if Partial (then the file is flushed once the ring is empty).
+
+FASTRUN void FlushLogRing(bool All, bool Partial)
+{
+    uint32_t Waiting = LogRingHead - LogRingTail;
+    if (!Waiting)
+        return;
+    if (!LogWriteFileOpen)
+    {
+        LogRingTail = LogRingHead; // Nowhere to put it
+        DropWrittenLogMarks();
+        return;
+    }
+    while (Waiting)
+    {
+        uint32_t At = LogRingTail & (LOGRINGSIZE - 1);
+        uint32_t Length = LOGWRITECHUNK - (LogWriteOffset % LOGWRITECHUNK); // Up to the next sector boundary
+        if (Length > Waiting)
+        {
+            if (!All && !Partial)
+                break;
+            Length = Waiting;
+        }
+        if (Length > LOGRINGSIZE - At)
+            Length = LOGRINGSIZE - At; // The rest comes from the start of the ring next time around
+        LogWriteFile.write((uint8_t *)LogRing + At, Length);
+        LogRingTail += Length;
+        LogWriteOffset += Length;
+        Waiting -= Length;
+        if (!All)
+            break; // One sector per call keeps each pass short
+    }
+    DropWrittenLogMarks();
+    if (All || (Partial && !Waiting))
+        LogWriteFile.flush();
+#ifdef DB_SD
+    if (All)
+    {
+        Serial.print("Log flushed to ");
+        Serial.println(LogWriteOffset);
+    }
+#endif
+}
+
+/************************************************************************************************************/
+// Called from ManageTransmitter(). A full sector is written as soon as there is one. Once the oldest line has waited
+// LOGFLUSHDELAY ms, part sectors go too - but still one sector per pass, so a backlog never stalls the loop.
+
+FASTRUN void ManageLogRing(uint32_t RightNow)
+{
+    if (LogRingHead == LogRingTail)
+        return;
+    FlushLogRing(false, RightNow - LogRingOldest >= LOGFLUSHDELAY);
+}
+
+/************************************************************************************************************/
+// Before power off, or before the log file is deleted or changed.
+
+void CloseLogWriter()
+{
+    FlushLogRing(true);
+    if (LogWriteFileOpen)
+        LogWriteFile.close();
+    LogWriteFileOpen = false;
 }
 // ************************************************************************
 /**
@@ -224,11 +347,15 @@ FASTRUN void LogText(char *TheText, uint16_t len, bool TimeStamp)
 {
     char crlf[] = {'|', 13, 10, 0};
     char Tab[] = "               - ";
+    char txt[] = ".TXT";
     static char LastText[100];
     if (!len)
         return;
     if (strcmp(TheText, LastText) == 0)
         return; // Don't log the same thing twice
+    MakeTextFileName();
+    if (InStrng(txt, TextFileName))
+        return; // Don't write to a HELP file
     CheckLogFileIsOpen();
     if (TimeStamp)
     {
@@ -241,7 +368,6 @@ FASTRUN void LogText(char *TheText, uint16_t len, bool TimeStamp)
     }
     WriteToLogFile(TheText, len);
     WriteToLogFile(crlf, strlen(crlf));
-    CloseLogFile();
     strcpy(TheText, "");
 }
 
@@ -503,6 +629,7 @@ FASTRUN void LogDisConnection()
         LogAllGPSMaxs();
     LogLongestGap();
     LogAverageGap();
+    LogSwitchLatency();
     LogAverageFrameRate();
     LogTotalLostPackets();
     // LogTotalGoodPackets(); // not very interesting
@@ -644,6 +771,18 @@ FASTRUN void LogAverageGap()
     LogText(thetext, strlen(thetext), false);
 }
 // ************************************************************************
+void LogSwitchLatency()
+{
+    char thetext[60];
+    if (!SwitchLatencyCount)
+        return;
+    snprintf(thetext, 58, "Switch to air: %.1f ms (max %.1f ms)", (SwitchLatencySum / SwitchLatencyCount) / 1000.0f, SwitchLatencyMax / 1000.0f);
+    LogText(thetext, strlen(thetext), false);
+    SwitchLatencySum = 0;
+    SwitchLatencyCount = 0;
+    SwitchLatencyMax = 0;
+}
+// ************************************************************************
 FASTRUN void LogBuddyChange()
 {
     char OnText[] = "Buddy ON";
@@ -4,10 +4,14 @@
 // It reads the log file a screenful at a time and displays it on the Nextion screen.
 // It also allows scrolling up and down the entire log file by reading only the needed bit of it and displaying it.
 // The text files it reads have CR LFs that we ignore here, and we use | as line ending marker.
-// Word wrap is done ONCE, up front, into a pre-wrapped temp file (/WRAP.TMP) when a file is
-// opened for viewing — so the display/scroll path only ever splits on '|' and line numbering
-// is identical no matter which window reads a line. (Wrapping during display made line counts
-// depend on where the read-buffer boundary fell, which corrupted the seek-position map.)
+// Word wrap is worked out ONCE, in one pass over the file, into a line index: the file offset where every
+// display line starts. So line numbering is identical no matter which window reads a line, and any window
+// is one seek and one read. The index is built a chunk at a time while the file is on screen, and saved in
+// /index/ (same name as the file) so next time it's just loaded. It's rebuilt if the file has changed, or
+// only finished off if a log has just had lines added.
+// The last few windows decoded are kept in a small cache (least recently used goes first), and while the
+// viewer is idle the windows just above and below the one on screen are read into it - so scrolling a step
+// either way is served from RAM.
 
 #include <Arduino.h>
 #include "1Definitions.h"
@@ -21,17 +25,55 @@
 #define SCROLLTRIGGER 0.75          // (EDIT THESE NUMBERS WITH GREAT CAUTION!!!!)
 #define MXLINELENGTH 110            // (EDIT THIS NUMBER WITH GREAT CAUTION!!!!) This is the number of characters that can fit on a line. It is not exact as it depends on the characters, but it's a good starting point. Too high and it will cause problems with word wrap, too low and it will cause too much scrolling.
 #define WRAPPOINT 65                // where to word-wrap
-#define MAXSEEKPOSITIONS 5000       // hope it's enough
+#define MAXINDEXLINES 10000         // Display lines indexed. Past this the oldest half is dropped, so the end of a huge log is still there
+#define LINEINDEXCHUNK 512          // Bytes indexed per pass through ManageTransmitter()
+#define LINEINDEXMAGIC 0x5844494C   // "LIDX"
+#define LINEINDEXHEADBYTES 512      // The saved index holds a CRC of this much of the file's start
+#define WINDOWCACHESIZE 6           // Decoded windows kept in RAM
+#define WINDOWTEXTSIZE (READBUFFERSIZE + MXLINES) // A window's text, each line ending with a 0
 #define FONTPOINTS 24               // 24 point font at Nextion
 #define GOING_NOWHERE 0
 #define GOING_UP 1
 #define GOING_DOWN 2
 
 char LogLines[MXLINES + 1][MXLINELENGTH + 1];
-uint32_t SeekPosition[MAXSEEKPOSITIONS];
 int16_t StartReadLine = 0;
-uint32_t ThisSeekPosition = 0;
 uint16_t FinalReadStartLine = 0xFFFF;
+uint32_t LineIndex[MAXINDEXLINES]; // File offset of the start of each display line
+uint32_t IndexedLines = 0;         // Entries in LineIndex. The last is the line still being scanned
+uint32_t IndexScanPos = 0;         // File offset scanned up to
+uint16_t IndexCol = 0;             // Printable characters so far in the line being scanned
+uint32_t IndexFileSize = 0;        // Size of the file when it was opened for viewing
+DateTimeFields IndexModified;      // ... and its modify time
+bool LineIndexComplete = false;    // Scanned to IndexFileSize
+bool LineIndexStarted = false;     //
+struct CachedWindow
+{
+    int32_t Start;                // First line, or -1 if unused
+    uint16_t Lines;               //
+    uint32_t LastUsed;            // WindowCacheClock when it was last shown or read
+    char Text[WINDOWTEXTSIZE];    //
+};
+CachedWindow WindowCache[WINDOWCACHESIZE];
+uint32_t WindowCacheClock = 0;    //
+uint32_t WindowCacheHits = 0;     // Windows shown straight from the cache
+uint32_t WindowCacheMisses = 0;   // Windows that had to be read
+uint32_t WindowFetchTime = 0;     // us to get the latest window into LogLines[]
+uint32_t ScrollTimeMax = 0;       // us from a scroll to its window being sent
+uint32_t ScrollTimeSum = 0;       //
+uint32_t ScrollCount = 0;         //
+struct LineIndexHeader             // Starts each file in /index/, followed by the offsets
+{
+    uint32_t Magic;           // LINEINDEXMAGIC
+    uint16_t WrapPoint;       // The wrap rules the index was made with
+    uint16_t LineLength;      //
+    uint32_t FileSize;        // Bytes of the file indexed
+    uint32_t HeadCrc;         // CRC32 of its first LINEINDEXHEADBYTES
+    DateTimeFields Modified;  // Its modify time
+    uint32_t Lines;           // IndexedLines
+    uint16_t Col;             // IndexCol, so that indexing can carry on if the file grows
+    uint16_t Spare;           //
+};
 int LastShownLines = 0;                             // how many lines the current window displays (set by ShowLogFileNew)
 int LogViewHeight = BUFFEREDLINES * FONTPOINTS;     // visible height of the LogText box in px. Learned exactly from the
                                                     // HMI's own report on the first scroll (content − Max_Y); this is
@@ -42,37 +84,30 @@ int LogViewHeight = BUFFEREDLINES * FONTPOINTS;     // visible height of the Log
 void TopOfLogFileNEW()
 {
     char LogTeXt_val_y[] = "LogText.val_y";
+    uint32_t Started = micros();
     StartReadLine = 0;
     ShowLogFileNew(ReadAFewLines());
+    NoteScrollTime(Started);
     SendOtherValue(LogTeXt_val_y, 0);
     Previous_Current_Y = 0;
 }
 /******************************************************************************************************************************/
 /**
  * This function scrolls to the bottom of the log file and displays the most recent log entries.
- * Fixed 2026-07-02: it used to walk the file in 10-line steps (re-reading every byte ~4 times — slow),
- * and it never reset the screen's val_y scroll offset — the old offset applied to the new (short)
- * final window left the view blank or garbled. Now: one near-window stride per read to find the end,
- * then display the final window and scroll to its true bottom (content height − visible box height).
+ * The line index knows where the final window starts, so this is one read however long the file is
+ * (once the index is complete - and a saved one usually is). It then scrolls to the true bottom of that
+ * window (content height − visible box height).
  */
 void BottomOfLogFileNEW()
 {
     char LogTeXt_val_y[] = "LogText.val_y";
-    while (FinalReadStartLine == 0xFFFF) // end of file not discovered yet — walk forward to find it
-    {
-        uint16_t L = ReadAFewLines();  // reads at StartReadLine; sets FinalReadStartLine when a
-                                       // window holds BOTH the end of the file AND all its lines
-        if (FinalReadStartLine != 0xFFFF)
-            break;
-        if (L < 2)                     // safety: cannot make progress (shouldn't happen)
-            break;
-        StartReadLine += (L - 1);      // stride almost a whole window — every line's seek position
-                                       // in this window was stored, so the next start is always valid
-    }
+    uint32_t Started = micros();
+    FinishLineIndex();
     if (FinalReadStartLine != 0xFFFF)
         StartReadLine = FinalReadStartLine; // the window that contains the end of the file
     uint16_t L = ReadAFewLines();
     ShowLogFileNew(L);
+    NoteScrollTime(Started);
     int y = (int)L * FONTPOINTS - LogViewHeight; // scroll to the BOTTOM of that window
     if (y < 0)
         y = 0;
@@ -86,6 +121,7 @@ void LogReleasedNEW()
 {
     uint8_t Direction = GOING_NOWHERE;
     char Current_Y_Nextion_Label[] = "LogText.val_y";
+    uint32_t Started = micros();
     int Current_Y = GetIntFromTextIn(4); // Get the current scroll position every time
     Max_Y = GetIntFromTextIn(8);         // Get the maximum scroll position every time (it changes per window)
 
@@ -119,7 +155,7 @@ void LogReleasedNEW()
             int next = StartReadLine + BUFFEREDLINES;
             if (FinalReadStartLine != 0xFFFF && next > (int)FinalReadStartLine)
                 next = FinalReadStartLine;
-            if (next == StartReadLine) // already showing the final window — nothing to fetch
+            if (next <= StartReadLine) // already showing the final window — nothing to fetch
             {
                 Previous_Current_Y = Current_Y;
                 return;
@@ -129,6 +165,7 @@ void LogReleasedNEW()
                 Current_Y = 0;
             StartReadLine = next;
             ShowLogFileNew(ReadAFewLines());
+            NoteScrollTime(Started);
             SendOtherValue(Current_Y_Nextion_Label, Current_Y);
             Previous_Current_Y = Current_Y;
             return;
@@ -149,6 +186,7 @@ void LogReleasedNEW()
                 StartReadLine = 0;
             Current_Y += (prev - StartReadLine) * FONTPOINTS; // exact pixels for the lines added at the top
             ShowLogFileNew(ReadAFewLines());
+            NoteScrollTime(Started);
             SendOtherValue(Current_Y_Nextion_Label, Current_Y);
             Previous_Current_Y = Current_Y;
             return;
@@ -168,6 +206,7 @@ void ShowLogFileNew(uint16_t LinesCounter)
     char b15ON[] = "vis b15,1";
     char log[] = ".LOG";
 
+    StartNextionRenderTiming("Log viewer page");
     strcpy(buf, "");
     while (TextFileName[i] > 0)
     {
@@ -202,15 +241,6 @@ void ShowLogFileNew(uint16_t LinesCounter)
     DelayWithDog(50);
 }
 
-/******************************************************************************************************************/
-// if there is still room in the array, this function stores the file pointer so scrolling up is possible
-
-void StoreThisNewSeekPosition(uint16_t ThisPosition, uint32_t ThisValue)
-{
-    if (ThisPosition < MAXSEEKPOSITIONS)
-        SeekPosition[ThisPosition] = ThisValue;
-}
-
 // ****************************************************************************************
 bool WrapNow(uint16_t ColumnIndex, uint8_t LastChar)
 {
@@ -230,200 +260,452 @@ bool WrapNow(uint16_t ColumnIndex, uint8_t LastChar)
     return false;
 }
 /******************************************************************************************************************/
-// PRE-WRAP (Malcolm's idea, 2026-07-02): word-wrapping DURING display was the
-// last source of scrolling bugs — a long line cut by a read-buffer boundary
-// wraps differently depending on which window read it, so the line-number ->
-// seek-position map disagreed between windows and scrolling wrapped files
-// sometimes jumped or garbled. Instead we now wrap ONCE, sequentially, with
-// full context, into a temporary file on the SD card where EVERY display line
-// ends with '|'. The display/scroll path then only ever splits on '|' — line
-// numbering is stable forever. Log files (short lines) pass through unchanged.
-
-char WrappedFileName[] = "/WRAP.TMP";
-bool ViewingWrappedCopy = false;
-
-bool MakeWrappedCopy()
+// Adds the start of a new display line. If the index is full the oldest half goes (and the window moves with it).
+
+void AddLineStart(uint32_t Offset)
 {
-    char in[512];
-    char out[1024];
-    uint16_t col = 0;
-    uint16_t oi = 0;
-    int n;
-
-    File src = OpenTextFileForReading(); // the real file (TextFileName, with its /help/ or /log/ path)
-    if (!src)
+    if (IndexedLines >= MAXINDEXLINES)
     {
-        LogFileOpen = false;
-        return false;
+        uint32_t Half = MAXINDEXLINES / 2;
+        memmove(LineIndex, LineIndex + Half, (IndexedLines - Half) * sizeof(LineIndex[0]));
+        IndexedLines -= Half;
+        StartReadLine = (StartReadLine > (int)Half) ? StartReadLine - Half : 0;
+        ClearWindowCache(); // Line numbers have all changed
     }
-    SD.remove(WrappedFileName);          // FILE_WRITE appends, so start from nothing (TINYCARD alias is defined in SDFiles.h, included after this file)
-    File dst = SD.open(WrappedFileName, FILE_WRITE);
-    if (!dst)
-    {
-        src.close();
-        LogFileOpen = false;
-        return false;
-    }
-    while ((n = src.read(in, sizeof(in))) > 0)
+    LineIndex[IndexedLines] = Offset;
+    ++IndexedLines;
+}
+
+/******************************************************************************************************************/
+// The word wrap rules: a line ends at '|', or after a character that WrapNow() likes, or when it's full.
+// CR/LFs and other control characters take no room.
+
+void IndexTheseBytes(const char *Bytes, int Length, uint32_t Offset)
+{
+    for (int i = 0; i < Length; ++i)
     {
-        for (int i = 0; i < n; ++i)
+        uint8_t c = Bytes[i];
+        bool LineEnds = false;
+        if (c == '|')
         {
-            char c = in[i];
-            if (c == '|')
-            {
-                out[oi++] = '|';
-                col = 0;
-            }
-            else if ((uint8_t)c >= 32) // CR/LFs dropped, exactly as the display always did
-            {
-                if (c == '"')
-                    c = '\''; // Nextion txt="..." has NO escape for an embedded double quote —
-                              // it terminates the command string and the display REJECTS the
-                              // whole update. FRONT.TXT ("STOP FLYING!") and BUDDY.TXT contain
-                              // one, which made every window past it appear frozen: scrolling
-                              // "stopped" and the Bottom button "did nothing" on exactly those
-                              // two files. Swap for an apostrophe in the display copy.
-                out[oi++] = c;
-                ++col;
-                if (WrapNow(col, (uint8_t)c) || col >= MXLINELENGTH - 2) // same wrap rules as before
-                {
-                    out[oi++] = '|';
-                    col = 0;
-                }
-            }
-            if (oi >= sizeof(out) - 4)
-            {
-                dst.write(out, oi);
-                oi = 0;
-            }
+            LineEnds = true;
+        }
+        else if (c >= 32)
+        {
+            ++IndexCol;
+            LineEnds = WrapNow(IndexCol, c) || (IndexCol >= MXLINELENGTH - 2);
+        }
+        if (LineEnds)
+        {
+            AddLineStart(Offset + i + 1);
+            IndexCol = 0;
         }
-        KickTheDog(); // big file: keep the watchdog fed while we copy
     }
-    if (oi)
-        dst.write(out, oi);
-    dst.close();
-    src.close();
-    LogFileOpen = false;
+}
+
+/******************************************************************************************************************/
+
+uint32_t LineStart(uint32_t Line) // (the line after the last one starts at the end of the file)
+{
+    if (Line < IndexedLines)
+        return LineIndex[Line];
+    return IndexScanPos;
+}
+
+/******************************************************************************************************************/
+// Lines in the file. Only meaningful once the index is complete. A last line with nothing printable isn't shown.
+
+uint32_t TotalLines()
+{
+    if (IndexCol)
+        return IndexedLines;
+    return IndexedLines - 1;
+}
+
+/******************************************************************************************************************/
+
+void MakeLineIndexName(char *IndexName)
+{
+    strcpy(IndexName, "/index/");
+    strcat(IndexName, TextFileName);
+}
+
+/******************************************************************************************************************/
+
+uint32_t FileHeadCrc(uint32_t Length)
+{
+    char Head[LINEINDEXHEADBYTES];
+    if (Length > LINEINDEXHEADBYTES)
+        Length = LINEINDEXHEADBYTES;
+    LogFileNumber.seek(0);
+    if (LogFileNumber.read(Head, Length) != (int)Length)
+        return 0;
+    return Crc32((uint8_t *)Head, Length);
+}
+
+/******************************************************************************************************************/
+
+void SaveLineIndex()
+{
+    char IndexName[60];
+    LineIndexHeader Header;
+    Header.Magic = LINEINDEXMAGIC;
+    Header.WrapPoint = WRAPPOINT;
+    Header.LineLength = MXLINELENGTH;
+    Header.FileSize = IndexScanPos;
+    Header.HeadCrc = FileHeadCrc(IndexScanPos);
+    Header.Modified = IndexModified;
+    Header.Lines = IndexedLines;
+    Header.Col = IndexCol;
+    Header.Spare = 0;
+    if (!TINYCARD.exists("/index"))
+        TINYCARD.mkdir("/index");
+    MakeLineIndexName(IndexName);
+    TINYCARD.remove(IndexName); // FILE_WRITE appends
+    File IndexFile = TINYCARD.open(IndexName, FILE_WRITE);
+    if (!IndexFile)
+        return;
+    IndexFile.write((uint8_t *)&Header, sizeof(Header));
+    IndexFile.write((uint8_t *)LineIndex, IndexedLines * sizeof(LineIndex[0]));
+    IndexFile.close();
+}
+
+/******************************************************************************************************************/
+// Uses the saved index if it was made from this file. If the file has only grown since (a log that's had lines added)
+// the index is kept and scanning carries on from where it stopped.
+
+bool LoadLineIndex()
+{
+    char IndexName[60];
+    LineIndexHeader Header;
+    MakeLineIndexName(IndexName);
+    File IndexFile = TINYCARD.open(IndexName, FILE_READ);
+    if (!IndexFile)
+        return false;
+    bool Good = (IndexFile.read((uint8_t *)&Header, sizeof(Header)) == sizeof(Header)) && (Header.Magic == LINEINDEXMAGIC) &&
+                (Header.WrapPoint == WRAPPOINT) && (Header.LineLength == MXLINELENGTH) && (Header.Lines >= 1) &&
+                (Header.Lines <= MAXINDEXLINES) && (Header.FileSize <= IndexFileSize);
+    bool Unchanged = Good && (Header.FileSize == IndexFileSize) && !memcmp(&Header.Modified, &IndexModified, sizeof(IndexModified));
+    if (Good && (Header.FileSize == IndexFileSize) && !Unchanged)
+        Good = false; // Same size but rewritten
+    if (Good)
+        Good = (IndexFile.read((uint8_t *)LineIndex, Header.Lines * sizeof(LineIndex[0])) == (int)(Header.Lines * sizeof(LineIndex[0])));
+    IndexFile.close();
+    if (Good)
+        Good = (FileHeadCrc(Header.FileSize) == Header.HeadCrc);
+    if (!Good)
+        return false;
+    IndexedLines = Header.Lines;
+    IndexScanPos = Header.FileSize;
+    IndexCol = Header.Col;
+    LineIndexComplete = Unchanged;
+#ifdef DB_SD
+    Serial.print("Line index loaded: ");
+    Serial.print(IndexedLines);
+    Serial.println(Unchanged ? " lines." : " lines, file has grown.");
+#endif
     return true;
 }
 
-// Open whichever file the viewer should actually read: the pre-wrapped copy
-// when one was made, else the original.
-File OpenViewFile()
+/******************************************************************************************************************/
+// Called when a file is opened for viewing. (LogFileNumber must be open)
+
+void StartLineIndex()
 {
-    if (ViewingWrappedCopy)
+    IndexFileSize = LogFileNumber.size();
+    LogFileNumber.getModifyTime(IndexModified);
+    if (!LoadLineIndex())
+    {
+        LineIndex[0] = 0;
+        IndexedLines = 1;
+        IndexScanPos = 0;
+        IndexCol = 0;
+        LineIndexComplete = false;
+    }
+    LineIndexStarted = true;
+    FinalReadStartLine = 0xFFFF;
+    ClearWindowCache();
+    if (IndexScanPos >= IndexFileSize)
     {
-        File f = SD.open(WrappedFileName, FILE_READ);
-        if (f)
-            LogFileOpen = true;
-        return f;
+        LineIndexComplete = true;
+        FindFinalWindow();
     }
-    return OpenTextFileForReading();
 }
 
 /******************************************************************************************************************/
-// This function reads the log file buffer and builds an array of lines.
-// It also stores the seek positions so scrolling up is possible.
-
-// Set when a buffer held MORE lines than the window can show (MXLINES). Vital
-// distinction: reaching end-of-FILE in the buffer is NOT the final window if
-// the window itself overflowed — lines beyond the cap still need windows of
-// their own. Ignoring this made short-line files (e.g. the front-screen help,
-// >40 wrapped lines in under one read buffer) truncate at 40 lines with the
-// tail unreachable — the "can't scroll to the end on SOME help files" bug.
-bool WindowOverflowed = false;
-
-uint16_t BuildLinesArray(char *ReadBuffer, uint16_t BytesRead, uint32_t StartSeekPosition)
+
+void IndexNextChunk()
 {
-    uint16_t LinesCounter = 0;
-    uint32_t BufferIndex = 0;
-    uint16_t ColumnIndex = 0;
+    char Chunk[LINEINDEXCHUNK];
+    if (!LogFileOpen)
+        LogFileNumber = OpenTextFileForReading();
+    uint32_t Length = IndexFileSize - IndexScanPos; // (a log may be growing - stop where it was when opened)
+    if (Length > LINEINDEXCHUNK)
+        Length = LINEINDEXCHUNK;
+    int GotBytes = 0;
+    if (LogFileNumber && Length)
+    {
+        LogFileNumber.seek(IndexScanPos);
+        GotBytes = LogFileNumber.read(Chunk, Length);
+    }
+    if (GotBytes > 0)
+    {
+        IndexTheseBytes(Chunk, GotBytes, IndexScanPos);
+        IndexScanPos += GotBytes;
+    }
+    if ((GotBytes <= 0) || (IndexScanPos >= IndexFileSize))
+    {
+        IndexFileSize = IndexScanPos;
+        LineIndexComplete = true;
+        SaveLineIndex();
+        FindFinalWindow();
+    }
+}
 
-    WindowOverflowed = false;
-    for (int i = 0; i < MXLINES; ++i)
-        for (int j = 0; j < MXLINELENGTH; ++j)
-            LogLines[i][j] = 0;
-    StoreThisNewSeekPosition((LinesCounter + StartReadLine), StartSeekPosition);
-    while (BufferIndex < BytesRead)
+/******************************************************************************************************************/
+// Called from ManageTransmitter(): indexes a chunk at a time while a file is on screen.
+
+void ManageLineIndex()
+{
+    if ((CurrentView != LOGVIEW) || !LineIndexStarted)
+        return;
+    if (PrefetchWindows())
+        return;
+    if (!LineIndexComplete)
+        IndexNextChunk();
+}
+
+/******************************************************************************************************************/
+
+void IndexAtLeast(uint32_t Lines) // Indexes now, as far as a window about to be shown needs
+{
+    while (LineIndexStarted && !LineIndexComplete && (IndexedLines <= Lines))
     {
-        while (BufferIndex < BytesRead && ReadBuffer[BufferIndex] == '|') // skip the | and zero the column
-        {
-            ++BufferIndex;
-            ColumnIndex = 0;
-            if (LinesCounter < MXLINES - 1)
-            {
-                ++LinesCounter;
-                StoreThisNewSeekPosition(LinesCounter + StartReadLine, StartSeekPosition + BufferIndex);
-            }
-            else
-            {
-                // Window full. STOP consuming — the old code kept going and
-                // mangled the last row with the rest of the buffer. All
-                // MXLINES lines are complete and intact; the remainder gets
-                // its own window(s) when the user scrolls on.
-                WindowOverflowed = true;
-                return MXLINES;
-            }
-        }
-        if (BufferIndex < BytesRead && ReadBuffer[BufferIndex] >= 32)
+        IndexNextChunk();
+        KickTheDog();
+    }
+}
+
+/******************************************************************************************************************/
+
+void FinishLineIndex()
+{
+    while (LineIndexStarted && !LineIndexComplete)
+    {
+        IndexNextChunk();
+        KickTheDog();
+    }
+}
+
+/******************************************************************************************************************/
+// A window is up to MXLINES lines, and no more than READBUFFERSIZE bytes of the file (which keeps it within
+// ShowLogFileNew()'s buffer). It always has at least one line.
+
+uint16_t WindowLines(uint32_t Start)
+{
+    uint32_t Available = LineIndexComplete ? TotalLines() : IndexedLines - 1; // (lines known to be whole)
+    uint16_t Lines = 0;
+    while ((Lines < MXLINES) && (Start + Lines < Available))
+    {
+        if (Lines && (LineStart(Start + Lines + 1) - LineStart(Start) > READBUFFERSIZE))
+            break;
+        ++Lines;
+    }
+    return Lines;
+}
+
+/******************************************************************************************************************/
+// The final window is the biggest one that ends at the end of the file. Worked backwards from the end: no reading.
+
+void FindFinalWindow()
+{
+    uint32_t Total = TotalLines();
+    uint32_t Start = Total;
+    uint16_t Lines = 0;
+    while (Start && (Lines < MXLINES))
+    {
+        if (Lines && (LineStart(Total) - LineStart(Start - 1) > READBUFFERSIZE))
+            break;
+        --Start;
+        ++Lines;
+    }
+    FinalReadStartLine = Start;
+}
+
+/******************************************************************************************************************************/
+// Reads the window that starts at Start into Window->Text with one seek and one read.
+
+void DecodeWindow(uint32_t Start, uint16_t Lines, CachedWindow *Window)
+{
+    char ReadBuffer[READBUFFERSIZE + 50]; // a bit of extra just in case
+    uint32_t First = LineStart(Start);
+    uint32_t Length = LineStart(Start + Lines) - First;
+    if (Length > READBUFFERSIZE)
+        Length = READBUFFERSIZE; // (only a single, very odd, line can be this long)
+    if (!LogFileOpen)
+        LogFileNumber = OpenTextFileForReading();
+    LogFileNumber.seek(First);
+    int GotBytes = LogFileNumber.read(ReadBuffer, Length);
+    if (GotBytes < 0)
+        GotBytes = 0; // a failed read returns -1
+    uint16_t Out = 0;
+    for (uint16_t Line = 0; Line < Lines; ++Line)
+    {
+        uint32_t From = LineStart(Start + Line) - First;
+        uint32_t To = LineStart(Start + Line + 1) - First;
+        if (To > (uint32_t)GotBytes)
+            To = GotBytes;
+        uint16_t Column = 0;
+        for (uint32_t i = From; i < To; ++i)
         {
-            // No word-wrap decisions here any more: the file we're reading is
-            // PRE-WRAPPED (every display line already ends with '|'), which is
-            // what makes line numbering stable across windows. The only guard
-            // left is the hard row limit, in case of a corrupt/foreign file.
-            if (ColumnIndex < MXLINELENGTH - 1)
-            {
-                LogLines[LinesCounter][ColumnIndex] = ReadBuffer[BufferIndex]; // get one character
-                ++ColumnIndex;
-                LogLines[LinesCounter][ColumnIndex] = 0;
-            }
+            char c = ReadBuffer[i];
+            if ((c == '|') || ((uint8_t)c < 32) || (Column >= MXLINELENGTH - 1))
+                continue;
+            if (c == '"')
+                c = '\''; // Nextion txt="..." has NO escape for an embedded double quote —
+                          // it terminates the command string and the display REJECTS the
+                          // whole update. FRONT.TXT ("STOP FLYING!") and BUDDY.TXT contain
+                          // one. Swap for an apostrophe on screen.
+            Window->Text[Out++] = c;
+            ++Column;
         }
-        ++BufferIndex;
+        Window->Text[Out++] = 0; // (a window never has more text than bytes read, plus one 0 per line)
     }
-    if (LogLines[LinesCounter][0]) // count the in-progress final line so the file's true last line displays
-        ++LinesCounter;
-    return LinesCounter;
+    Window->Start = Start;
+    Window->Lines = Lines;
+    Window->LastUsed = ++WindowCacheClock;
 }
+
 /******************************************************************************************************************************/
 
-uint16_t ReadAFewLines()
+void ClearWindowCache()
 {
-    char ReadBuffer[READBUFFERSIZE + 50]; // a bit of extra just in case
+    for (uint8_t i = 0; i < WINDOWCACHESIZE; ++i)
+        WindowCache[i].Start = -1;
+}
 
-    if (!StartReadLine)
+/******************************************************************************************************************************/
+// A cached window is only good if it still has the lines the index says it should (it may have been read while
+// the index was still being built).
+
+CachedWindow *FindCachedWindow(uint32_t Start, uint16_t Lines)
+{
+    for (uint8_t i = 0; i < WINDOWCACHESIZE; ++i)
     {
-        ThisSeekPosition = 0; // if at top of file
+        if ((WindowCache[i].Start == (int32_t)Start) && (WindowCache[i].Lines == Lines))
+            return &WindowCache[i];
     }
-    else
+    return nullptr;
+}
+
+/******************************************************************************************************************************/
+
+CachedWindow *LeastRecentlyUsedWindow()
+{
+    CachedWindow *Oldest = &WindowCache[0];
+    for (uint8_t i = 1; i < WINDOWCACHESIZE; ++i)
     {
-        ThisSeekPosition = SeekPosition[StartReadLine]; // else get the seek position
+        if (WindowCache[i].Start < 0)
+            return &WindowCache[i];
+        if (WindowCache[i].LastUsed < Oldest->LastUsed)
+            Oldest = &WindowCache[i];
     }
-    if (!LogFileOpen)
+    return Oldest;
+}
+
+/******************************************************************************************************************************/
+// Reads one of the windows a scroll step above or below the one on screen, if it isn't cached and its lines are
+// indexed already. Returns true if it read one.
+
+bool PrefetchWindows()
+{
+    int32_t Neighbours[2];
+    Neighbours[0] = StartReadLine + BUFFEREDLINES; // below first: scrolling down is more usual
+    if ((FinalReadStartLine != 0xFFFF) && (Neighbours[0] > FinalReadStartLine))
+        Neighbours[0] = FinalReadStartLine;
+    Neighbours[1] = StartReadLine - BUFFEREDLINES;
+    if (Neighbours[1] < 0)
+        Neighbours[1] = 0;
+    for (uint8_t i = 0; i < 2; ++i)
     {
-        LogFileNumber = OpenViewFile(); // if not open, open it (the pre-wrapped copy when one exists)
+        uint32_t Start = Neighbours[i];
+        if (Start == (uint32_t)StartReadLine)
+            continue;
+        if (!LineIndexComplete && (Start + MXLINES + 1 >= IndexedLines))
+            continue; // Not indexed that far yet
+        uint16_t Lines = WindowLines(Start);
+        if (!Lines || FindCachedWindow(Start, Lines))
+            continue;
+        DecodeWindow(Start, Lines, LeastRecentlyUsedWindow());
+        return true;
     }
-    LogFileNumber.seek(ThisSeekPosition);                     // seek to the position
-    int GotBytes = LogFileNumber.read(ReadBuffer, READBUFFERSIZE); // read in the buffer
-    if (GotBytes < 0)
-        GotBytes = 0; // a failed read returns -1; as a uint16_t that became 65535 "bytes" of stack garbage
-    uint16_t BytesRead = (uint16_t)GotBytes;
+    return false;
+}
+
+/******************************************************************************************************************************/
+// Puts the window that starts at StartReadLine into LogLines[], from the cache when it's there.
 
-    if (BytesRead < READBUFFERSIZE) // if we read less than the buffer size, we are at the end of the file
+uint16_t ReadAFewLines()
+{
+    uint32_t Started = micros();
+    IndexAtLeast(StartReadLine + MXLINES + 1);
+    uint16_t Lines = WindowLines(StartReadLine);
+    for (int i = 0; i < MXLINES; ++i)
+        LogLines[i][0] = 0;
+    if (!Lines)
+        return 0;
+    CachedWindow *Window = FindCachedWindow(StartReadLine, Lines);
+    if (Window)
     {
-        CloseLogFile(); // (re-opened on demand by the next read)
+        ++WindowCacheHits;
+        Window->LastUsed = ++WindowCacheClock;
     }
-    ReadBuffer[BytesRead] = 0; // null-terminate AFTER the data. Terminating at [BytesRead - 1] chopped the
-                               // file's final byte — usually the last '|' — which made the last log line
-                               // vanish; and with a 0-byte read it wrote one byte BEFORE the buffer.
-    uint16_t Lines = BuildLinesArray(ReadBuffer, BytesRead, ThisSeekPosition);
-    // This window is the FINAL one only if the buffer held the end of the file
-    // AND every line of the buffer fitted into the window. An overflowed window
-    // still has lines beyond its cap — declaring it final made those lines
-    // unreachable (the front-screen-help "can't scroll to the end" bug).
-    if (BytesRead < READBUFFERSIZE && !WindowOverflowed)
-        FinalReadStartLine = StartReadLine;
+    else
+    {
+        ++WindowCacheMisses;
+        Window = LeastRecentlyUsedWindow();
+        DecodeWindow(StartReadLine, Lines, Window);
+    }
+    const char *Text = Window->Text;
+    for (uint16_t Line = 0; Line < Lines; ++Line)
+    {
+        strcpy(LogLines[Line], Text);
+        Text += strlen(Text) + 1;
+    }
+    WindowFetchTime = micros() - Started;
     return Lines;
 }
+
+/******************************************************************************************************************************/
+// Called once a scroll's window has been sent to the screen.
+
+void NoteScrollTime(uint32_t Started)
+{
+    uint32_t ScrollTime = micros() - Started;
+    if (ScrollTime > ScrollTimeMax)
+        ScrollTimeMax = ScrollTime;
+    ScrollTimeSum += ScrollTime;
+    ++ScrollCount;
+#ifdef DB_LOGVIEWCACHE
+    if (!(WindowCacheHits + WindowCacheMisses))
+        return;
+    Look1("Window cache hits: ");
+    Look1(WindowCacheHits);
+    Look1(" misses: ");
+    Look1(WindowCacheMisses);
+    Look1(" (");
+    Look1((WindowCacheHits * 100) / (WindowCacheHits + WindowCacheMisses));
+    Look1("%)  fetch: ");
+    Look1(WindowFetchTime);
+    Look1(" us  scroll: ");
+    Look1(ScrollTime);
+    Look1(" us (average ");
+    Look1(ScrollTimeSum / ScrollCount);
+    Look1(" max ");
+    Look1(ScrollTimeMax);
+    Look(" us)");
+#endif
+}
 /******************************************************************************************************************************/
 
 void StartLogFileView() // This is the entry point
@@ -446,15 +728,13 @@ void LogVIEWNew() // Start log screen
     ClearFilesList();
     MakeTextFileName();
     CloseLogFile();
-    for (uint16_t i = 0; i < MAXSEEKPOSITIONS; ++i)
-        SeekPosition[i] = 0; // clear all seekpositions
     StartReadLine = 0;
-    ViewingWrappedCopy = MakeWrappedCopy(); // pre-wrap into /WRAP.TMP — display then only splits on '|'
-    if (ViewingWrappedCopy)
-        LogFileNumber = OpenViewFile();
-    if (ViewingWrappedCopy && LogFileNumber)
+    LineIndexStarted = false;
+    LogFileNumber = OpenTextFileForReading();
+    if (LogFileNumber)
     {
-        ShowLogFileNew(ReadAFewLines()); // builds the lines array and uses it to display the log file
+        StartLineIndex();                // loads the saved index, or starts a new one
+        ShowLogFileNew(ReadAFewLines()); // indexes only as far as the first window needs
     }
     else
     {
@@ -464,7 +744,6 @@ void LogVIEWNew() // Start log screen
         strcat(fbuffer, TextFileName);
         SendText(LogText, fbuffer);
     }
-    CloseLogFile();
     SendOtherValue(Current_Y_Nextion_Label, 0);
     Previous_Current_Y = 0; // fresh file starts at the top — stale value here made the
                             // first scroll gesture's direction detection wrong
@@ -9,7 +9,7 @@
 
 void ClearFilesList()
 {
-    for (int i = 0; i < 99; i++)
+    for (int i = 0; i < FILESLISTSIZE; i++)
     {
         strcpy(TheFilesList[i], "");
     }
@@ -27,7 +27,6 @@ void StartLogFilesListScreen()
     char b15off[] = "vis b15,0";
     char b1off[] = "vis b1,0";
     char t0[] = "t0";
-    char LogfilesTitle[] = "All log files";
     char HelpFilesTitle[] = "All help files";
 
     if (LedWasGreen)
@@ -49,7 +48,7 @@ void StartLogFilesListScreen()
     else
     {
         strcpy(MOD, ".LOG"); // Set the file extension to .LOG
-        SendText(t0, LogfilesTitle);
+        SendText(t0, (char *)LogSortTitle());
     }
     BuildDirectory();           // Build the directory
     strcpy(Mfiles, "FilesBox"); // Set the file box name
@@ -81,7 +80,7 @@ char *AddSizeToFilename(int ff, char *size)
     strcpy(ThisFile, TheFilesList[ff]);
     while (strlen(TheFilesList[ff]) < 12)
         strcat(TheFilesList[ff], " ");
-    float s = (float)GetFileSize(ThisFile) / (float)1024.00;
+    float s = (float)TheFilesSizes[ff] / (float)1024.00; // (from the directory cache - no need to open the file)
     dtostrf(s, 2, 2, nb);
     while ((strlen(size) + strlen(nb)) < 7)
         strcat(size, " ");
@@ -111,7 +110,7 @@ void LoadFileSelector()
     char crlf[] = {13, 10, 0};
     char buf[MAXBUFFERSIZE];
     char nofiles[] = "(No files)";
-    char SizeBuf[20];
+    char SizeBuf[48];
 
     strcpy(Mfilesp, Mfiles);
     strcat(Mfilesp, ".path=\"");
@@ -121,6 +120,10 @@ void LoadFileSelector()
         strcpy(SizeBuf, "");
         if (strcmp(MOD, ".MOD"))
             AddSizeToFilename(f, SizeBuf);
+        if (!strcmp(MOD, ".LOG"))
+            AddFlightsToFilename(f, SizeBuf); // (from flights.dat - no need to read the log)
+        if (strlen(buf) + strlen(TheFilesList[f]) + strlen(SizeBuf) + 3 > sizeof(buf))
+            break;
         if (!f)
             strcpy(buf, TheFilesList[f]);
         else
@@ -764,11 +764,9 @@ void LoadModelSelector()
     char buf[MAXBUFFERSIZE];
     char mn[] = "modelname";
 
-    int32_t SavedModelNumber = ModelNumber;
-    for (ModelNumber = 1; ModelNumber < MAXMODELNUMBER; ++ModelNumber)
+    for (uint32_t Slot = 1; Slot < MAXMODELNUMBER; ++Slot) // Names and IDs all come from the catalog
     {
-        ReadOneModel(ModelNumber);
-        if (!ModelsMacUnionSaved.Val64)
+        if (!ModelCatalog[Slot].Defined || !ModelCatalog[Slot].ID)
         {
             strcpy(lb, " [");
             strcpy(rb, "]");
@@ -778,28 +776,26 @@ void LoadModelSelector()
             strcpy(lb, " (");
             strcpy(rb, ")");
         }
-        if (ModelNumber == 1)
+        if (Slot == 1)
         {
-            strcpy(buf, ModelName);
+            strcpy(buf, ModelCatalog[Slot].Name);
             strcat(buf, lb);
-            Str(nb, ModelNumber, 0);
+            Str(nb, Slot, 0);
             strcat(buf, nb);
             strcat(buf, rb);
             strcat(buf, crlf);
         }
         else
         {
-            strcat(buf, ModelName);
+            strcat(buf, ModelCatalog[Slot].Name);
             strcat(buf, lb);
-            Str(nb, ModelNumber, 0);
+            Str(nb, Slot, 0);
             strcat(buf, nb);
             strcat(buf, rb);
             strcat(buf, crlf);
         }
     }
     SendOtherText(MMemsp, buf);
-    ModelNumber = SavedModelNumber;
-    ReadOneModel(ModelNumber);
     SendValue(MMems, ModelNumber - 1);
     SendText(mn, ModelName);
 }
@@ -854,6 +850,7 @@ void OptionView3End() //
     if (MinimumGap < 10)
         MinimumGap = 10;
     UseLog = GetValue(sw0);
+    StartBlackbox(); // (if logging has just been turned on)
     LogRXSwaps = GetValue(sw1);
     SaveTransmitterParameters();
     CloseModelsFile();
@@ -0,0 +1,207 @@
+// *************************************** ModelCatalog.h *****************************************
+
+// A small index of every model slot in models.dat: whether it's in use, its name, its ID and when it was last saved.
+// It lives in RAM and in "models.cat" beside models.dat. SaveOneModel() keeps it up to date.
+// Auto model select, the models list and the duplicate ID check all look here instead of reading every model from SD.
+// If models.cat is missing or doesn't fit models.dat (eg models.dat was replaced on a PC) it is rebuilt from models.dat.
+// To tell, the header keeps models.dat's size and its generation: a count that WriteModelsFileDirect() increases on every
+// write, kept in the last 8 bytes of the TX block. A slot found to hold a different ID than the catalog says also causes one
+// rebuild, in case models.dat was changed by something (eg older firmware) that doesn't count.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef MODEL_CATALOG_H
+#define MODEL_CATALOG_H
+
+/*********************************************************************************************************************************/
+uint32_t ModelsFileSize()
+{
+    if (!ModelsFileOpen)
+        OpenModelsFile();
+    if (!ModelsFileOpen)
+        return 0;
+    return ModelsFileNumber.size();
+}
+
+/*********************************************************************************************************************************/
+// Read from the file itself, as the model store's copy of the TX block isn't kept up to date. 0 if it was never written.
+
+uint32_t ReadModelsGeneration()
+{
+    uint32_t Generation[2] = {0, 0};
+    if (SingleModelFlag || !ModelsFileOpen || !ModelsFileNumber.seek(MODELSGENERATIONADDRESS))
+        return 0;
+    if (ModelsFileNumber.read((uint8_t *)Generation, sizeof(Generation)) != sizeof(Generation) || Generation[0] != MODELSGENERATIONMAGIC)
+        return 0;
+    return Generation[1];
+}
+
+/*********************************************************************************************************************************/
+void WriteModelsGeneration(uint32_t Generation)
+{
+    uint32_t Marked[2] = {MODELSGENERATIONMAGIC, Generation};
+    if (SingleModelFlag || !ModelsFileOpen || ModelsFileNumber.size() < TXSIZE)
+        return;
+    ModelsFileNumber.seek(MODELSGENERATIONADDRESS);
+    ModelsFileNumber.write((uint8_t *)Marked, sizeof(Marked));
+}
+
+/*********************************************************************************************************************************/
+void SaveModelCatalog()
+{
+    File CatalogFile = TINYCARD.open(MODELCATALOGFILE, FILE_WRITE);
+    if (!CatalogFile)
+        return;
+    CatalogFile.seek(0);
+    CatalogFile.write((uint8_t *)&ModelCatalogHeader, sizeof(ModelCatalogHeader));
+    CatalogFile.write((uint8_t *)ModelCatalog, sizeof(ModelCatalog));
+    CatalogFile.close();
+}
+
+/*********************************************************************************************************************************/
+// Reads just the start of each slot - far enough to reach its ID - one block per model.
+
+void RebuildModelCatalog()
+{
+    if (SingleModelFlag)
+        return;
+    if (!ModelsFileOpen)
+        OpenModelsFile();
+    if (!ModelsFileOpen)
+        return;
+    memset(ModelCatalog, 0, sizeof(ModelCatalog));
+    for (uint32_t Slot = 1; Slot < MAXMODELNUMBER; ++Slot)
+    {
+        int Start = TXSIZE + ((Slot - 1) * MODELSIZE);
+        ModelCatalogEntry *Entry = &ModelCatalog[Slot];
+        LoadSDBlock(Start, MODELIDOFFSET + 8);
+        Entry->Defined = (SDBlock[0] == 42);
+        if (Entry->Defined)
+        {
+            memcpy(Entry->Name, SDBlock + 1, 30);
+            Entry->Name[30] = 0;
+            memcpy(&Entry->ID, SDBlock + MODELIDOFFSET, 8);
+        }
+        else
+        {
+            strcpy(Entry->Name, "Not in use");
+        }
+        ForgetSDBlock();
+        KickTheDog();
+    }
+    ModelCatalogHeader.Magic = MODELCATALOGMAGIC;
+    ModelCatalogHeader.Slots = MAXMODELNUMBER;
+    ModelCatalogHeader.ModelsSize = ModelsFileSize();
+    ModelCatalogHeader.ModelsGeneration = ReadModelsGeneration();
+    SaveModelCatalog();
+#ifdef DB_SD
+    Serial.println("Model catalog rebuilt.");
+#endif
+}
+
+/*********************************************************************************************************************************/
+// True if models.cat could be read and was made from models.dat as it is now.
+
+bool ReadModelCatalog()
+{
+    bool Good = false;
+    File CatalogFile = TINYCARD.open(MODELCATALOGFILE, FILE_READ);
+    if (CatalogFile)
+    {
+        Good = (CatalogFile.read((uint8_t *)&ModelCatalogHeader, sizeof(ModelCatalogHeader)) == sizeof(ModelCatalogHeader)) &&
+               (ModelCatalogHeader.Magic == MODELCATALOGMAGIC) && (ModelCatalogHeader.Slots == MAXMODELNUMBER) &&
+               (CatalogFile.read((uint8_t *)ModelCatalog, sizeof(ModelCatalog)) == sizeof(ModelCatalog));
+        CatalogFile.close();
+    }
+    if (Good)
+        Good = (ModelCatalogHeader.ModelsSize == ModelsFileSize()) && (ModelCatalogHeader.ModelsGeneration == ReadModelsGeneration());
+    return Good;
+}
+
+/*********************************************************************************************************************************/
+// Called at boot. Uses models.cat if it matches models.dat's size and generation, otherwise rebuilds it.
+
+void LoadModelCatalog()
+{
+    if (!ReadModelCatalog())
+        RebuildModelCatalog();
+    ModelCatalogLoaded = true;
+}
+
+/*********************************************************************************************************************************/
+// SaveOneModel() calls this with the model it has just written.
+
+void NoteModelInCatalog(uint32_t Slot)
+{
+    if (SingleModelFlag || !ModelCatalogLoaded || (Slot < 1) || (Slot >= MAXMODELNUMBER))
+        return; // (models migrated at boot are saved before the catalog is loaded)
+    ModelCatalogEntry *Entry = &ModelCatalog[Slot];
+    Entry->Defined = true;
+    strncpy(Entry->Name, ModelName, 30);
+    Entry->Name[30] = 0;
+    Entry->ID = ModelsMacUnionSaved.Val64;
+    Entry->Modified = RTC.get();
+    if (!ModelStoreInUse())
+        SaveCatalogEntry(Slot); // Otherwise FlushModelStore() does it when the model reaches SD
+}
+
+/*********************************************************************************************************************************/
+// Writes one entry (and the header) to models.cat. models.dat must be open, as its size and generation go in the header.
+
+void SaveCatalogEntry(uint32_t Slot)
+{
+    ModelCatalogEntry *Entry = &ModelCatalog[Slot];
+    ModelCatalogHeader.Magic = MODELCATALOGMAGIC;
+    ModelCatalogHeader.Slots = MAXMODELNUMBER;
+    ModelCatalogHeader.ModelsSize = ModelsFileNumber.size();
+    ModelCatalogHeader.ModelsGeneration = ReadModelsGeneration();
+
+    File CatalogFile = TINYCARD.open(MODELCATALOGFILE, FILE_WRITE);
+    if (!CatalogFile)
+        return;
+    CatalogFile.seek(0);
+    CatalogFile.write((uint8_t *)&ModelCatalogHeader, sizeof(ModelCatalogHeader));
+    CatalogFile.seek(sizeof(ModelCatalogHeader) + (Slot * sizeof(ModelCatalogEntry)));
+    CatalogFile.write((uint8_t *)Entry, sizeof(ModelCatalogEntry));
+    CatalogFile.close();
+}
+
+/*********************************************************************************************************************************/
+// Returns the slot whose saved ID is ModelID, or 0 if there's none.
+
+uint32_t FindModelInCatalog(uint64_t ModelID)
+{
+    if (!ModelID)
+        return 0;
+    for (uint32_t Slot = 1; Slot < MAXMODELNUMBER; ++Slot)
+    {
+        if (ModelCatalog[Slot].Defined && (ModelCatalog[Slot].ID == ModelID))
+            return Slot;
+    }
+    return 0;
+}
+
+/*********************************************************************************************************************************/
+// Loads the model with this ID. A model that isn't in the catalog just isn't there (LoadModelCatalog() has already caught a
+// stale models.cat), so only a slot that turns out to hold another ID causes a rebuild and one more try.
+
+bool LoadModelByID(uint64_t ModelID)
+{
+    if (!ModelID)
+        return false;
+    for (uint8_t Tries = 0; Tries < 2; ++Tries)
+    {
+        uint32_t Slot = FindModelInCatalog(ModelID);
+        if (!Slot)
+            return false;
+        ModelNumber = Slot;
+        ReadOneModel(ModelNumber);
+        if (ModelsMacUnionSaved.Val64 == ModelID)
+            return true;
+        RebuildModelCatalog();
+    }
+    return false;
+}
+
+#endif
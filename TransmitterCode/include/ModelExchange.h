@@ -99,9 +99,18 @@ void SendModelFile()
     Serial.println(SingleModelFile);
 #endif
     TXPipe = FILEPIPEADDRESS;
-    AddPath(SingleModelFile);
-    ModelsFileNumber = SD.open(SearchFile, O_READ); // Open file for reading
-    Fsize = ModelsFileNumber.size();                     // Get file size
+    int16_t StoredBackup = FindBackup(SingleModelFile);
+    bool FromBackupStore = (StoredBackup >= 0) && ReadBackupImage(StoredBackup, BackupImage); // Sent from RAM
+    if (FromBackupStore)
+    {
+        Fsize = BackupIndex[StoredBackup].Length;
+    }
+    else
+    {
+        AddPath(SingleModelFile);
+        ModelsFileNumber = SD.open(SearchFile, O_READ); // Open file for reading
+        Fsize = ModelsFileNumber.size();                     // Get file size
+    }
 #ifdef DB_MODEL_EXCHANGE
     Serial.print("File Size: ");
     Serial.print(Fsize);
@@ -144,9 +153,16 @@ void SendModelFile()
         }
         else
         {
-            ModelsFileNumber.seek(Fposition); // Move filepointer
-            ShortDelay();
-            ModelsFileNumber.read(Fbuffer, BUFFERSIZE); // Read part of file
+            if (FromBackupStore)
+            {
+                memcpy(Fbuffer, BackupImage + Fposition, min((unsigned long)BUFFERSIZE, Fsize - Fposition));
+            }
+            else
+            {
+                ModelsFileNumber.seek(Fposition); // Move filepointer
+                ShortDelay();
+                ModelsFileNumber.read(Fbuffer, BUFFERSIZE); // Read part of file
+            }
             Fposition += BUFFERSIZE;
             if (Fposition > Fsize)
                 Fposition = Fsize;
@@ -160,7 +176,8 @@ void SendModelFile()
         Serial.println(PacketNumber);
 #endif
     }
-    ModelsFileNumber.close();
+    if (!FromBackupStore)
+        ModelsFileNumber.close();
 #ifdef DB_MODEL_EXCHANGE
     Serial.println("ALL SENT.");
 #endif
@@ -15,7 +15,7 @@ void CompareModelsIDs()
     This function prevents flying (and most likely, crashing) a model while a wrong model memory is accidentally still loaded.
     The saved MAC address of the model's Teensy 4.0 is compared with the one just received from the model - during binding.
     If the two match, the match is announced and the 'ModelMatched' flag is set to true.
-    If it doesn't match, then all the locally stored models are rapidly searched in the hope of finding the one that does match.
+    If it doesn't match, then the catalog of locally stored models is searched in the hope of finding the one that does match.
     If a match is found, that model memory is loaded and the model's name is displayed. The find is also announced.
     If no match is found, the previously loaded model is used and a 'Model not found' warning message is announced.
     (This is needed for new models that have not had their IDs saved yet.)
@@ -48,16 +48,7 @@ void CompareModelsIDs()
 
     if (!MACS_MATCHED)
     {
-        for (ModelNumber = 1; ModelNumber < MAXMODELNUMBER; ++ModelNumber) //  Try to match the ID with a saved one
-        {
-            ModelMatched = false; //  Reset the flag
-            ReadOneModel(ModelNumber);
-            if (MACS_MATCHED) //  Is it a match for any of the saved models?
-            {
-                ModelMatched = true; //  Found it!
-                break;               //  No need to search further
-            }
-        }
+        ModelMatched = LoadModelByID(ModelsMacUnion.Val64); //  Try to match the ID with a saved one (the catalog knows them all)
         if (ModelMatched)
         {                                 //  Found it!
             UpdateModelsNameEveryWhere(); //  Use it everywhere.
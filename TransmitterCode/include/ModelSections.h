@@ -0,0 +1,160 @@
+// *************************************** ModelSections.h *****************************************
+
+// Each model in models.dat is divided into sections. SaveOneModel() records where each one starts and how long it is, and
+// puts a small directory near the end of the slot: one entry per section with its ID, version, offset, length and CRC32.
+// ReadOneModel() checks every CRC32 before believing anything, then reads each section from the offset the directory gives.
+// So a new section can go wherever there's room, without moving anything that's already there, and an older file that
+// lacks it is simply read without it (use "if (SeekModelSection(ID))" and set defaults otherwise).
+// When a section's content changes, bump its version here and let the reader look at ModelSectionVersion().
+// Files written before this have no directory. They are read just as before, checked with the old additive checksum,
+// and rewritten with a directory by MigrateOldModels() at boot. So is a model whose directory doesn't match it (older
+// firmware re-saves a model without touching the directory): the old checksum decides whether the model itself is good.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef MODEL_SECTIONS_H
+#define MODEL_SECTIONS_H
+
+/*********************************************************************************************************************************/
+// The sections, in the order SaveOneModel() writes them, and the current version of each.
+
+const ModelSectionKind ModelSectionKinds[] = {
+    {MSEC_IDENTITY, 1},    // In-use flag and name
+    {MSEC_CURVES, 1},      // Five point curves
+    {MSEC_MIXES, 1},       // Mixes
+    {MSEC_TRIMS, 1},       // Trims and servo speeds
+    {MSEC_SETTINGS, 1},    // RX cells ... arming channel
+    {MSEC_CHANNELS, 1},    // Failsafes and channel names
+    {MSEC_EXPO, 1},        // Expo and curve types
+    {MSEC_MACROS, 1},      // Macros
+    {MSEC_MODELID, 1},     // Model's ID (see MODELIDOFFSET)
+    {MSEC_OUTPUTS, 1},     // Motor, rates, timer, output channels, servo types
+    {MSEC_ROTORFLIGHT, 1}, // Rotorflight PIDs, rates, governor and the model's image
+    {MSEC_BANKS, 1}};      // Bank crossfade and downward servo speeds
+
+/*********************************************************************************************************************************/
+uint8_t ModelSectionVersion(uint8_t ID) // As found in the file just read (0 if it isn't there)
+{
+    if (!ModelDirectoryFound)
+        return 1; // Older files hold the first version of everything
+    for (uint8_t i = 0; i < ModelDirectory.Count; ++i)
+    {
+        if (ModelSections[i].ID == ID)
+            return ModelSections[i].Version;
+    }
+    return 0;
+}
+
+/*********************************************************************************************************************************/
+void StartModelDirectory()
+{
+    ModelDirectory.Magic = MODELDIRECTORYMAGIC;
+    ModelDirectory.Format = MODELFORMATVERSION;
+    ModelDirectory.Count = 0;
+    ModelDirectory.Spare = 0;
+    OpenModelSection = -1;
+}
+
+/*********************************************************************************************************************************/
+void EndModelSection()
+{
+    if (OpenModelSection < 0)
+        return;
+    ModelSections[OpenModelSection].Length = (SDCardAddress - StartLocation) - ModelSections[OpenModelSection].Offset;
+    OpenModelSection = -1;
+}
+
+/*********************************************************************************************************************************/
+void BeginModelSection(uint8_t ID)
+{
+    EndModelSection();
+    if (ModelDirectory.Count >= MAXMODELSECTIONS)
+        return;
+    ModelSectionEntry *Entry = &ModelSections[ModelDirectory.Count];
+    Entry->ID = ID;
+    Entry->Version = 1;
+    for (uint8_t i = 0; i < sizeof(ModelSectionKinds) / sizeof(ModelSectionKinds[0]); ++i)
+    {
+        if (ModelSectionKinds[i].ID == ID)
+            Entry->Version = ModelSectionKinds[i].Version;
+    }
+    Entry->Offset = SDCardAddress - StartLocation;
+    Entry->Length = 0;
+    Entry->Spare = 0;
+    Entry->Crc = 0;
+    OpenModelSection = ModelDirectory.Count++;
+}
+
+/*********************************************************************************************************************************/
+// Called by SaveOneModel() when the model is complete in SDBlock: works out every section's CRC32 and adds the directory.
+
+void WriteModelDirectory()
+{
+    EndModelSection();
+#ifdef DB_SD
+    if (SDCardAddress - StartLocation > MODELDIRECTORYOFFSET)
+        Serial.println("Model has grown into its section directory!");
+#endif
+    for (uint8_t i = 0; i < ModelDirectory.Count; ++i)
+        ModelSections[i].Crc = Crc32(SDBlock + ModelSections[i].Offset, ModelSections[i].Length);
+    uint8_t *p = SDBlock + MODELDIRECTORYOFFSET;
+    uint16_t Size = ModelDirectory.Count * sizeof(ModelSectionEntry);
+    memcpy(p, &ModelDirectory, sizeof(ModelDirectory));
+    memcpy(p + sizeof(ModelDirectory), ModelSections, Size);
+    uint32_t DirectoryCrc = Crc32(p, sizeof(ModelDirectory) + Size);
+    memcpy(p + sizeof(ModelDirectory) + Size, &DirectoryCrc, 4);
+}
+
+/*********************************************************************************************************************************/
+// Called by ReadOneModel() once the model is in SDBlock. Sets ModelDirectoryFound if the model has a good directory and
+// every section matches its CRC32. Otherwise the model is read as an older one, and the old checksum is checked instead.
+
+void ReadModelDirectory()
+{
+    uint8_t *p = SDBlock + MODELDIRECTORYOFFSET;
+    uint32_t DirectoryCrc;
+    ModelDirectoryFound = false;
+    memcpy(&ModelDirectory, p, sizeof(ModelDirectory));
+    if ((ModelDirectory.Magic != MODELDIRECTORYMAGIC) || (ModelDirectory.Count > MAXMODELSECTIONS))
+        return; // Written before sections existed
+    uint16_t Size = ModelDirectory.Count * sizeof(ModelSectionEntry);
+    memcpy(ModelSections, p + sizeof(ModelDirectory), Size);
+    memcpy(&DirectoryCrc, p + sizeof(ModelDirectory) + Size, 4);
+    if (DirectoryCrc != Crc32(p, sizeof(ModelDirectory) + Size))
+        return;
+    for (uint8_t i = 0; i < ModelDirectory.Count; ++i)
+    {
+        ModelSectionEntry *Entry = &ModelSections[i];
+        if ((Entry->Offset + Entry->Length > MODELDIRECTORYOFFSET) || (Crc32(SDBlock + Entry->Offset, Entry->Length) != Entry->Crc))
+        {
+#ifdef DB_CHECKSUM
+            Serial.print("Bad CRC32 in model section ");
+            Serial.println(Entry->ID);
+#endif
+            return;
+        }
+    }
+    ModelDirectoryFound = true;
+}
+
+/*********************************************************************************************************************************/
+// Moves SDCardAddress to the start of a section. Returns false if this model doesn't have it.
+// (Older files have no directory, so they are just read in order.)
+
+bool SeekModelSection(uint8_t ID)
+{
+    if (!ModelDirectoryFound)
+        return true;
+    for (uint8_t i = 0; i < ModelDirectory.Count; ++i)
+    {
+        if (ModelSections[i].ID == ID)
+        {
+            SDCardAddress = StartLocation + ModelSections[i].Offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,150 @@
+// *************************************** ModelStore.h *****************************************
+
+// The whole of models.dat (transmitter params and every model slot) is kept in PSRAM (EXTMEM).
+// Once it's loaded, LoadSDBlock() and SaveSDBlock() copy to and from here instead of the SD card, so loading, saving or
+// finding a model is just a memory copy. Parts that have changed are written back to SD a little later, one per pass
+// through ManageTransmitter(), and all at once before the power goes off.
+// Without PSRAM fitted (or without models.dat) nothing changes: the SD card is used as before.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef MODEL_STORE_H
+#define MODEL_STORE_H
+
+/*********************************************************************************************************************************/
+bool ModelStoreInUse() // Single model files (import, export, backups) always use the SD card
+{
+    return ModelStoreLoaded && !SingleModelFlag;
+}
+
+/*********************************************************************************************************************************/
+// Part 0 is the transmitter params, part n is model n.
+
+uint8_t ModelStorePart(int Address)
+{
+    if (Address < TXSIZE)
+        return 0;
+    return 1 + ((Address - TXSIZE) / (MODELSIZE));
+}
+
+/*********************************************************************************************************************************/
+int ModelStorePartStart(uint8_t Part)
+{
+    if (!Part)
+        return 0;
+    return TXSIZE + ((Part - 1) * MODELSIZE);
+}
+
+/*********************************************************************************************************************************/
+int ModelStorePartLength(uint8_t Part)
+{
+    return Part ? (MODELSIZE) : TXSIZE;
+}
+
+/*********************************************************************************************************************************/
+bool InModelStore(int Start, int Length)
+{
+    return ModelStoreInUse() && (Start >= 0) && (Length > 0) && (Start + Length <= MODELSTORESIZE);
+}
+
+/*********************************************************************************************************************************/
+bool ReadFromModelStore(int Start, uint8_t *Data, int Length)
+{
+    if (!InModelStore(Start, Length))
+        return false;
+    memcpy(Data, ModelStore + Start, Length);
+    return true;
+}
+
+/*********************************************************************************************************************************/
+bool WriteToModelStore(int Start, const uint8_t *Data, int Length)
+{
+    if (!InModelStore(Start, Length))
+        return false;
+    if (memcmp(ModelStore + Start, Data, Length) == 0)
+        return true; // Nothing changed, so nothing to write back
+    memcpy(ModelStore + Start, Data, Length);
+    for (uint8_t Part = ModelStorePart(Start); Part <= ModelStorePart(Start + Length - 1); ++Part)
+    {
+        if (!ModelStoreDirty[Part])
+        {
+            ModelStoreDirty[Part] = true;
+            ++ModelStoreDirtyCount;
+        }
+    }
+    ModelStoreChangeTime = millis();
+    return true;
+}
+
+/*********************************************************************************************************************************/
+// Called at boot, after LoadAllParameters(). Reads models.dat into PSRAM with one read.
+
+FLASHMEM void LoadModelStore()
+{
+    if (!external_psram_size)
+        return; // no PSRAM fitted
+    if (!ModelsFileOpen)
+        OpenModelsFile();
+    if (!ModelsFileOpen)
+        return;
+#ifdef DB_SD
+    uint32_t SDTimer = micros();
+#endif
+    int Got = 0;
+    if (ModelsFileNumber.seek(0))
+        Got = ModelsFileNumber.read(ModelStore, MODELSTORESIZE);
+    if (Got < 0)
+        Got = 0;
+    memset(ModelStore + Got, 0xFF, MODELSTORESIZE - Got); // unused slots past the end of the file
+    memset(ModelStoreDirty, 0, sizeof(ModelStoreDirty));
+    ModelStoreDirtyCount = 0;
+    ModelStoreLoaded = true;
+#ifdef DB_SD
+    Serial.print("Model store loaded in ");
+    Serial.print(micros() - SDTimer);
+    Serial.println(" us.");
+#endif
+}
+
+/*********************************************************************************************************************************/
+// Writes changed parts back to models.dat - just one unless All is true. Returns true if anything was written. A part whose
+// journal entry fails stays dirty and is tried again later.
+
+bool FlushModelStore(bool All)
+{
+    if (!ModelStoreLoaded || !ModelStoreDirtyCount || SingleModelFlag)
+        return false;
+    if (!ModelsFileOpen)
+        OpenModelsFile();
+    if (!ModelsFileOpen)
+        return false;
+    for (uint8_t Part = 0; Part < MAXMODELNUMBER; ++Part)
+    {
+        if (!ModelStoreDirty[Part])
+            continue;
+        if (!WriteToModelsFile(ModelStorePartStart(Part), ModelStore + ModelStorePartStart(Part), ModelStorePartLength(Part)))
+        {
+            ModelStoreChangeTime = millis(); // Still dirty: try again later
+            return false;
+        }
+        ModelStoreDirty[Part] = false;
+        --ModelStoreDirtyCount;
+        if (Part)
+            SaveCatalogEntry(Part);
+        if (!All)
+            break;
+    }
+    return true;
+}
+
+/*********************************************************************************************************************************/
+// From ManageTransmitter(): once nothing has changed for MODELSTOREFLUSHDELAY ms, write back one changed part.
+
+void ManageModelStore(uint32_t RightNow)
+{
+    if (ModelStoreDirtyCount && (RightNow - ModelStoreChangeTime >= MODELSTOREFLUSHDELAY))
+        FlushModelStore(false);
+}
+
+#endif
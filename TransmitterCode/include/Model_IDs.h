@@ -21,21 +21,13 @@ void CheckAllModelIds()
     char n0[] = "n0";
     char nb[4];
     char buf[MAXBUFFERSIZE];
-    uint64_t ModelIDs[92];
     uint8_t DuplicatesCount = 0;
-    uint32_t SavedModelNumber = ModelNumber;
 
     SendCommand(GoIDview);
     CurrentView = IDCHECKVIEW;
-    for (ModelNumber = 1; ModelNumber < MAXMODELNUMBER - 1; ++ModelNumber)
+    for (uint32_t Slot = 1; Slot < MAXMODELNUMBER - 1; ++Slot) // Names and IDs all come from the catalog
     {
-        ReadOneModel(ModelNumber);
-        ModelIDs[ModelNumber] = ModelsMacUnionSaved.Val64;
-    }
-    for (ModelNumber = 1; ModelNumber < MAXMODELNUMBER - 1; ++ModelNumber)
-    {
-        ReadOneModel(ModelNumber);
-        if (ModelNumber == 1)
+        if (Slot == 1)
         {
             strcpy(buf, lb);
         }
@@ -43,15 +35,14 @@ void CheckAllModelIds()
         {
             strcat(buf, lb);
         }
-        Str(nb, ModelNumber, 0);
+        Str(nb, Slot, 0);
         strcat(buf, nb);
         strcat(buf, rb);
-        strcat(buf, ModelName);
+        strcat(buf, ModelCatalog[Slot].Name);
 
-        uint64_t mac = ModelsMacUnionSaved.Val64 & 0x0000FFFFFFFFFFFF;
-        ModelIDs[ModelNumber] = ModelsMacUnionSaved.Val64;
+        uint64_t mac = ModelCatalog[Slot].ID & 0x0000FFFFFFFFFFFF;
 
-        if (mac)
+        if (ModelCatalog[Slot].Defined && mac)
         {
             snprintf(Vbuf, sizeof(Vbuf), " %012llX", mac);
             strcat(buf, Vbuf);
@@ -59,7 +50,7 @@ void CheckAllModelIds()
             int p = 0;
             for (unsigned int i = 1; i < MAXMODELNUMBER - 1; ++i)
             {
-                if ((ModelIDs[i] == ModelIDs[ModelNumber]) && (i != ModelNumber))
+                if (ModelCatalog[i].Defined && (ModelCatalog[i].ID == ModelCatalog[Slot].ID) && (i != Slot))
                     p = i;
             }
             if (p > 0)
@@ -78,8 +69,6 @@ void CheckAllModelIds()
     }
     SendOtherText(MMemsp, buf);
     SendValue(n0, DuplicatesCount);
-    ModelNumber = SavedModelNumber;
-    ReadOneModel(ModelNumber);
 }
 
 // *********************************************************************************************************************************/
@@ -6,14 +6,250 @@
 /*********************************************************************************************************************************/
 //                        NEXTION functions
 /*********************************************************************************************************************************/
-void GetReturnCode(char *tbox)
+// Output to the display is queued. Callers return at once and DrainNextionQueue() hands the bytes to the serial port a chunk
+// at a time from ManageTransmitter() (only when there's time before the next packet) and from DelayWithDog().
+// After a page change nothing more is sent until the new page has had SCREENCHANGEWAIT ms to appear.
+// Anything that needs a reply calls FlushNextionQueue() first so replies still arrive in order.
+
+char NextionQueue[NEXTIONQUEUESIZE];
+uint16_t NextionQueueHead = 0;       // Next byte in
+uint16_t NextionQueueTail = 0;       // Next byte out
+uint16_t NextionPageMark = 0;        // Queue position just after a page change
+bool NextionPageMarkPending = false; // A page change is waiting in the queue
+bool NextionPageSettling = false;    // A page change has been sent and the new page is appearing
+uint32_t NextionPageChangeTime = 0;  // millis() when it was sent
+uint8_t NextionTxBuffer[NEXTIONTXBUFFERSIZE]; // Extra room for the serial port's transmit interrupt, so chunks are handed over at once
+uint32_t NextionBaud = NEXTIONMAXBAUD;       // What the display was found to accept
+
+#ifdef DB_NEXTIONRENDER
+const char *NextionRenderName = nullptr; // Screen being timed
+uint32_t NextionRenderStart = 0;         // micros() when it began
+uint32_t NextionRenderBytes = 0;         // Bytes queued for it
+#endif
+
+/*********************************************************************************************************************************/
+// Times how long a whole screen takes to reach the display (from now until the queue is empty).
+void StartNextionRenderTiming(const char *Name)
 {
-    while (NEXTION.available())
+#ifdef DB_NEXTIONRENDER
+    NextionRenderName = Name;
+    NextionRenderStart = micros();
+    NextionRenderBytes = 0;
+#else
+    (void)Name;
+#endif
+}
+
+/*********************************************************************************************************************************/
+void ReportNextionRenderTiming()
+{
+#ifdef DB_NEXTIONRENDER
+    if (!NextionRenderName)
+        return;
+    Look1(NextionRenderName);
+    Look1(": ");
+    Look1(micros() - NextionRenderStart);
+    Look1(" us for ");
+    Look1(NextionRenderBytes);
+    Look1(" bytes at ");
+    Look(NextionBaud);
+    NextionRenderName = nullptr;
+#endif
+}
+
+/*********************************************************************************************************************************/
+uint16_t NextionQueueUsed() // Bytes still waiting to go to the display
+{
+    return (NextionQueueHead + NEXTIONQUEUESIZE - NextionQueueTail) % NEXTIONQUEUESIZE;
+}
+
+/*********************************************************************************************************************************/
+FASTRUN void DrainNextionQueue()
+{
+    static uint32_t LastChunkTime = 0;
+    if (NextionQueueHead == NextionQueueTail)
+        return;
+    if (NextionPageSettling)
+    {
+        if (millis() - NextionPageChangeTime < SCREENCHANGEWAIT)
+            return;
+        NextionPageSettling = false;
+    }
+    if (micros() - LastChunkTime < NEXTIONCHUNKGAP)
+        return; // let the display's parser keep up
+    uint16_t End = (NextionQueueHead > NextionQueueTail) ? NextionQueueHead : NEXTIONQUEUESIZE;
+    if (NextionPageMarkPending && NextionPageMark > NextionQueueTail && NextionPageMark < End)
+        End = NextionPageMark; // stop at the page change
+    int n = End - NextionQueueTail;
+    if (n > NEXTIONCHUNK)
+        n = NEXTIONCHUNK;
+    if (n > NEXTION.availableForWrite())
+        n = NEXTION.availableForWrite();
+    if (n <= 0)
+        return;
+    NEXTION.write((uint8_t *)NextionQueue + NextionQueueTail, n);
+    NextionQueueTail = (NextionQueueTail + n) % NEXTIONQUEUESIZE;
+    LastChunkTime = micros();
+    if (NextionQueueHead == NextionQueueTail)
+        ReportNextionRenderTiming();
+    if (NextionPageMarkPending && NextionQueueTail == NextionPageMark)
+    {
+        NextionPageMarkPending = false;
+        NextionPageSettling = true;
+        NextionPageChangeTime = millis();
+    }
+}
+
+/*********************************************************************************************************************************/
+void FlushNextionQueue() // Blocks until everything queued has been sent and any new page has appeared
+{
+    while ((NextionQueueHead != NextionQueueTail) || NextionPageSettling)
+    {
+        DrainNextionQueue();
+        KickTheDog();
+    }
+    NEXTION.flush();
+}
+
+/*********************************************************************************************************************************/
+void QueueNextionBytes(const char *src, uint16_t len)
+{
+    uint16_t Used = (NextionQueueHead - NextionQueueTail + NEXTIONQUEUESIZE) % NEXTIONQUEUESIZE;
+    if (Used + len >= NEXTIONQUEUESIZE)
+        FlushNextionQueue(); // full (shouldn't happen often)
+#ifdef DB_NEXTIONRENDER
+    NextionRenderBytes += len;
+#endif
+    for (uint16_t i = 0; i < len; ++i)
+    {
+        NextionQueue[NextionQueueHead] = src[i];
+        NextionQueueHead = (NextionQueueHead + 1) % NEXTIONQUEUESIZE;
+    }
+}
+
+/*********************************************************************************************************************************/
+void QueueNextionTerminator()
+{
+    QueueNextionBytes("\xFF\xFF\xFF", 3);
+}
+
+/*********************************************************************************************************************************/
+// Shadow copy of what the widgets show. An update identical to the last one sent to that widget is skipped.
+// Entries are keyed by the hash of the attribute being set (e.g. "n1.val") and hold a hash of the value.
+// Page changes, touches and ForceDataRedisplay() forget everything. SendCommand() and QueueNextionText() forget any
+// attribute they assign. A command ends at its '\0' or at the 0xFF terminator that follows it in a batch.
+
+struct WidgetShadow
+{
+    uint32_t KeyHash;   // 0 = slot free
+    uint32_t ValueHash; // Hash of last value sent
+    bool Known;         // false if the widget may have changed since
+};
+WidgetShadow NextionShadow[NEXTIONSHADOWSIZE];
+
+/*********************************************************************************************************************************/
+void ForgetNextionShadows()
+{
+    memset(NextionShadow, 0, sizeof(NextionShadow));
+}
+
+/*********************************************************************************************************************************/
+uint32_t ShadowKey(const char *Command) // Hash of the part before '='
+{
+    uint32_t Hash = FNV1A_SEED;
+    while (*Command && *Command != '=' && *Command != '\xFF')
+        Hash = FNV1aHashByte(Hash, *Command++);
+    return Hash ? Hash : 1;
+}
+
+/*********************************************************************************************************************************/
+WidgetShadow *FindNextionShadow(uint32_t KeyHash, bool Add)
+{
+    uint16_t Home = KeyHash % NEXTIONSHADOWSIZE;
+    for (uint16_t i = 0; i < NEXTIONSHADOWSIZE; ++i)
     {
-        delayMicroseconds(70);
-        NEXTION.read();
+        WidgetShadow *w = &NextionShadow[(Home + i) % NEXTIONSHADOWSIZE];
+        if (w->KeyHash == KeyHash)
+            return w;
+        if (!w->KeyHash)
+        {
+            if (!Add)
+                return nullptr;
+            w->KeyHash = KeyHash;
+            w->Known = false;
+            return w;
+        }
     }
+    if (!Add)
+        return nullptr;
+    NextionShadow[Home].KeyHash = KeyHash; // Table full: reuse
+    NextionShadow[Home].Known = false;
+    return &NextionShadow[Home];
 }
+
+/*********************************************************************************************************************************/
+// Returns true if Command would only set a widget to what it already shows. Otherwise remembers the new value.
+bool NextionShadowMatches(const char *Command)
+{
+    const char *Value = strchr(Command, '=');
+    if (!Value)
+        return false;
+    WidgetShadow *w = FindNextionShadow(ShadowKey(Command), true);
+    uint32_t ValueHash = FNV1aHash(Value);
+    if (w->Known && w->ValueHash == ValueHash)
+        return true;
+    w->ValueHash = ValueHash;
+    w->Known = true;
+    return false;
+}
+
+/*********************************************************************************************************************************/
+bool NextionAssigns(const char *Command) // Is there an '=' in this command (not in a later one)?
+{
+    while (*Command && *Command != '\xFF')
+    {
+        if (*Command++ == '=')
+            return true;
+    }
+    return false;
+}
+
+/*********************************************************************************************************************************/
+void ForgetNextionShadow(const char *Command)
+{
+    if (!NextionAssigns(Command))
+        return;
+    WidgetShadow *w = FindNextionShadow(ShadowKey(Command), false);
+    if (w)
+        w->Known = false;
+}
+
+/*********************************************************************************************************************************/
+bool IsNextionPageCommand(const char *Command) // "page FrontView" but not "t0.txt=\"page 2\""
+{
+    return !strncmp(Command, "page ", 5);
+}
+
+/*********************************************************************************************************************************/
+// For raw batches of commands ("n1.val=5\xFF\xFF\xFFline 1,2,3,4,0\xFF\xFF\xFF" ...). Only the widgets that the batch sets are
+// forgotten, unless it changes page.
+void QueueNextionText(const char *text)
+{
+    const char *Command = text;
+    while (*Command)
+    {
+        if (IsNextionPageCommand(Command))
+            ForgetNextionShadows();
+        else
+            ForgetNextionShadow(Command);
+        while (*Command && *Command != '\xFF')
+            ++Command;
+        while (*Command == '\xFF')
+            ++Command;
+    }
+    QueueNextionBytes(text, strlen(text));
+}
+
 /*********************************************************************************************************************************/
 void ClearNextionCommand()
 {
@@ -90,8 +326,8 @@ void SendText1(char *tbox, char *NewWord)
     uint16_t used = strlen(CB);
     CopyTextForNextion(CB + used, NewWord, (uint16_t)(sizeof(CB) - used - 2));
     strcat(CB, "\"");
-    SendCommand(CB);
-    GetReturnCode(tbox);
+    if (!NextionShadowMatches(CB))
+        QueueNextionCommand(CB);
 }
 /*********************************************************************************************************************************/
 void SendText(char *tbox, char *NewWord)
@@ -107,24 +343,12 @@ void SendOtherText(char *tbox, char *NewWord)
     uint16_t used = strlen(CB);
     CopyTextForNextion(CB + used, NewWord, (uint16_t)(sizeof(CB) - used - 2));
     strcat(CB, "\"");
-    // ClaudeFix-14-7-2026 Send BIG commands in paced chunks. The models list is ~1.6 KB in
-    // ONE command; blasted at 921600 while the display is still redrawing
-    // (e.g. rendering the model image) it overruns the display's RX buffer
-    // and is silently dropped -- the freshly imported model then never
-    // appeared in the list until a second attempt.
-    uint16_t len = strlen(CB);
-    for (uint16_t i = 0; i < len; i += 64)
-    {
-        uint16_t n = (uint16_t)(len - i);
-        if (n > 64)
-            n = 64;
-        NEXTION.write((uint8_t *)CB + i, n);
-        NEXTION.flush();
-        delayMicroseconds(800); // let the display's parser drain the chunk
-        KickTheDog();
-    }
-    EndSend();
-    GetReturnCode(tbox);
+    // ClaudeFix-14-7-2026 BIG commands (the models list is ~1.6 KB in ONE command) overran the display's RX buffer
+    // when blasted at 921600 while it was still redrawing. The queue now sends everything in paced chunks.
+    if (NextionShadowMatches(CB))
+        return;
+    QueueNextionBytes(CB, strlen(CB));
+    QueueNextionTerminator();
 }
 
 /*********************************************************************************************************************************/
@@ -136,102 +360,345 @@ void SendOtherValue(char *nbox, int value)
     strcpy(CB, nbox);
     strcat(CB, Val);
     strcat(CB, Str(NB, value, 0));
-    SendCommand(CB);
+    if (!NextionShadowMatches(CB))
+        QueueNextionCommand(CB);
     ValueSent = true;
-    GetReturnCode(nbox);
 }
 
 /*********************************************************************************************************************************/
-// ClaudeFix-14-7-2026 The Nextion sends UNSOLICITED touch-event strings ("Import x.MOD",
-// "Yes", ...) into the same serial buffer as get-replies. The 2-7 fix flushed
-// that buffer before every get -- which DESTROYED any button press that was
-// waiting there (the restore button needed 2-3 presses). Instead of discarding,
-// printable bytes are rescued here and served to GetButtonPress afterwards.
-// (Return-code debris -- 0x01/0x1A + FF FF FF -- is non-printable and still dropped.)
-char PendingEvent[128];
-uint16_t PendingEventLen = 0;
+// Input from the display.
+// The serial port's receive interrupt fills its ring buffer (NextionRxBuffer is added to it at startup so nothing overflows
+// while we're busy). PumpNextionInput() passes whatever has arrived through a small state machine that recognises each
+// message as it comes:
+//      'q' + 4 bytes + FF FF FF            number reply to a "get" (only while one is awaited)
+//      'p' + text + FF FF FF               text reply to a "get" (only while one is awaited)
+//      0 or >= 0x80 then up to 3 bytes     numbered touch event
+//      0x00 - 0x24 + FF FF FF              return code. Dropped.
+//      printable text, then a pause        word touch event ("Setup3", "Import MODEL.MOD" ...)
+// Touch events are written straight into NextionEventRing and queued until GetButtonPress() collects them. Replies are
+// written straight into NextionReply[] for the getter that asked. So a touch that arrives while a getter waits is just
+// queued behind it, and nothing needs rescuing.
+
+uint8_t NextionRxBuffer[NEXTIONRXBUFFERSIZE]; // Extra room for the serial port's receive interrupt
+
+struct NextionEvent
+{
+    uint16_t Start;  // Where it is in NextionEventRing
+    uint16_t Length; //
+};
+
+char NextionEventRing[NEXTIONEVENTRINGSIZE]; // Touch events, as they arrived
+uint16_t NextionEventRingHead = 0;           // Free running: masked when used
+uint16_t NextionEventStart = 0;              // Where the event being parsed began
+NextionEvent NextionEvents[NEXTIONEVENTS];   // Complete events waiting for GetButtonPress()
+uint8_t NextionEventsIn = 0;                 //
+uint8_t NextionEventsOut = 0;                //
+
+uint8_t NextionParserState = NEXTIONIDLE;
+uint8_t NextionFrameLength = 0;   // Bytes of a number reply so far
+uint8_t NextionFFs = 0;           // FFs in a row at the end of a text reply
+uint32_t NextionLastByteTime = 0; // micros() when the last byte arrived
+
+char NextionReply[NEXTIONREPLYSIZE];  // The reply's value (4 bytes) or text (NUL terminated)
+uint8_t NextionReplyAwaited = 0;      // 'q' or 'p' while a getter waits for that reply, else 0
+uint32_t NextionReplyAwaitedTime = 0; // millis() when it was requested
+bool NextionReplyReady = false;       // It arrived
 
-void StashPrintableBytes(const char *src, uint16_t len)
+/*********************************************************************************************************************************/
+bool NextionReplyWanted(uint8_t Kind)
 {
-    for (uint16_t i = 0; i < len; ++i)
+    return (NextionReplyAwaited == Kind) && ((millis() - NextionReplyAwaitedTime) < NEXTIONREPLYLATE);
+}
+
+/*********************************************************************************************************************************/
+FASTRUN void StoreNextionEventByte(uint8_t b)
+{
+    uint16_t Length = NextionEventRingHead - NextionEventStart;
+    if (Length >= MAXTEXTIN || Length >= NEXTIONEVENTRINGSIZE - 1)
+        return; // an event can't be longer than TextIn (or the ring)
+    if (NextionEventsIn != NextionEventsOut &&
+        (uint16_t)(NextionEventRingHead - NextionEvents[NextionEventsOut].Start) >= NEXTIONEVENTRINGSIZE)
+        return; // ring is full of unread events. This one gets truncated.
+    NextionEventRing[NextionEventRingHead++ & (NEXTIONEVENTRINGSIZE - 1)] = b;
+}
+
+/*********************************************************************************************************************************/
+void EndNextionEvent() // Queue the event just parsed (if there's room)
+{
+    uint16_t Length = NextionEventRingHead - NextionEventStart;
+    uint8_t Next = (NextionEventsIn + 1) % NEXTIONEVENTS;
+    if (Length && Next != NextionEventsOut)
     {
-        uint8_t b = (uint8_t)src[i];
-        if (b >= 32 && b < 0x7F && PendingEventLen < sizeof(PendingEvent) - 1)
-            PendingEvent[PendingEventLen++] = b;
+        NextionEvents[NextionEventsIn].Start = NextionEventStart;
+        NextionEvents[NextionEventsIn].Length = Length;
+        NextionEventsIn = Next;
     }
-    PendingEvent[PendingEventLen] = 0;
+    else
+        NextionEventRingHead = NextionEventStart; // no room. Drop it.
+    NextionParserState = NEXTIONIDLE;
 }
 
-void StashPendingEventBytes() // replaces the blind pre-get flush
+/*********************************************************************************************************************************/
+void DropNextionEvent()
 {
-    while (NEXTION.available())
+    NextionEventRingHead = NextionEventStart;
+    NextionParserState = NEXTIONIDLE;
+}
+
+/*********************************************************************************************************************************/
+// Four bytes starting with a non-printable byte: a return code (dropped) or a numbered touch event (queued).
+void EndNextionCodeFrame()
+{
+    uint16_t Length = NextionEventRingHead - NextionEventStart;
+    uint8_t First = NextionEventRing[NextionEventStart & (NEXTIONEVENTRINGSIZE - 1)];
+    if (First == 0xFF || (First && First < 0x80))
     {
-        uint8_t b = NEXTION.read();
-        if (b >= 32 && b < 0x7F && PendingEventLen < sizeof(PendingEvent) - 1)
-            PendingEvent[PendingEventLen++] = b;
-        delayMicroseconds(20); // one byte at 921600 baud takes ~11 us
+        DropNextionEvent(); // return code, or the tail of a reply nobody wanted
+        return;
     }
-    PendingEvent[PendingEventLen] = 0;
+    if (!First && Length == 4)
+    {
+        bool AllFFs = true;
+        for (uint16_t i = 1; i < 4; ++i)
+            if ((uint8_t)NextionEventRing[(NextionEventStart + i) & (NEXTIONEVENTRINGSIZE - 1)] != 0xFF)
+                AllFFs = false;
+        if (AllFFs)
+        {
+            DropNextionEvent(); // return code 0 (invalid instruction)
+            return;
+        }
+    }
+    EndNextionEvent();
 }
 
-void GetTextIn() 
+/*********************************************************************************************************************************/
+// A word event ended with a non-printable byte. If a number reply is awaited, its 'q' (and any printable value bytes) may be
+// stuck to the end of the word. If so the word is cut short there and the reply carries on.
+bool SplitNumberReplyFromWord(uint8_t b)
 {
-    delayMicroseconds(20);
-    if (NEXTION.available())
+    if (!NextionReplyWanted('q'))
+        return false;
+    uint16_t Length = NextionEventRingHead - NextionEventStart;
+    for (int8_t k = 4; k >= 0; --k) // k = value bytes already taken into the word
+    {
+        if (Length < (uint16_t)(k + 1) || (k == 4 && b != 0xFF))
+            continue;
+        uint16_t q = NextionEventRingHead - 1 - k;
+        if (NextionEventRing[q & (NEXTIONEVENTRINGSIZE - 1)] != 'q')
+            continue;
+        for (uint8_t i = 0; i < k; ++i)
+            NextionReply[i] = NextionEventRing[(q + 1 + i) & (NEXTIONEVENTRINGSIZE - 1)];
+        NextionEventRingHead = q;
+        EndNextionEvent();
+        NextionFrameLength = k;
+        NextionParserState = NEXTIONNUMBER;
+        return true;
+    }
+    return false;
+}
+
+/*********************************************************************************************************************************/
+void EndNextionFrame() // Ends a word or numbered event that had no more bytes
+{
+    if (NextionParserState == NEXTIONWORD)
+        EndNextionEvent();
+    else if (NextionParserState == NEXTIONCODE)
+        EndNextionCodeFrame();
+}
+
+/*********************************************************************************************************************************/
+FASTRUN void ParseNextionByte(uint8_t b)
+{
+    switch (NextionParserState)
     {
-        int j = 0;
-        while (NEXTION.available())
+    case NEXTIONIDLE:
+        NextionEventStart = NextionEventRingHead;
+        NextionFrameLength = 0;
+        NextionFFs = 0;
+        if ((b == 'q' || b == 'p') && NextionReplyWanted(b))
+        {
+            NextionParserState = (b == 'q') ? NEXTIONNUMBER : NEXTIONSTRING;
+            break;
+        }
+        StoreNextionEventByte(b);
+        NextionParserState = (b >= 32 && b < 0x7F) ? NEXTIONWORD : NEXTIONCODE;
+        break;
+
+    case NEXTIONWORD:
+        if (b >= 32 && b < 0x7F)
+        {
+            StoreNextionEventByte(b);
+            break;
+        }
+        if (!SplitNumberReplyFromWord(b))
         {
-            TextIn[j] = NEXTION.read();
-            KickTheDog();
-            if (j < MAXTEXTIN)
-                ++j;
-            delayMicroseconds(20);
+            EndNextionEvent();
+            ParseNextionByte(b); // and this byte begins something new
+            break;
         }
+        ParseNextionByte(b); // this byte is part of the reply
+        break;
+
+    case NEXTIONCODE:
+        StoreNextionEventByte(b);
+        if ((uint16_t)(NextionEventRingHead - NextionEventStart) >= 4)
+            EndNextionCodeFrame();
+        break;
+
+    case NEXTIONNUMBER: // 4 bytes of value (which may be FFs) then FF FF FF
+        if (NextionFrameLength < 4)
+            NextionReply[NextionFrameLength] = b;
+        else if (b != 0xFF)
+        { // not a proper reply after all
+            NextionParserState = NEXTIONIDLE;
+            ParseNextionByte(b);
+            break;
+        }
+        if (++NextionFrameLength == 7)
+        {
+            NextionReplyReady = true;
+            NextionReplyAwaited = 0;
+            NextionParserState = NEXTIONIDLE;
+        }
+        break;
+
+    case NEXTIONSTRING: // text then FF FF FF
+        if (b == 0xFF)
+        {
+            if (++NextionFFs < 3)
+                break;
+            NextionReply[NextionFrameLength] = 0;
+            NextionReplyReady = true;
+            NextionReplyAwaited = 0;
+            NextionParserState = NEXTIONIDLE;
+            break;
+        }
+        NextionFFs = 0;
+        if (NextionFrameLength < NEXTIONREPLYSIZE - 1)
+            NextionReply[NextionFrameLength++] = b;
+        break;
     }
 }
 
 /*********************************************************************************************************************************/
-bool GetButtonPress() 
+// A reply that was cut short (or began too late) would leave the parser inside it, taking every touch event that follows as
+// more of the reply. Once it is older than NEXTIONREPLYLATE it's dropped and the parser starts again.
+void DropNextionReply()
 {
-    if (PendingEventLen)
-    {   // a touch event rescued from a get-reply window -- deliver it now
-        memcpy(TextIn, PendingEvent, PendingEventLen);
-        TextIn[PendingEventLen] = 0;
-        PendingEventLen = 0;
-        return true;
+    if (NextionParserState == NEXTIONNUMBER || NextionParserState == NEXTIONSTRING)
+        NextionParserState = NEXTIONIDLE;
+    NextionReplyAwaited = 0;
+}
+
+FASTRUN void DropLateNextionReply()
+{
+    if ((NextionParserState == NEXTIONNUMBER || NextionParserState == NEXTIONSTRING || NextionReplyAwaited) &&
+        (millis() - NextionReplyAwaitedTime) >= NEXTIONREPLYLATE)
+        DropNextionReply();
+}
+
+/*********************************************************************************************************************************/
+// Parses everything that has arrived. Word and numbered events have no terminator so they end after a short silence.
+FASTRUN void PumpNextionInput()
+{
+    while (NEXTION.available())
+    {
+        ParseNextionByte(NEXTION.read());
+        NextionLastByteTime = micros();
     }
-    if (NEXTION.available())
+    DropLateNextionReply();
+    if ((micros() - NextionLastByteTime) > NEXTIONEVENTGAP)
+        EndNextionFrame();
+}
+
+/*********************************************************************************************************************************/
+bool NextionInputWaiting() // A touch event has arrived (or is arriving) and should be handled before anything else
+{
+    PumpNextionInput();
+    return (NextionEventsIn != NextionEventsOut) || (NextionParserState == NEXTIONWORD) || (NextionParserState == NEXTIONCODE);
+}
+
+/*********************************************************************************************************************************/
+bool GetButtonPress() // Copies the oldest touch event into TextIn
+{
+    PumpNextionInput();
+    if (NextionEventsIn == NextionEventsOut)
+        return false;
+    NextionEvent *e = &NextionEvents[NextionEventsOut];
+    uint16_t Length = e->Length;
+    for (uint16_t i = 0; i < Length; ++i)
+        TextIn[i] = NextionEventRing[(e->Start + i) & (NEXTIONEVENTRINGSIZE - 1)];
+    while (Length < 4)
+        TextIn[Length++] = 0; // numbered events are read as 4 bytes
+    TextIn[Length] = 0;
+    NextionEventsOut = (NextionEventsOut + 1) % NEXTIONEVENTS;
+    return true;
+}
+
+/*********************************************************************************************************************************/
+// Request and reply. RequestNextionReply() sends a "get" and tells the parser which reply to expect. Nothing that came before
+// the request can be its reply, so whatever is being parsed is ended first. AwaitNextionReply() waits (a bounded time) for it.
+
+void RequestNextionReply(char *Request, uint8_t Kind)
+{
+    FlushNextionQueue(); // everything queued goes first
+    PumpNextionInput();
+    EndNextionFrame();
+    DropNextionReply(); // any earlier reply still being parsed can't be this one
+    NextionReplyReady = false;
+    NextionReplyAwaited = Kind;
+    NextionReplyAwaitedTime = millis();
+    QueueNextionBytes(Request, strlen(Request));
+    EndSend();
+}
+
+/*********************************************************************************************************************************/
+bool AwaitNextionReply(uint32_t TimeOut) // normal replies take ~2 ms
+{
+    uint32_t Begun = millis();
+    while (!NextionReplyReady && (millis() - Begun) < TimeOut)
     {
-        GetTextIn();
-        return true;
+        PumpNextionInput();
+        KickTheDog();
     }
-    return false;
+    return NextionReplyReady;
 }
 
 /*********************************************************************************************************************************/
-void SendCommand(char *tbox)
+uint32_t NextionReplyNumber()
 {
-    char page[] = "page ";
-    char blankview[] = "BlankView";
-    NEXTION.print(tbox);
-    for (int i = 0; i < 3; ++i)
-        NEXTION.write(0xff);
-    delayMicroseconds(70);
-    GetReturnCode(tbox);
-    if (InStrng(blankview, tbox))
-        return; // Don't need to wait for blankview
-    if (InStrng(page, tbox))
-        DelayWithDog(SCREENCHANGEWAIT); // Allow time for new page to appear
+    return (uint8_t)NextionReply[0] | ((uint8_t)NextionReply[1] << 8) | ((uint8_t)NextionReply[2] << 16) | ((uint32_t)(uint8_t)NextionReply[3] << 24);
 }
+
 /*********************************************************************************************************************************/
-void EndSend()
+void QueueNextionCommand(char *tbox)
 {
-    for (u_int8_t pp = 0; pp < 3; ++pp)
+    char blankview[] = "BlankView";
+    bool NewPage = IsNextionPageCommand(tbox);
+    bool PageChange = NewPage && !InStrng(blankview, tbox); // Don't need to wait for blankview
+    if (PageChange && NextionPageMarkPending)
+        FlushNextionQueue(); // Only one page change can wait in the queue
+    QueueNextionBytes(tbox, strlen(tbox));
+    QueueNextionTerminator();
+    if (PageChange)
     {
-        NEXTION.write(0xff); // Send end of Input message //
+        NextionPageMark = NextionQueueHead; // Allow time for new page to appear before sending more
+        NextionPageMarkPending = true;
     }
-    DelayWithDog(55); // ** A DELAY ** (>=50 ms) was needed if an answer might come! (!! Shorter with Intelligent dislay)
+    if (NewPage)
+        ForgetNextionShadows(); // New page shows its own values
+}
+/*********************************************************************************************************************************/
+void SendCommand(char *tbox)
+{
+    ForgetNextionShadow(tbox); // If this sets a widget, the shadow can't know what
+    QueueNextionCommand(tbox);
+}
+/*********************************************************************************************************************************/
+void EndSend() // Ends a command that will get a reply. Waiting for it is up to the caller.
+{
+    QueueNextionTerminator();
+    FlushNextionQueue();
 }
 /*********************************************************************************************************************************/
 void SendValue(char *nbox, int value)
@@ -242,15 +709,14 @@ void SendValue(char *nbox, int value)
     strcpy(CB, nbox);
     strcat(CB, Val);
     strcat(CB, Str(NB, value, 0));
-    SendCommand(CB);
+    if (!NextionShadowMatches(CB))
+        QueueNextionCommand(CB);
     ValueSent = true;
-    GetReturnCode(nbox);
 }
 
 /*********************************************************************************************************************************/
 uint32_t getvalue(char *nbox)
 {
-    uint32_t ValueIn = 0;
     char GET[] = "get ";
     char VAL[] = ".val";
     char CB[100];
@@ -258,60 +724,12 @@ uint32_t getvalue(char *nbox)
     strcpy(CB, GET);
     strcat(CB, nbox);
     strcat(CB, VAL);
-    // ClaudeFix-2-7-2026 Same discipline as the fixed GetText: FLUSH stale bytes first (a
-    // leftover reply used to be parsed as THIS one -- the ArmingChannel bug
-    // family, which also fed shifted-by-one PIDs/rates to the FC), then WAIT
-    // for the framed 'q' reply instead of hoping it already arrived.
-    StashPendingEventBytes(); // ClaudeFix-14-7-2026 rescue any waiting button press, don't flush it
-    TextIn[0] = 0;
-    NEXTION.print(CB);
-    EndSend();
-    {
-        uint32_t begun = millis();
-        uint16_t k = 0;
-        uint8_t ffs = 0;
-        bool done = false;
-        while (!done && (millis() - begun) < 100)
-        {
-            while (NEXTION.available())
-            {
-                uint8_t b = NEXTION.read();
-                if (k < MAXTEXTIN)
-                    TextIn[k++] = b;
-                if (b == 0xFF)
-                {
-                    if (++ffs >= 3)
-                    {
-                        done = true;
-                        break;
-                    }
-                }
-                else
-                    ffs = 0;
-            }
-            KickTheDog();
-        }
-        // ClaudeFix-14-7-2026 A touch event that arrived just before the reply sits IN FRONT
-        // of the 8-byte 'q' frame. Rescue it and realign -- otherwise the read
-        // "fails" (65535), GetValue retries 25x with flushes, and the press dies.
-        if (done && k > 8)
-        {
-            StashPrintableBytes((char *)TextIn, k - 8);
-            memmove(TextIn, TextIn + (k - 8), 8);
-        }
-    }
-    if (TextIn[0] == 'q')
-    {
-        ValueIn = TextIn[1]; // Collect and build 32 bit value from 4 bytes
-        ValueIn += (TextIn[2] << 8);
-        ValueIn += (TextIn[3] << 16);
-        ValueIn += (TextIn[4] << 24);
-    }
-    else
-    {
-        ValueIn = 65535; // = THERE WAS AN ERROR !
-    }
-    return ValueIn;
+    // ClaudeFix-2-7-2026 A leftover reply used to be parsed as THIS one (the ArmingChannel bug family, which also fed
+    // shifted-by-one PIDs/rates to the FC). Now the parser only accepts a reply that was asked for, after it was asked for.
+    RequestNextionReply(CB, 'q');
+    if (!AwaitNextionReply(NEXTIONREPLYTIMEOUT))
+        return 65535; // = THERE WAS AN ERROR !
+    return NextionReplyNumber();
 }
 
 /*********************************************************************************************************************************/
@@ -322,7 +740,7 @@ uint32_t GetValue(char *nbox)
     int i = 0;
     uint32_t ValueIn = getvalue(nbox);
 
-    while (ValueIn == 65535 && i < 25)
+    while (ValueIn == 65535 && i < NEXTIONGETRETRIES)
     { // if error read again!
         DelayWithDog(10);
         ValueIn = getvalue(nbox);
@@ -342,65 +760,18 @@ uint16_t GetText(char *TextBoxName, char *TheText, uint16_t maxlen)
     char get[] = "get ";
     char _txt[] = ".txt";
     char CB[100];
-    uint16_t j = 0;
     strcpy(CB, get);
     strcat(CB, TextBoxName);
     strcat(CB, _txt);
 
-    // ClaudeFix-2-7-2026 Discard any STALE bytes before asking. Leftovers from earlier traffic
-    // (especially after heavy MSP work on the Rotorflight screens) used to be
-    // parsed as THIS field's reply — so field N's answer became field N+1's
-    // value. That is exactly how ArmingChannel "mysteriously" changed: the
-    // Ratio box's "10.30" was read back as Arming and atoi'd to a perfectly
-    // plausible channel 10, which then sailed past the range check.
-    StashPendingEventBytes(); // ClaudeFix-14-7-2026 rescue any waiting button press, don't flush it
-    TextIn[0] = 0; // if no reply arrives, stale TextIn content must not be re-parsed
-
-    NEXTION.print(CB);
-    EndSend();
-
-    // WAIT for the actual reply. The old code waited 20 MICROseconds — the
-    // Nextion cannot even begin answering that fast, so what got read was
-    // whatever the buffer already held (usually the PREVIOUS get's answer).
-    // A reply is 'p' + text + FF FF FF: collect until that terminator, with
-    // a timeout so a dead display can't hang us (normal replies take ~2 ms).
-    {
-        uint32_t begun = millis();
-        uint16_t k = 0;
-        uint8_t ffs = 0;
-        bool done = false;
-        while (!done && (millis() - begun) < 100)
-        {
-            while (NEXTION.available())
-            {
-                uint8_t b = NEXTION.read();
-                if (k < MAXTEXTIN)
-                    TextIn[k++] = b;
-                if (b == 0xFF)
-                {
-                    if (++ffs >= 3)
-                    {
-                        done = true;
-                        break;
-                    }
-                }
-                else
-                    ffs = 0;
-            }
-            KickTheDog();
-        }
-    }
-
-    if (TextIn[0] == 'p')
-    {
-        while (TextIn[j + 1] < 0xFF && j < MAXTEXTIN - 2 && j < maxlen - 1)
-        {   // ClaudeFix-2-7-2026 maxlen: the reply lands in CALLER buffers as small as 10 bytes
-            // ("There better be room!" -- now there is)
-            TheText[j] = TextIn[j + 1];
-            ++j;
-            KickTheDog(); // ??
-        }
-        TheText[j] = 0;
+    // ClaudeFix-2-7-2026 Stale bytes from earlier traffic (especially after heavy MSP work on the Rotorflight screens) used
+    // to be parsed as THIS field's reply, so field N's answer became field N+1's value. That is exactly how ArmingChannel
+    // "mysteriously" changed. The parser now frames every reply and only accepts the one that was asked for.
+    RequestNextionReply(CB, 'p');
+    if (AwaitNextionReply(NEXTIONREPLYTIMEOUT))
+    {   // ClaudeFix-2-7-2026 maxlen: the reply lands in CALLER buffers as small as 10 bytes
+        strncpy(TheText, NextionReply, maxlen - 1);
+        TheText[maxlen - 1] = 0;
     }
     return strlen(TheText);
 }
@@ -408,174 +779,29 @@ uint16_t GetText(char *TextBoxName, char *TheText, uint16_t maxlen)
 int GetOtherValue(char *nbox)
 {
     // don't add .val as other thingy is already there ...
-    double ValueIn = 0;
     char GET[] = "get ";
     char CB[100];
     strcpy(CB, GET);
     strcat(CB, nbox);
-    StashPendingEventBytes(); // ClaudeFix-14-7-2026 rescue any waiting button press, don't flush it
-    TextIn[0] = 0;
-    NEXTION.print(CB);
-    EndSend();
-    {
-        uint32_t begun = millis();
-        uint16_t k = 0;
-        uint8_t ffs = 0;
-        bool done = false;
-        while (!done && (millis() - begun) < 100)
-        {
-            while (NEXTION.available())
-            {
-                uint8_t b = NEXTION.read();
-                if (k < MAXTEXTIN)
-                    TextIn[k++] = b;
-                if (b == 0xFF)
-                {
-                    if (++ffs >= 3)
-                    {
-                        done = true;
-                        break;
-                    }
-                }
-                else
-                    ffs = 0;
-            }
-            KickTheDog();
-        }
-        // ClaudeFix-14-7-2026 A touch event that arrived just before the reply sits IN FRONT
-        // of the 8-byte 'q' frame. Rescue it and realign -- otherwise the read
-        // "fails" (65535), GetValue retries 25x with flushes, and the press dies.
-        if (done && k > 8)
-        {
-            StashPrintableBytes((char *)TextIn, k - 8);
-            memmove(TextIn, TextIn + (k - 8), 8);
-        }
-    }
-    if (TextIn[0] == 'q')
-    {
-        ValueIn = TextIn[1]; // Collect and build 32 bit value from 4 bytes
-        ValueIn += (TextIn[2] << 8);
-        ValueIn += (TextIn[3] << 16);
-        ValueIn += (TextIn[4] << 24);
-    }
-    return ValueIn;
-}
-
-// ******************************************************************************************************************************
-static inline void NextionTerminator()
-{
-    NEXTION.write(0xFF);
-    NEXTION.write(0xFF);
-    NEXTION.write(0xFF);
-}
-
-// ******************************************************************************************************************************
-static void FlushNextionInput(uint32_t ms = 30)
-{
-    uint32_t start = millis();
-    while (millis() - start < ms)
-    {
-        while (NEXTION.available())
-            (void)NEXTION.read();
-        delay(1);
-        KickTheDog();
-    }
+    RequestNextionReply(CB, 'q');
+    if (!AwaitNextionReply(NEXTIONREPLYTIMEOUT))
+        return 0;
+    return NextionReplyNumber();
 }
 
-// ******************************************************************************************************************************
-static bool ReadNextionNumber(int32_t &out, uint32_t timeout_ms)
-{
-    uint32_t start = millis();
-
-    // wait for 0x71
-    while (millis() - start < timeout_ms)
-    {
-        if (NEXTION.available())
-        {
-            if ((uint8_t)NEXTION.read() == 0x71)
-                break;
-        }
-        delay(1);
-        KickTheDog();
-    }
-    if (millis() - start >= timeout_ms)
-        return false;
-
-    uint8_t b[4];
-    for (int i = 0; i < 4; i++)
-    {
-        uint32_t t0 = millis();
-        while (!NEXTION.available())
-        {
-            if (millis() - t0 > timeout_ms)
-                return false;
-            delay(1);
-            KickTheDog();
-        }
-        b[i] = (uint8_t)NEXTION.read();
-    }
-
-    out = (int32_t)((uint32_t)b[0] |
-                    ((uint32_t)b[1] << 8) |
-                    ((uint32_t)b[2] << 16) |
-                    ((uint32_t)b[3] << 24));
-    return true;
-}
 // ******************************************************************************************************************************
 int GetIntFromTextBox(char *tbox)
 {
-    char get[] = "get ";
-    char _txt[] = ".txt";
-    char CB[100];
-    uint8_t j = 0;
     char Text[50];
-    strcpy(CB, get);
-    strcat(CB, tbox);
-    strcat(CB, _txt);
-    NEXTION.print(CB);
-    EndSend();
-    GetTextIn();
-    if (TextIn[0] == 'p')
-    {
-        while (TextIn[j + 1] < 0xFF && j < sizeof(Text) - 1) // ClaudeFix-2-7-2026 bounded: a fragment reply used to copy forever (uint8_t j wraps, smashing the stack past Text[50])
-        {
-            Text[j] = TextIn[j + 1];
-            ++j;
-            KickTheDog(); // ??
-        }
-        Text[j] = 0;
-
-        return atoi(Text);
-    }
-    return 0;
+    GetText(tbox, Text, sizeof(Text));
+    return atoi(Text);
 }
 // ******************************************************************************************************************************
 float GetFloatFromTextBox(char *tbox)
 {
-    char get[] = "get ";
-    char _txt[] = ".txt";
-    char CB[100];
-    uint8_t j = 0;
     char Text[50];
-    strcpy(CB, get);
-    strcat(CB, tbox);
-    strcat(CB, _txt);
-    NEXTION.print(CB);
-    EndSend();
-    GetTextIn();
-    if (TextIn[0] == 'p')
-    {
-        while (TextIn[j + 1] < 0xFF && j < sizeof(Text) - 1) // ClaudeFix-2-7-2026 bounded: a fragment reply used to copy forever (uint8_t j wraps, smashing the stack past Text[50])
-        {
-            Text[j] = TextIn[j + 1];
-            ++j;
-            KickTheDog(); // ??
-        }
-        Text[j] = 0;
-
-        return atof(Text);
-    }
-    return 0;
+    GetText(tbox, Text, sizeof(Text));
+    return atof(Text);
 }
 
 // ******************************************************************************************************************************
@@ -593,25 +819,18 @@ bool NextionFileExistsOnSD(char *filename, bool verbose = false)
         Look(path);
     }
 
-    FlushNextionInput(50);
-
-    NEXTION.print("findfile \"");
-    NEXTION.print(path);
-    NEXTION.print("\",sys0");
-    NextionTerminator();
-
-    delay(10);
-
-    NEXTION.print("get sys0");
-    NextionTerminator();
-
-    int32_t v = 0;
-    if (!ReadNextionNumber(v, 500))
+    char FindFile[120];
+    char GetSys0[] = "get sys0";
+    snprintf(FindFile, sizeof(FindFile), "findfile \"%s\",sys0", path);
+    SendCommand(FindFile);
+    RequestNextionReply(GetSys0, 'q');
+    if (!AwaitNextionReply(500))
     {
         if (verbose)
             Look("  read sys0 FAILED.");
         return false;
     }
+    int32_t v = (int32_t)NextionReplyNumber();
 
     if (verbose)
     {
@@ -620,6 +839,73 @@ bool NextionFileExistsOnSD(char *filename, bool verbose = false)
     }
     return (v != 0);
 }
+/*********************************************************************************************************************************/
+// Drops every touch event and part message received so far (e.g. garbage received at a wrong baud rate).
+void ForgetNextionInput()
+{
+    PumpNextionInput();
+    NextionParserState = NEXTIONIDLE;
+    NextionEventRingHead = 0;
+    NextionEventStart = 0;
+    NextionEventsIn = 0;
+    NextionEventsOut = 0;
+    NextionReplyAwaited = 0;
+    NextionReplyReady = false;
+}
+
+/*********************************************************************************************************************************/
+bool NextionAnswersAt(uint32_t Baud)
+{
+    char GetDim[] = "get dim";
+    FlushNextionQueue();
+    NEXTION.begin(Baud);
+    QueueNextionTerminator(); // ends any half command left by garbage sent at a wrong rate
+    RequestNextionReply(GetDim, 'q');
+    return AwaitNextionReply(NEXTIONPROBETIMEOUT);
+}
+
+/*********************************************************************************************************************************/
+uint32_t FindNextionBaud()
+{
+    const uint32_t Rates[] = {NEXTIONMAXBAUD, 512000, 256000, 230400, 115200, 57600, 38400, 19200, 9600};
+    for (uint8_t i = 0; i < sizeof(Rates) / sizeof(Rates[0]); ++i)
+    {
+        if (NextionAnswersAt(Rates[i]))
+            return Rates[i];
+    }
+    return 0;
+}
+
+/*********************************************************************************************************************************/
+// The display's program normally sets NEXTIONMAXBAUD itself. If it doesn't (an older .tft, or a factory reset) we find
+// whatever rate it does answer at and ask it to go faster. If it won't, we stay at the rate that works.
+FLASHMEM void StartNextionLink()
+{
+    char Faster[20];
+    NextionBaud = FindNextionBaud();
+    if (NextionBaud && NextionBaud < NEXTIONMAXBAUD)
+    {
+        snprintf(Faster, sizeof(Faster), "baud=%lu", (unsigned long)NEXTIONMAXBAUD);
+        SendCommand(Faster);
+        FlushNextionQueue();
+        DelayWithDog(NEXTIONBAUDCHANGEWAIT);
+        if (NextionAnswersAt(NEXTIONMAXBAUD))
+            NextionBaud = NEXTIONMAXBAUD;
+        else
+            NextionBaud = FindNextionBaud(); // fall back to whatever it now uses
+    }
+    if (!NextionBaud)
+    {
+        NextionBaud = NEXTIONMAXBAUD; // no answer at all. Carry on as before.
+        NEXTION.begin(NextionBaud);
+    }
+    ForgetNextionInput();
+#ifdef DB_NEXTION
+    Look1("Nextion baud rate: ");
+    Look(NextionBaud);
+#endif
+}
+
 /*********************************************************************************************************************************/
 //             END OF NEXTION FUNCTIONS
 /*********************************************************************************************************************************/
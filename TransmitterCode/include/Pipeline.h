@@ -0,0 +1,80 @@
+// *************************************** Pipeline.h *****************************************
+
+// Incremental evaluation of the channel pipeline. Each pass GetDirtyOutputs() says which channels' curves must be
+// recomputed; the rest reuse CurveCache[]. test/PipelineTest.cpp checks that this always gives the same outputs as
+// recomputing every channel.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/*********************************************************************************************************************************/
+// Dependency graph for incremental evaluation. CurveDeps[ch] has one BIT for every channel whose (pre-mix) input
+// can reach channel ch's curve through the input mixes of the current bank. Built in the same order as MixInputs()
+// so that chained mixes propagate.
+void BuildPipelineDependencies()
+{
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+        CurveDeps[ch] = 1 << ch;
+    for (short MixNumber = 1; MixNumber < MAXMIXES; ++MixNumber)
+    {
+        if (!Mixes[MixNumber][M_MIX_INPUTS])
+            continue;
+        if (Mixes[MixNumber][M_Bank] != Bank && Mixes[MixNumber][M_Bank])
+            continue;
+        uint8_t Master = Mixes[MixNumber][M_MasterChannel];
+        uint8_t Slave = Mixes[MixNumber][M_SlaveChannel];
+        if (Master < 1 || Master > CHANNELSUSED || Slave < 1 || Slave > CHANNELSUSED)
+            continue;
+        CurveDeps[Slave - 1] |= CurveDeps[Master - 1];
+    }
+}
+/*********************************************************************************************************************************/
+void InvalidatePipeline()
+{
+    PipelineNeedsFullRefresh = true;
+}
+/*********************************************************************************************************************************/
+// Must be called after GetAllInputs() and BEFORE MixInputs(). Returns a BIT for every channel whose curve needs recomputing.
+// The inputs are already filtered and deadbanded, so any change at all is beyond the noise floor.
+// Bank, rate or model changes, explicit invalidation, and a periodic timer all force a full refresh as a safety net.
+FASTRUN uint16_t GetDirtyOutputs()
+{
+    static uint8_t LastBank = 0;
+    static uint8_t LastDualRateValue = 0;
+    static uint32_t LastModelNumber = 0;
+    static uint32_t LastFullRefresh = 0;
+    uint16_t ChangedInputs = 0;
+    uint16_t Dirty = 0;
+
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+    {
+        if (InputsBuffer[ch] != LastRawInputs[ch])
+        {
+            ChangedInputs |= (1 << ch);
+            LastRawInputs[ch] = InputsBuffer[ch];
+        }
+    }
+    if (PipelineNeedsFullRefresh || (Bank != LastBank) || (DualRateValue != LastDualRateValue) || (ModelNumber != LastModelNumber) ||
+        (millis() - LastFullRefresh >= PIPELINEFULLREFRESH))
+    {
+        LastBank = Bank;
+        LastDualRateValue = DualRateValue;
+        LastModelNumber = ModelNumber;
+        LastFullRefresh = millis();
+        PipelineNeedsFullRefresh = false;
+        BuildPipelineDependencies();
+        BuildSlowedChannels();
+        return 0xFFFF;
+    }
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+    {
+        if (CurveDeps[ch] & ChangedInputs)
+            Dirty |= (1 << ch);
+    }
+    return Dirty;
+}
+
+#endif
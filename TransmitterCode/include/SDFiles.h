@@ -9,7 +9,6 @@
 #ifndef SD_FILES_H
 #define SD_FILES_H
 
-#define TINYCARD SD
 
 
 
@@ -36,6 +35,7 @@ void AddPath(char *filename)
 /****************************************************************************************************************************/
 File OpenTextFileForReading()
 {
+    FlushLogRing(true); // Any log lines still in RAM go to the file before it's read
     AddPath(TextFileName);
     File fnumber = TINYCARD.open(SearchFile, FILE_READ);
     if (fnumber)
@@ -45,11 +45,13 @@ File OpenTextFileForReading()
 /************************************************************************************************************/
 FASTRUN void OpenLogFileW()
 {
-    if (!LogFileOpen)
+    if (!LogWriteFileOpen)
     {
-        AddPath(TextFileName);
-        LogFileNumber = TINYCARD.open(SearchFile, FILE_WRITE);
-        LogFileOpen = true;
+        AddPath(LogWriteFileName);
+        LogWriteFile = TINYCARD.open(SearchFile, FILE_WRITE);
+        LogWriteFileOpen = (bool)LogWriteFile;
+        LogWriteOffset = LogWriteFileOpen ? LogWriteFile.size() : 0;
+        NoteFileAdded(LogWriteFileName); // (it may be new today)
     }
 }
 /************************************************************************************************************/
@@ -57,6 +59,7 @@ FASTRUN void DeleteLogFile()
 {
     AddPath(TextFileName);
     TINYCARD.remove(SearchFile);
+    NoteFileRemoved(TextFileName);
 }
 /******************************************************************************************************************************/
 
@@ -73,8 +76,10 @@ void DeleteThisLogFile()
     strcat(pprompt, Query);
     if (GetConfirmation(pLogFiles, pprompt))
     {
+        CloseLogWriter(); // (it may be today's log)
         AddPath(TextFileName);
         TINYCARD.remove(SearchFile);
+        NoteFileRemoved(TextFileName);
         strcpy(MOD, ".LOG");
         BuildDirectory();
         strcpy(Mfiles, "FilesBox");
@@ -102,17 +107,19 @@ void WriteEntireBuffer()
 {
     ModelsFileNumber.close();
     CloseModelsFile();
-    for (int i = 0; i < 3; ++i)
+    RemoveBackup(SingleModelFile); // The file received replaces any backup of that name
+    AddPath(SingleModelFile);
+    ModelsFileNumber = TINYCARD.open(SearchFile, FILE_WRITE);
+    if (!ModelsFileNumber)
     {
-        AddPath(SingleModelFile);
-        ModelsFileNumber = TINYCARD.open(SearchFile, FILE_WRITE);
-        ModelsFileNumber.seek(0);
-        ShortishDelay();
-        ModelsFileNumber.write(NewFileBuffer, NewFileBufferPointer);
-        ShortishDelay();
-        ModelsFileNumber.close();
-        ShortishDelay();
+        FileError = true;
+        return;
     }
+    ModelsFileNumber.truncate(0);
+    if (ModelsFileNumber.write(NewFileBuffer, NewFileBufferPointer) != NewFileBufferPointer)
+        FileError = true;
+    ModelsFileNumber.close();
+    NoteFileAdded(SingleModelFile);
 }
 
 /******************************************************************************************************************************/
@@ -187,15 +194,13 @@ void RenameFile()
             if (GetConfirmation(pModelsView, Prompt))
             {
                 WriteBackup();
-                AddPath(Deleteable);
-                TINYCARD.remove(SearchFile); // ClaudeFix-2-7-2026 backups live in /mod/ -- a bare name removed nothing, leaving both files
+                DeleteModelBackup(Deleteable); // ClaudeFix-2-7-2026 backups live in /mod/ -- a bare name removed nothing, leaving both files
             }
         }
         else
         {
             WriteBackup();
-            AddPath(Deleteable);
-            TINYCARD.remove(SearchFile);
+            DeleteModelBackup(Deleteable);
         }
     }
     strcpy(MOD, ".MOD");
@@ -212,6 +217,8 @@ bool CheckFileExists(char *fl)
     CloseModelsFile();
     bool exists = false;
     File t;
+    if (InStrng((char *)".MOD", fl) && (FindBackup(fl) >= 0))
+        return true;
     AddPath(fl);
     t = TINYCARD.open(SearchFile, FILE_READ);
     if (t)
@@ -262,6 +269,9 @@ void CheckSDCard()
     } else{
         SD_Card_Exists = true;
     }
+    ForgetDirectories(); // Read them again when they're next listed
+    ForgetBackupStore();
+    ForgetFlightSummaries();
 }
 // *********************************************************************************************************************************/
 void DeleteMODfile(int p)
@@ -283,8 +293,7 @@ void DeleteMODfile(int p)
     strcat(prompt, ques);
     if (GetConfirmation(pModelsView, prompt))
     {
-        AddPath(SingleModelFile);
-        TINYCARD.remove(SearchFile);
+        DeleteModelBackup(SingleModelFile);
         strcpy(MOD, ".MOD");
         BuildDirectory();
         strcpy(Mfiles, "Mfiles");
@@ -295,44 +304,4 @@ void DeleteMODfile(int p)
     CloseModelsFile();
     ClearText();
 }
-/*********************************************************************************************************************************/
-void BuildDirectory() 
-{
-    char Entry1[30];
-    char fn[20];
-    int i = 0;
-    File dir; // note: ClaudeFix-2-7-2026 left default if MOD matches nothing -- the openNextFile loop below just yields nothing then
-
-    if ((strcmp(MOD, ".LOG") == 0))
-        dir = TINYCARD.open("/log/");
-    if ((strcmp(MOD, ".TXT") == 0))
-        dir = TINYCARD.open("/help/");
-    if ((strcmp(MOD, ".MOD") == 0))
-        dir = TINYCARD.open("/mod/");
-    if ((strcmp(MOD, ".jpg") == 0)){
-        dir = TINYCARD.open("/Images/");
-    }
-
-    ExportedFileCounter = 0;
-    while (true)
-    {
-        File entry = dir.openNextFile();
-        if (!entry || ExportedFileCounter > MAXBACKUPFILES)
-            break;
-        strncpy(Entry1, entry.name(), sizeof(Entry1) - 1); // ClaudeFix-2-7-2026 SD long filenames can be 255 chars -- strcpy smashed the 30-byte stack buffer
-        Entry1[sizeof(Entry1) - 1] = 0;
-        if ((InStrng(MOD, Entry1) > 0) && (!InStrng((char *)"._", Entry1)))
-        {
-            strncpy(fn, entry.name(), sizeof(fn) - 1);
-            fn[sizeof(fn) - 1] = 0;
-            for (i = 0; i < 12; ++i)
-            {
-                TheFilesList[ExportedFileCounter][i] = fn[i];   
-            }
-            ExportedFileCounter++;
-        }
-        entry.close();
-    }
-    SortDirectory();
-}
 #endif // SD_FILES_H
\ No newline at end of file
@@ -122,6 +122,184 @@ void CheckServoSpeeds()
     }
 }
 
+/*********************************************************************************************************************************/
+// Default values for everything in one section. SetDefaultValues() uses them all for a new model, and ReadOneModel() uses
+// them for any section that a model doesn't have.
+
+void SetSectionDefaults(uint8_t ID)
+{
+    uint16_t j = 0;
+    uint16_t i = 0;
+    char DefaultChannelNames[CHANNELSUSED][11] = {{"Aileron"}, {"Elevator"}, {"Throttle"}, {"Rudder"}, {"Ch 5"}, {"Ch 6"}, {"Ch 7"}, {"Ch 8"}, {"Ch 9"}, {"Ch 10"}, {"Ch 11"}, {"Ch 12"}, {"Ch 13"}, {"Ch 14"}, {"Ch 15"}, {"Ch 16"}};
+
+    switch (ID)
+    {
+    case MSEC_CURVES:
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            for (j = 1; j <= 4; ++j)
+            {
+                MaxDegrees[j][i] = 150;
+                MidHiDegrees[j][i] = 120;
+                CentreDegrees[j][i] = 90;
+                MidLowDegrees[j][i] = 60;
+                MinDegrees[j][i] = 30;
+            }
+        }
+        break;
+
+    case MSEC_MIXES:
+        for (j = 0; j < MAXMIXES; ++j)
+        {
+            for (i = 0; i < CHANNELSUSED; ++i)
+            {
+                Mixes[j][i] = 0;
+            }
+        }
+        break;
+
+    case MSEC_TRIMS:
+        for (j = 0; j < BANKS_USED + 1; ++j)
+        { // must have fudged this somewhere.... Probably 1-5 instead of 0-4
+            for (i = 0; i < CHANNELSUSED; ++i)
+            {
+                Trims[j][i] = 80; // MIDPOINT is 80 !
+            }
+        }
+        for (j = 0; j < 4; ++j)
+        {
+            for (i = 0; i < 16; ++i)
+            {
+                ServoSpeed[j][i] = 100;
+            }
+        }
+        break;
+
+    case MSEC_SETTINGS:
+        RXCellCount = 3;
+        TrimMultiplier = 5;
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            SubTrims[i] = 127; // centre (0 - 254)
+            InPutStick[i] = i;
+        }
+        ReversedChannelBITS = 0; //  No channel reversed
+        for (i = 0; i < 4; ++i)
+        {
+            InputTrim[i] = i;
+            DualRateRate[i] = 0;
+        }
+        RxVoltageCorrection = 0;
+        ArmingChannel = 6; // for Rotorflight
+        GearRatio = 10.3;  // for helicopters with swash plates. This is the ratio between servo movement and blade pitch change. 10.3 is a typical value for a 700 size heli
+        break;
+
+    case MSEC_CHANNELS:
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            FailSafeChannel[i] = false;
+            for (j = 0; j < 10; ++j)
+            {
+                ChannelNames[i][j] = DefaultChannelNames[i][j];
+            }
+        }
+        break;
+
+    case MSEC_EXPO:
+        for (j = 1; j <= BANKS_USED; ++j)
+        {
+            for (i = 0; i < CHANNELSUSED; ++i)
+            {
+                Exponential[j][i] = DEFAULT_EXPO; // 0% (50) expo = default
+            }
+        }
+        for (j = 1; j <= BANKS_USED; ++j) // ClaudeFix-2-7-2026 banks are 1-based at runtime (matches the Exponential loop above); 0..3 left bank 4 inheriting the previous model's curve types
+        {
+            for (i = 0; i < CHANNELSUSED; ++i)
+            {
+                InterpolationTypes[j][i] = EXPONENTIALCURVES; // Expo is default
+            }
+        }
+        break;
+
+    case MSEC_MACROS:
+        for (j = 0; j < BYTESPERMACRO; ++j)
+        {
+            for (i = 0; i < MAXMACROS; ++i)
+            {
+                MacrosBuffer[i][j] = 0;
+            }
+        }
+        break;
+
+    case MSEC_MODELID:
+        ModelsMacUnionSaved.Val64 = 0;
+        break;
+
+    case MSEC_OUTPUTS:
+        if (CurrentView == CALIBRATEVIEW)
+        {
+            UseMotorKill = false;
+            MotorChannelZero = 50;
+            MotorChannel = 15;
+        }
+        else
+        {
+            UseMotorKill = true;
+            MotorChannelZero = 30;
+            MotorChannel = 2;
+        }
+        Drate1 = 100;
+        Drate2 = 75;
+        Drate3 = 50;
+        DualRateChannels[0] = 1;
+        DualRateChannels[1] = 2;
+        DualRateChannels[2] = 4;
+        for (i = 3; i < 8; ++i)
+            DualRateChannels[i] = 0;
+        for (i = 0; i < 4; ++i)
+        {
+            BanksInUse[i] = i + 4;
+        }
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            ChannelOutPut[i] = i;
+        }
+        for (i = 0; i < 11; ++i)
+        {
+            ServoFrequency[i] = 50;
+            ServoCentrePulse[i] = 1500;
+        }
+        break;
+
+    case MSEC_ROTORFLIGHT:
+        for (j = 0; j < 4; ++j)
+        {
+            for (i = 0; i < MAX_PID_WORDS + 5; ++i)
+                Saved_PID_Values[i][j] = 0;
+            for (i = 0; i < MAX_RATES_BYTES; ++i)
+                Saved_Rate_Values[i][j] = 0;
+            for (i = 0; i < MAX_RATES_ADVANCED_BYTES; ++i)
+                Saved_Rate_Advanced_Values[i][j] = 0;
+            for (i = 0; i < MAX_PIDS_ADVANCED_BYTES; ++i)
+                Saved_PID_Advanced_Values[i][j] = 0;
+        }
+        strcpy(ModelImageFileName, "Noimage");
+        break;
+
+    case MSEC_BANKS:
+        BankCrossfadeTime = 0; // Banks switch instantly unless asked otherwise
+        for (j = 0; j < 4; ++j)
+        {
+            for (i = 0; i < 16; ++i)
+            {
+                ServoSpeedDown[j][i] = 0;
+            }
+        }
+        break;
+    }
+}
+
 /*********************************************************************************************************************************/
 
 void CheckServoType()
@@ -158,18 +336,21 @@ bool ReadOneModel(uint32_t Mnum)
     if ((ModelNumber > 90) || (ModelNumber <= 0))
         ModelNumber = 1;
 
-    OpenModelsFile();
-
-    if (!ModelsFileOpen)
+    if (!ModelStoreInUse() && !BackupStoreInUse()) // no SD card file needed when the model store or the backup store has it
     {
-        DelayWithDog(300);
         OpenModelsFile();
-    }
 
-    if (!ModelsFileOpen)
-    {
-        strcpy(ModelName, NoModelYet); // indicator of error or no model
-        return false;
+        if (!ModelsFileOpen)
+        {
+            DelayWithDog(300);
+            OpenModelsFile();
+        }
+
+        if (!ModelsFileOpen)
+        {
+            strcpy(ModelName, NoModelYet); // indicator of error or no model
+            return false;
+        }
     }
 
     SDCardAddress = TXSIZE;
@@ -177,10 +358,16 @@ bool ReadOneModel(uint32_t Mnum)
         SDCardAddress = 0; // MODELOFFSET;   // Changed from 250 to 0
     SDCardAddress += ((Mnum - 1) * MODELSIZE);
     StartLocation = SDCardAddress;
+#ifdef DB_SD
+    uint32_t SDTimer = micros();
+#endif
+    LoadSDBlock(StartLocation, MODELSIZE);
+    ReadModelDirectory(); // Checks every section's CRC32 (older files have no directory)
     ModelDefined = SDRead8BITS(SDCardAddress);
     ++SDCardAddress;
     if (ModelDefined != 42)
     {
+        ForgetSDBlock();
         // ClaudeFix-14-7-2026 slot never written (reads past EOF as 255): present it as free.
         // Without this the PREVIOUS model's name stayed in ModelName, so the
         // models list repeated the last real model all the way down.
@@ -194,331 +381,424 @@ bool ReadOneModel(uint32_t Mnum)
         ++SDCardAddress;
     }
 
-    for (i = 0; i < CHANNELSUSED; ++i)
+    if (!SeekModelSection(MSEC_CURVES))
+        SetSectionDefaults(MSEC_CURVES);
+    else
     {
-        for (j = 1; j <= 4; ++j)
+        for (i = 0; i < CHANNELSUSED; ++i)
         {
-            MaxDegrees[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
-            MidHiDegrees[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
-            CentreDegrees[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
-            MidLowDegrees[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
-            MinDegrees[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
+            for (j = 1; j <= 4; ++j)
+            {
+                MaxDegrees[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+                MidHiDegrees[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+                CentreDegrees[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+                MidLowDegrees[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+                MinDegrees[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
         }
     }
-    for (j = 0; j < MAXMIXES; ++j)
+    if (!SeekModelSection(MSEC_MIXES))
+        SetSectionDefaults(MSEC_MIXES);
+    else
     {
-        for (i = 0; i < CHANNELSUSED + 1; ++i)
+        for (j = 0; j < MAXMIXES; ++j)
         {
-            Mixes[j][i] = SDRead8BITS(SDCardAddress); // Read mixes
-            ++SDCardAddress;
+            for (i = 0; i < CHANNELSUSED + 1; ++i)
+            {
+                Mixes[j][i] = SDRead8BITS(SDCardAddress); // Read mixes
+                ++SDCardAddress;
+            }
+            // ClaudeFix-2-7-2026 A mix is only usable when BOTH channels are 1..16 -- a corrupt slave
+            // wrote SendBuffer[-1] (or far beyond) every loop. Disable junk mixes.
+            if (Mixes[j][M_MasterChannel] > 16 || Mixes[j][M_SlaveChannel] > 16 || Mixes[j][M_SlaveChannel] == 0)
+                Mixes[j][M_MasterChannel] = 0;
         }
-        // ClaudeFix-2-7-2026 A mix is only usable when BOTH channels are 1..16 -- a corrupt slave
-        // wrote SendBuffer[-1] (or far beyond) every loop. Disable junk mixes.
-        if (Mixes[j][M_MasterChannel] > 16 || Mixes[j][M_SlaveChannel] > 16 || Mixes[j][M_SlaveChannel] == 0)
-            Mixes[j][M_MasterChannel] = 0;
     }
 
-    for (j = 0; j < BANKS_USED + 1; ++j)
+    if (!SeekModelSection(MSEC_TRIMS))
+        SetSectionDefaults(MSEC_TRIMS);
+    else
     {
-        for (i = 0; i < CHANNELSUSED + 1; ++i)
+        for (j = 0; j < BANKS_USED + 1; ++j)
         {
-            Trims[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
+            for (i = 0; i < CHANNELSUSED + 1; ++i)
+            {
+                Trims[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
         }
-    }
-    for (j = 0; j < BANKS_USED + 1; ++j)
-    {
-        for (i = 0; i < CHANNELSUSED + 1; ++i)
+        for (j = 0; j < BANKS_USED + 1; ++j)
         {
-            ServoSpeed[j][i] = SDRead8BITS(SDCardAddress);
-            ++SDCardAddress;
+            for (i = 0; i < CHANNELSUSED + 1; ++i)
+            {
+                ServoSpeed[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
         }
+        CheckServoSpeeds();
     }
-    CheckServoSpeeds();
-    RXCellCount = SDRead8BITS(SDCardAddress);
-    if (RXCellCount < 1 || RXCellCount > 12)
-        RXCellCount = 2; // ClaudeFix-2-7-2026 divisor -- 0 made volts-per-cell infinite
-    ++SDCardAddress;
-    TrimMultiplier = SDRead16BITS(SDCardAddress);
-    TrimMultiplier = CheckRange(TrimMultiplier, 0, 25);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    // ClaudeFix-16-7-2026 LowBattery byte lives in every model file, but the user sets it
-    // ONCE on the transmitter-settings screen and expects it to be global —
-    // every model load was silently reverting it to that model's old value
-    // (the "low-battery warning mysteriously stopped" bug). Load it from the
-    // BOOT model only; after that the in-RAM value rules, and every model
-    // save stamps it back, so the files converge to the latest setting.
+    if (!SeekModelSection(MSEC_SETTINGS))
+        SetSectionDefaults(MSEC_SETTINGS);
+    else
     {
-        static bool LowBatteryLoaded = false;
-        uint8_t lb = SDRead8BITS(SDCardAddress);
-        if (!LowBatteryLoaded) {
-            LowBatteryLoaded = true;
-            LowBattery = (lb > 100 || lb < 10) ? LOWBATTERY : lb;
+        RXCellCount = SDRead8BITS(SDCardAddress);
+        if (RXCellCount < 1 || RXCellCount > 12)
+            RXCellCount = 2; // ClaudeFix-2-7-2026 divisor -- 0 made volts-per-cell infinite
+        ++SDCardAddress;
+        TrimMultiplier = SDRead16BITS(SDCardAddress);
+        TrimMultiplier = CheckRange(TrimMultiplier, 0, 25);
+        ++SDCardAddress;
+        ++SDCardAddress;
+        // ClaudeFix-16-7-2026 LowBattery byte lives in every model file, but the user sets it
+        // ONCE on the transmitter-settings screen and expects it to be global —
+        // every model load was silently reverting it to that model's old value
+        // (the "low-battery warning mysteriously stopped" bug). Load it from the
+        // BOOT model only; after that the in-RAM value rules, and every model
+        // save stamps it back, so the files converge to the latest setting.
+        {
+            static bool LowBatteryLoaded = false;
+            uint8_t lb = SDRead8BITS(SDCardAddress);
+            if (!LowBatteryLoaded) {
+                LowBatteryLoaded = true;
+                LowBattery = (lb > 100 || lb < 10) ? LOWBATTERY : lb;
+            }
         }
-    }
-    ++SDCardAddress;
-    CopyTrimsToAll = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        SubTrims[i] = SDRead8BITS(SDCardAddress);
-        if ((SubTrims[i] < 10) || (SubTrims[i] > 244))
-            SubTrims[i] = 127; // centre if undefined or zero
         ++SDCardAddress;
-    }
-    ReversedChannelBITS = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    for (i = 0; i < 4; ++i)
-    {
-        InputTrim[i] = SDRead8BITS(SDCardAddress);
+        CopyTrimsToAll = SDRead8BITS(SDCardAddress);
         ++SDCardAddress;
-    }
-    RxVoltageCorrection = SDRead16BITS(SDCardAddress);
 
-    ++SDCardAddress;
-    ++SDCardAddress;
-    CheckSavedTrimValues();
-    BuddyControlled = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    SavedSticksMode = SDRead8BITS(SDCardAddress); // save sticks mode in case of rf transfer
-    ++SDCardAddress;
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        InPutStick[i] = SDRead8BITS(SDCardAddress);
-        if (InPutStick[i] > 16)
-            InPutStick[i] = i; // reset if nothing was saved!
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            SubTrims[i] = SDRead8BITS(SDCardAddress);
+            if ((SubTrims[i] < 10) || (SubTrims[i] > 244))
+                SubTrims[i] = 127; // centre if undefined or zero
+            ++SDCardAddress;
+        }
+        ReversedChannelBITS = SDRead16BITS(SDCardAddress);
         ++SDCardAddress;
-    }
+        ++SDCardAddress;
+        for (i = 0; i < 4; ++i)
+        {
+            InputTrim[i] = SDRead8BITS(SDCardAddress);
+            ++SDCardAddress;
+        }
+        RxVoltageCorrection = SDRead16BITS(SDCardAddress);
 
-    for (i = 0; i < 4; ++i)
-    {
-        DualRateRate[i] = SDRead8BITS(SDCardAddress);
-        if (DualRateRate[i] > 3)
-            DualRateRate[i] = 0;
         ++SDCardAddress;
-    }
+        ++SDCardAddress;
+        CheckSavedTrimValues();
+        BuddyControlled = SDRead16BITS(SDCardAddress);
+        ++SDCardAddress;
+        ++SDCardAddress;
+        SavedSticksMode = SDRead8BITS(SDCardAddress); // save sticks mode in case of rf transfer
+        ++SDCardAddress;
 
-    BuddyHasAllSwitches = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
-    GearRatio = SDReadFLOAT(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    ++SDCardAddress;
-    ++SDCardAddress;
-    ArmingChannel = SDRead8BITS(SDCardAddress);
-    if (ArmingChannel < 1 || ArmingChannel > CHANNELSUSED)
-        ArmingChannel = 6; // ClaudeFix-2-7-2026 self-heal: old model files (or ones saved while the
-                           // GetText desync bug was corrupting this) can hold 0 or
-                           // nonsense -- restore the Rotorflight default instead
-    ++SDCardAddress;
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            InPutStick[i] = SDRead8BITS(SDCardAddress);
+            if (InPutStick[i] > 16)
+                InPutStick[i] = i; // reset if nothing was saved!
+            ++SDCardAddress;
+        }
 
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        FailSafeChannel[i] = bool(SDRead8BITS(SDCardAddress));
-        if (int(FailSafeChannel[i]) > 1)
-            FailSafeChannel[i] = 0;
+        for (i = 0; i < 4; ++i)
+        {
+            DualRateRate[i] = SDRead8BITS(SDCardAddress);
+            if (DualRateRate[i] > 3)
+                DualRateRate[i] = 0;
+            ++SDCardAddress;
+        }
+
+        BuddyHasAllSwitches = SDRead8BITS(SDCardAddress);
+        ++SDCardAddress;
+        GearRatio = SDReadFLOAT(SDCardAddress);
+        ++SDCardAddress;
+        ++SDCardAddress;
+        ++SDCardAddress;
+        ++SDCardAddress;
+        ArmingChannel = SDRead8BITS(SDCardAddress);
+        if (ArmingChannel < 1 || ArmingChannel > CHANNELSUSED)
+            ArmingChannel = 6; // ClaudeFix-2-7-2026 self-heal: old model files (or ones saved while the
+                               // GetText desync bug was corrupting this) can hold 0 or
+                               // nonsense -- restore the Rotorflight default instead
         ++SDCardAddress;
     }
-    for (i = 0; i < CHANNELSUSED; ++i)
+
+    if (!SeekModelSection(MSEC_CHANNELS))
+        SetSectionDefaults(MSEC_CHANNELS);
+    else
     {
-        for (j = 0; j < 10; ++j)
+        for (i = 0; i < CHANNELSUSED; ++i)
         {
-            ChannelNames[i][j] = SDRead8BITS(SDCardAddress);
+            FailSafeChannel[i] = bool(SDRead8BITS(SDCardAddress));
+            if (int(FailSafeChannel[i]) > 1)
+                FailSafeChannel[i] = 0;
             ++SDCardAddress;
         }
+        for (i = 0; i < CHANNELSUSED; ++i)
+        {
+            for (j = 0; j < 10; ++j)
+            {
+                ChannelNames[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
+        }
     }
 
-    for (j = 0; j < BANKS_USED + 1; ++j)
+    if (!SeekModelSection(MSEC_EXPO))
+        SetSectionDefaults(MSEC_EXPO);
+    else
     {
-        for (i = 0; i < CHANNELSUSED + 1; ++i)
+        for (j = 0; j < BANKS_USED + 1; ++j)
         {
-            Exponential[j][i] = SDRead8BITS(SDCardAddress);
-            if (Exponential[j][i] >= 201 || Exponential[j][i] == 0)
+            for (i = 0; i < CHANNELSUSED + 1; ++i)
             {
-                Exponential[j][i] = DEFAULT_EXPO;
+                Exponential[j][i] = SDRead8BITS(SDCardAddress);
+                if (Exponential[j][i] >= 201 || Exponential[j][i] == 0)
+                {
+                    Exponential[j][i] = DEFAULT_EXPO;
+                }
+                ++SDCardAddress;
+            }
+        }
+        for (j = 0; j < BANKS_USED + 1; ++j)
+        {
+            for (i = 0; i < CHANNELSUSED + 1; ++i)
+            {
+                InterpolationTypes[j][i] = SDRead8BITS(SDCardAddress);
+                if (InterpolationTypes[j][i] < 0 || InterpolationTypes[j][i] > 2)
+                {
+                    InterpolationTypes[j][i] = EXPONENTIALCURVES;
+                }
+                ++SDCardAddress;
             }
-            ++SDCardAddress;
         }
     }
-    for (j = 0; j < BANKS_USED + 1; ++j)
+    if (!SeekModelSection(MSEC_MACROS))
+        SetSectionDefaults(MSEC_MACROS);
+    else
     {
-        for (i = 0; i < CHANNELSUSED + 1; ++i)
+        for (j = 0; j < BYTESPERMACRO; ++j)
         {
-            InterpolationTypes[j][i] = SDRead8BITS(SDCardAddress);
-            if (InterpolationTypes[j][i] < 0 || InterpolationTypes[j][i] > 2)
+            for (i = 0; i < MAXMACROS; ++i)
             {
-                InterpolationTypes[j][i] = EXPONENTIALCURVES;
+                MacrosBuffer[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
             }
-            ++SDCardAddress;
         }
     }
-    for (j = 0; j < BYTESPERMACRO; ++j)
+    if (!SeekModelSection(MSEC_MODELID))
+        SetSectionDefaults(MSEC_MODELID);
+    else
     {
-        for (i = 0; i < MAXMACROS; ++i)
+    #ifdef DB_SD
+        if (SDCardAddress - StartLocation != MODELIDOFFSET)
+            Serial.println("MODELIDOFFSET doesn't match the model layout!");
+    #endif
+        for (i = 0; i < 8; ++i)
         {
-            MacrosBuffer[i][j] = SDRead8BITS(SDCardAddress);
+            ModelsMacUnionSaved.Val8[i] = SDRead8BITS(SDCardAddress);
             ++SDCardAddress;
         }
     }
-    for (i = 0; i < 8; ++i)
+    if (!SeekModelSection(MSEC_OUTPUTS))
+        SetSectionDefaults(MSEC_OUTPUTS);
+    else
     {
-        ModelsMacUnionSaved.Val8[i] = SDRead8BITS(SDCardAddress);
+        UseMotorKill = SDRead8BITS(SDCardAddress);
         ++SDCardAddress;
-    }
-    UseMotorKill = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
-    MotorChannelZero = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
-    MotorChannel = SDRead8BITS(SDCardAddress);
-    if (MotorChannel > 15)
-        MotorChannel = 2; // ClaudeFix-2-7-2026 self-heal like ArmingChannel: a corrupt byte made FixMotorChannel write OOB every loop pass
-    ++SDCardAddress;
-
-    // TREX
-    ++SDCardAddress;
-
-    SFV = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    StopFlyingVoltsPerCell = float(SFV) / 100;
-    // if (StopFlyingVoltsPerCell < 3 || StopFlyingVoltsPerCell > 4)
-    //     StopFlyingVoltsPerCell = 3.50; // a useful default stop time?!
-    Drate2 = SDRead8BITS(SDCardAddress);
-    if ((Drate2 < 10) || (Drate2 > 200))
-        Drate2 = 100;
-    ++SDCardAddress;
-    Drate3 = SDRead8BITS(SDCardAddress);
-    if ((Drate3 < 10) || (Drate3 > 200))
-        Drate3 = 100;
-    ++SDCardAddress;
-    Drate1 = SDRead8BITS(SDCardAddress);
-    if ((Drate1 < 10) || (Drate1 > 200))
-        Drate1 = 100;
-    ++SDCardAddress;
-    for (int i = 0; i < 8; ++i)
-    {
-        DualRateChannels[i] = SDRead8BITS(SDCardAddress);
+        MotorChannelZero = SDRead8BITS(SDCardAddress);
         ++SDCardAddress;
-    }
-    CheckDualRatesValues();
-
-    Max_Safe_Amps = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-
-    for (i = 0; i < 4; ++i)
-    {
-        BanksInUse[i] = SDRead8BITS(SDCardAddress);
-        if (BanksInUse[i] > 31)
-            BanksInUse[i] = i + 4; // ClaudeFix-2-7-2026 BankNames is [32]; corrupt index strcpy'd garbage into a stack buffer on bank change
+        MotorChannel = SDRead8BITS(SDCardAddress);
+        if (MotorChannel > 15)
+            MotorChannel = 2; // ClaudeFix-2-7-2026 self-heal like ArmingChannel: a corrupt byte made FixMotorChannel write OOB every loop pass
         ++SDCardAddress;
-    }
 
-    for (i = 0; i < 12; ++i)
-    {
-        // 12 Spare bytes was 16
+        // TREX
         ++SDCardAddress;
-    }
-    ServoCentrePulse[0] = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
-    ServoFrequency[0] = SDRead16BITS(SDCardAddress);
-    ++SDCardAddress;
-    ++SDCardAddress;
 
-    TimerDownwards = (bool)SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
-    TimerStartTime = SDRead16BITS(SDCardAddress);
-    if (TimerStartTime > 120 * 60)
-        TimerStartTime = 5 * 60;
-    ++SDCardAddress;
-    ++SDCardAddress;
-    ++SDCardAddress; // spare
-                     //  LevelledBank = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress; // spare
-    ++SDCardAddress; // spare
-
-    for (i = 0; i < 16; ++i)
-    {
-        ChannelOutPut[i] = SDRead8BITS(SDCardAddress);
+        SFV = SDRead16BITS(SDCardAddress);
         ++SDCardAddress;
-    }
-    for (int i = 0; i < 11; ++i)
-    {
-        ServoFrequency[i] = SDRead16BITS(SDCardAddress);
         ++SDCardAddress;
+        StopFlyingVoltsPerCell = float(SFV) / 100;
+        // if (StopFlyingVoltsPerCell < 3 || StopFlyingVoltsPerCell > 4)
+        //     StopFlyingVoltsPerCell = 3.50; // a useful default stop time?!
+        Drate2 = SDRead8BITS(SDCardAddress);
+        if ((Drate2 < 10) || (Drate2 > 200))
+            Drate2 = 100;
         ++SDCardAddress;
-        ServoCentrePulse[i] = SDRead16BITS(SDCardAddress);
+        Drate3 = SDRead8BITS(SDCardAddress);
+        if ((Drate3 < 10) || (Drate3 > 200))
+            Drate3 = 100;
         ++SDCardAddress;
+        Drate1 = SDRead8BITS(SDCardAddress);
+        if ((Drate1 < 10) || (Drate1 > 200))
+            Drate1 = 100;
         ++SDCardAddress;
-    }
-
-    for (j = 0; j < 4; ++j)
-    {
-        for (i = 0; i < MAX_PID_WORDS + 5; ++i)
+        for (int i = 0; i < 8; ++i)
         {
-            Saved_PID_Values[i][j] = SDRead16BITS(SDCardAddress);
+            DualRateChannels[i] = SDRead8BITS(SDCardAddress);
             ++SDCardAddress;
+        }
+        CheckDualRatesValues();
+
+        Max_Safe_Amps = SDRead16BITS(SDCardAddress);
+        ++SDCardAddress;
+        ++SDCardAddress;
+
+        for (i = 0; i < 4; ++i)
+        {
+            BanksInUse[i] = SDRead8BITS(SDCardAddress);
+            if (BanksInUse[i] > 31)
+                BanksInUse[i] = i + 4; // ClaudeFix-2-7-2026 BankNames is [32]; corrupt index strcpy'd garbage into a stack buffer on bank change
             ++SDCardAddress;
         }
-        for (i = 0; i < MAX_RATES_BYTES; ++i)
+
+        for (i = 0; i < 12; ++i)
         {
-            Saved_Rate_Values[i][j] = SDRead8BITS(SDCardAddress);
+            // 12 Spare bytes was 16
             ++SDCardAddress;
         }
-        for (i = 0; i < MAX_RATES_ADVANCED_BYTES; ++i)
+        ServoCentrePulse[0] = SDRead16BITS(SDCardAddress);
+        ++SDCardAddress;
+        ++SDCardAddress;
+        ServoFrequency[0] = SDRead16BITS(SDCardAddress);
+        ++SDCardAddress;
+        ++SDCardAddress;
+
+        TimerDownwards = (bool)SDRead8BITS(SDCardAddress);
+        ++SDCardAddress;
+        TimerStartTime = SDRead16BITS(SDCardAddress);
+        if (TimerStartTime > 120 * 60)
+            TimerStartTime = 5 * 60;
+        ++SDCardAddress;
+        ++SDCardAddress;
+        ++SDCardAddress; // spare
+                         //  LevelledBank = SDRead8BITS(SDCardAddress);
+        ++SDCardAddress; // spare
+        ++SDCardAddress; // spare
+
+        for (i = 0; i < 16; ++i)
         {
-            Saved_Rate_Advanced_Values[i][j] = SDRead8BITS(SDCardAddress);
+            ChannelOutPut[i] = SDRead8BITS(SDCardAddress);
             ++SDCardAddress;
         }
-        for (i = 0; i < MAX_PIDS_ADVANCED_BYTES; ++i)
+        for (int i = 0; i < 11; ++i)
         {
-            Saved_PID_Advanced_Values[i][j] = SDRead8BITS(SDCardAddress);
+            ServoFrequency[i] = SDRead16BITS(SDCardAddress);
+            ++SDCardAddress;
+            ++SDCardAddress;
+            ServoCentrePulse[i] = SDRead16BITS(SDCardAddress);
+            ++SDCardAddress;
             ++SDCardAddress;
         }
     }
-    for (i = 0; i < 8; ++i)
+
+    if (!SeekModelSection(MSEC_ROTORFLIGHT))
+        SetSectionDefaults(MSEC_ROTORFLIGHT);
+    else
     {
-        ModelImageFileName[i] = SDRead8BITS(SDCardAddress);
+        for (j = 0; j < 4; ++j)
+        {
+            for (i = 0; i < MAX_PID_WORDS + 5; ++i)
+            {
+                Saved_PID_Values[i][j] = SDRead16BITS(SDCardAddress);
+                ++SDCardAddress;
+                ++SDCardAddress;
+            }
+            for (i = 0; i < MAX_RATES_BYTES; ++i)
+            {
+                Saved_Rate_Values[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
+            for (i = 0; i < MAX_RATES_ADVANCED_BYTES; ++i)
+            {
+                Saved_Rate_Advanced_Values[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
+            for (i = 0; i < MAX_PIDS_ADVANCED_BYTES; ++i)
+            {
+                Saved_PID_Advanced_Values[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
+        }
+        for (i = 0; i < 8; ++i)
+        {
+            ModelImageFileName[i] = SDRead8BITS(SDCardAddress);
+            ++SDCardAddress;
+        }
+        LinkRatesToBanks = SDRead8BITS(SDCardAddress);
         ++SDCardAddress;
-    }
-    LinkRatesToBanks = SDRead8BITS(SDCardAddress);
-    ++SDCardAddress;
 
-    RotorFlight_V = SDRead8BITS(SDCardAddress);
-    // Look(RotorFlight_V);
-    ++SDCardAddress;
+        RotorFlight_V = SDRead8BITS(SDCardAddress);
+        // Look(RotorFlight_V);
+        ++SDCardAddress;
 
-    // Governor profile saved values — 17 bytes x 4 banks = 68 bytes
-    for (j = 0; j < 4; ++j)
-        for (i = 0; i < GOV_PROFILE_PAYLOAD_SIZE; ++i)
+        // Governor profile saved values — 17 bytes x 4 banks = 68 bytes
+        for (j = 0; j < 4; ++j)
+            for (i = 0; i < GOV_PROFILE_PAYLOAD_SIZE; ++i)
+            {
+                Saved_GOV_Profiles_Values[i][j] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+            }
+
+        // Read config values for RF Governor global (no bank dimension)
+        for (i = 0; i < GOV_CONFIG_PAYLOAD_SIZE; ++i)
         {
-            Saved_GOV_Profiles_Values[i][j] = SDRead8BITS(SDCardAddress);
+            Saved_GOV_Config_Values[i] = SDRead8BITS(SDCardAddress);
             ++SDCardAddress;
         }
-
-    // Read config values for RF Governor global (no bank dimension)
-    for (i = 0; i < GOV_CONFIG_PAYLOAD_SIZE; ++i)
-    {
-        Saved_GOV_Config_Values[i] = SDRead8BITS(SDCardAddress);
-        ++SDCardAddress;
     }
 
     CheckOutPutChannels();
     CheckServoType();
     // **************************************
-    ReadCheckSum32();
+    ModelNeedsMigrating = false;
+    if (ModelDirectoryFound)
+    {
+        SDCardAddress += 5; // The old checksum isn't needed: every section had its CRC32 checked
+    }
+    else
+    {
+        uint8_t SavedErrorState = ErrorState;
+        ErrorState = NOERROR;
+        ReadCheckSum32();
+        ModelNeedsMigrating = (ErrorState != CHECKSUMERROR) && !SingleModelFlag; // Never bless a damaged model with new CRCs
+        if (ErrorState != CHECKSUMERROR)
+            ErrorState = SavedErrorState;
+    }
+
+    if (!SeekModelSection(MSEC_BANKS))
+        SetSectionDefaults(MSEC_BANKS);
+    else
+    {
+        BankCrossfadeTime = SDRead8BITS(SDCardAddress);
+        ++SDCardAddress;
+        if (BankCrossfadeTime > MAXBANKCROSSFADE)
+            BankCrossfadeTime = 0; // Older models never saved this
+        for (j = 0; j < BANKS_USED; ++j)
+        {
+            for (i = 0; i < CHANNELSUSED; ++i)
+            {
+                ServoSpeedDown[j][i] = SDRead8BITS(SDCardAddress);
+                ++SDCardAddress;
+                if (ServoSpeedDown[j][i] > 100)
+                    ServoSpeedDown[j][i] = 0; // Older models never saved this
+            }
+        }
+    }
     OneModelMemory = SDCardAddress - StartLocation;
+    ForgetSDBlock();
+#ifdef DB_SD
+    Serial.print("Model read in ");
+    Serial.print(micros() - SDTimer);
+    Serial.println(" us.");
+#endif
 
 #ifdef DB_SD
     Serial.print(MemoryForTransmtter);
@@ -552,6 +832,7 @@ bool ReadOneModel(uint32_t Mnum)
 
     UpdateButtonLabels();
     CheckMacrosBuffer();
+    InvalidatePipeline(); // New model so every channel must be recalculated
     return true;
 }
 
@@ -587,6 +868,239 @@ void BuildCheckSum(int p_address, short int p_value)
         FileCheckSum += (p_value * (p_address + 1)); // don't include checksum in its own calculation
 }
 
+/*********************************************************************************************************************************/
+// A whole model (or the transmitter's part of the file) is read into SDBlock with one seek and one read, and the
+// SDRead / SDUpdate functions below then work on that copy. SaveSDBlock() writes it back with one seek and one write.
+// The file layout is exactly as before: only the number of SD operations has changed.
+// Addresses outside the block still go straight to the file.
+// Once the model store (ModelStore.h) holds models.dat, blocks come from and go to it instead of the SD card.
+// Backups in the backup store (BackupStore.h) are read from and saved to it.
+
+bool LoadSDBlock(int Start, int Length)
+{
+    if (Length > SDBLOCKSIZE)
+        Length = SDBLOCKSIZE;
+    SDBlockStart = Start;
+    SDBlockLength = Length;
+    if (BackupStoreInUse())
+        return ReadFromBackupStore(Start, SDBlock, Length);
+    if (ReadFromModelStore(Start, SDBlock, Length))
+        return true;
+    int Got = 0;
+    if (ModelsFileNumber.seek(Start))
+        Got = ModelsFileNumber.read(SDBlock, Length);
+    if (Got < 0)
+        Got = 0;
+    memset(SDBlock + Got, 0xFF, Length - Got); // past the end reads as 255, just as read() did
+    return Got > 0;
+}
+
+/*********************************************************************************************************************************/
+// Crash-safe saving. Before anything in models.dat is overwritten, the new bytes go to models.jnl with their address and a
+// CRC32, and are read back and checked. Only then is models.dat written. Afterwards the journal's header is cleared.
+// If the power fails part way through writing models.dat, ReplayModelsJournal() finishes the job at the next boot.
+// If it fails while the journal is being written, models.dat hasn't been touched and the half-written journal is ignored.
+// If the journal can't be written or doesn't read back correctly, models.dat isn't touched at all and the journal is cleared,
+// so that it can't be replayed over later saves.
+
+bool WriteModelsJournal(int Start, const uint8_t *Data, int Length)
+{
+    ModelsJournalHeader Header;
+    Header.Magic = MODELSJOURNALMAGIC;
+    Header.Start = Start;
+    Header.Length = Length;
+    Header.DataCrc = Crc32(Data, Length);
+    Header.HeaderCrc = Crc32((uint8_t *)&Header, sizeof(Header) - 4);
+    File Journal = TINYCARD.open(MODELSJOURNALFILE, FILE_WRITE);
+    if (!Journal)
+        return false;
+    Journal.truncate(0); // A longer, older entry mustn't show through
+    Journal.write(Data, Length); // Data first, header last, so a torn write never looks valid
+    Journal.write((uint8_t *)&Header, sizeof(Header));
+    Journal.flush();
+    Journal.seek(0);
+    bool Good = (Journal.read(SDJournalCheck, Length) == Length) && (Crc32(SDJournalCheck, Length) == Header.DataCrc);
+    Journal.close();
+    return Good;
+}
+
+/*********************************************************************************************************************************/
+void ClearModelsJournal()
+{
+    File Journal = TINYCARD.open(MODELSJOURNALFILE, FILE_WRITE);
+    if (!Journal)
+        return;
+    Journal.truncate(0);
+    Journal.close();
+}
+
+/*********************************************************************************************************************************/
+// Called at boot before anything is read from models.dat.
+
+void ReplayModelsJournal()
+{
+    ModelsJournalHeader Header;
+    File Journal = TINYCARD.open(MODELSJOURNALFILE, FILE_READ);
+    if (!Journal)
+        return;
+    bool Good = false;
+    uint32_t Size = Journal.size();
+    if (Size > sizeof(Header) && Size <= sizeof(Header) + SDBLOCKSIZE)
+    {
+        Journal.seek(Size - sizeof(Header));
+        Good = (Journal.read((uint8_t *)&Header, sizeof(Header)) == sizeof(Header)) && (Header.Magic == MODELSJOURNALMAGIC) &&
+               (Header.HeaderCrc == Crc32((uint8_t *)&Header, sizeof(Header) - 4)) && (Header.Length == Size - sizeof(Header));
+        if (Good)
+        {
+            Journal.seek(0);
+            Good = (Journal.read(SDJournalCheck, Header.Length) == (int)Header.Length) && (Crc32(SDJournalCheck, Header.Length) == Header.DataCrc);
+        }
+    }
+    Journal.close();
+    if (Good)
+    {
+        if (!ModelsFileOpen)
+            OpenModelsFile();
+        if (!ModelsFileOpen)
+            return; // Leave the journal for next time
+        WriteModelsFileDirect(Header.Start, SDJournalCheck, Header.Length);
+#ifdef DB_SD
+        Serial.print("Finished an interrupted save at ");
+        Serial.println(Header.Start);
+#endif
+    }
+    if (Size)
+        ClearModelsJournal();
+}
+
+/*********************************************************************************************************************************/
+// Called at boot, after ReplayModelsJournal(), whenever models.cat doesn't match models.dat (so models.dat is new, or was
+// changed by something else). Every model without a good section directory is read and saved again with one, all in this
+// one pass, so that loading a model later never writes to the card. The current model is read afterwards as usual.
+
+void MigrateOldModels()
+{
+    if (SingleModelFlag)
+        return;
+    if (!ModelsFileOpen)
+        OpenModelsFile();
+    if (!ModelsFileOpen)
+        return;
+    uint32_t CurrentModel = ModelNumber;
+    uint8_t SavedErrorState = ErrorState; // A damaged model that isn't loaded isn't an error yet
+    for (uint32_t Slot = 1; Slot < MAXMODELNUMBER; ++Slot)
+    {
+        LoadSDBlock(TXSIZE + ((Slot - 1) * MODELSIZE), MODELSIZE);
+        bool Old = (SDBlock[0] == 42);
+        if (Old)
+        {
+            ReadModelDirectory();
+            Old = !ModelDirectoryFound;
+        }
+        ForgetSDBlock();
+        if (Old)
+        {
+            ModelNumber = Slot;
+            if (ReadOneModel(Slot) && ModelNeedsMigrating)
+            {
+                SaveOneModel(Slot);
+#ifdef DB_SD
+                Serial.print("Migrated model ");
+                Serial.println(Slot);
+#endif
+            }
+        }
+        KickTheDog();
+    }
+    ModelNumber = CurrentModel;
+    ErrorState = SavedErrorState;
+}
+
+/*********************************************************************************************************************************/
+bool WriteToModelsFile(int Start, const uint8_t *Data, int Length) // Returns false if nothing was written
+{
+    if (SingleModelFlag)
+    {
+        WriteModelsFileDirect(Start, Data, Length);
+        return true;
+    }
+    if (!WriteModelsJournal(Start, Data, Length))
+    {
+        ClearModelsJournal();
+        FileError = true;
+        return false;
+    }
+    WriteModelsFileDirect(Start, Data, Length);
+    ClearModelsJournal(); // models.dat is complete: the journal isn't needed now
+    return true;
+}
+
+/*********************************************************************************************************************************/
+void WriteModelsFileDirect(int Start, const uint8_t *Data, int Length)
+{
+    uint32_t Generation = ReadModelsGeneration(); // (before Data, which may hold an older copy of it)
+    uint32_t FileSize = ModelsFileNumber.size();
+    if (FileSize < (uint32_t)Start)
+    { // A slot beyond the end of the file: fill the gap first so the block lands where it belongs
+        ModelsFileNumber.seek(FileSize);
+        for (uint32_t i = FileSize; i < (uint32_t)Start; ++i)
+            ModelsFileNumber.write(0xFF);
+    }
+    ModelsFileNumber.seek(Start);
+    ModelsFileNumber.write(Data, Length);
+    WriteModelsGeneration(Generation + 1); // The catalog can tell that models.dat has changed
+    ModelsFileNumber.flush();
+}
+
+/*********************************************************************************************************************************/
+void SaveSDBlock()
+{
+    if (SDBlockStart < 0)
+        return;
+    if (BackupStoreInUse())
+        WriteToBackupStore(SDBlockStart, SDBlock, SDBlockLength);
+    else if (!WriteToModelStore(SDBlockStart, SDBlock, SDBlockLength))
+        WriteToModelsFile(SDBlockStart, SDBlock, SDBlockLength);
+    ForgetSDBlock();
+}
+
+/*********************************************************************************************************************************/
+void ForgetSDBlock()
+{
+    SDBlockStart = -1;
+    SDBlockLength = 0;
+}
+
+/*********************************************************************************************************************************/
+inline bool InSDBlock(int p_address)
+{
+    return (SDBlockStart >= 0) && (p_address >= SDBlockStart) && (p_address < SDBlockStart + SDBlockLength);
+}
+
+/*********************************************************************************************************************************/
+uint8_t SDReadByte(int p_address)
+{
+    if (InSDBlock(p_address))
+        return SDBlock[p_address - SDBlockStart];
+    ModelsFileNumber.seek(p_address);
+    ShortDelay();
+    return ModelsFileNumber.read();
+}
+
+/*********************************************************************************************************************************/
+void SDWriteByte(int p_address, uint8_t p_value)
+{
+    if (InSDBlock(p_address))
+    {
+        SDBlock[p_address - SDBlockStart] = p_value;
+        return;
+    }
+    ModelsFileNumber.seek(p_address);
+    ShortDelay();
+    ModelsFileNumber.write(p_value);
+    ShortDelay();
+}
+
 /*********************************************************************************************************************************/
 void SDUpdateFLOAT(int p_address, float p_value)
 {
@@ -598,13 +1112,8 @@ void SDUpdateFLOAT(int p_address, float p_value)
     } converter;
     converter.f = p_value;
     BuildCheckSum(p_address, converter.u32);
-    ModelsFileNumber.seek(p_address);
-    ShortDelay();
     for (int i = 0; i < 4; ++i)
-    {
-        ModelsFileNumber.write(converter.b[i]);
-        ShortDelay();
-    }
+        SDWriteByte(p_address + i, converter.b[i]);
 }
 //*********************************************************************************************************************************/
 float SDReadFLOAT(int p_address)
@@ -615,13 +1124,8 @@ float SDReadFLOAT(int p_address)
         uint8_t b[4];
         uint32_t u32;
     } converter;
-    ModelsFileNumber.seek(p_address);
-    ShortDelay();
     for (int i = 0; i < 4; ++i)
-    {
-        converter.b[i] = ModelsFileNumber.read();
-        ShortDelay();
-    }
+        converter.b[i] = SDReadByte(p_address + i);
     BuildCheckSum(p_address, converter.u32);
     return converter.f;
 }
@@ -630,27 +1134,20 @@ float SDReadFLOAT(int p_address)
 void SDUpdate32BITS(int p_address, uint32_t p_value)
 {
     BuildCheckSum(p_address, p_value);
-    ModelsFileNumber.seek(p_address);
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value));
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value >> 8));
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value >> 16));
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value >> 24));
-    ShortDelay();
+    SDWriteByte(p_address, uint8_t(p_value));
+    SDWriteByte(p_address + 1, uint8_t(p_value >> 8));
+    SDWriteByte(p_address + 2, uint8_t(p_value >> 16));
+    SDWriteByte(p_address + 3, uint8_t(p_value >> 24));
 }
 
 /*********************************************************************************************************************************/
 
 uint32_t SDRead32BITS(int p_address)
 {
-    ModelsFileNumber.seek(p_address);
-    uint32_t r = ModelsFileNumber.read();
-    r += ModelsFileNumber.read() << 8;
-    r += ModelsFileNumber.read() << 16;
-    r += ModelsFileNumber.read() << 24;
+    uint32_t r = SDReadByte(p_address);
+    r += SDReadByte(p_address + 1) << 8;
+    r += SDReadByte(p_address + 2) << 16;
+    r += SDReadByte(p_address + 3) << 24;
     return r;
 }
 /*********************************************************************************************************************************/
@@ -658,32 +1155,23 @@ uint32_t SDRead32BITS(int p_address)
 void SDUpdate16BITS(int p_address, short int p_value)
 {
     BuildCheckSum(p_address, p_value);
-    ModelsFileNumber.seek(p_address);
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value));
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value >> 8));
-    ShortDelay();
+    SDWriteByte(p_address, uint8_t(p_value));
+    SDWriteByte(p_address + 1, uint8_t(p_value >> 8));
 }
 /*********************************************************************************************************************************/
 
 void SDUpdate8BITS(int p_address, uint8_t p_value)
 {
     BuildCheckSum(p_address, p_value);
-    ModelsFileNumber.seek(p_address);
-    ShortDelay();
-    ModelsFileNumber.write(uint8_t(p_value));
-    ShortDelay();
+    SDWriteByte(p_address, p_value);
 }
 
 /*********************************************************************************************************************************/
 
 short int SDRead16BITS(int p_address)
 {
-
-    ModelsFileNumber.seek(p_address);
-    short int r = ModelsFileNumber.read();
-    r += ModelsFileNumber.read() << 8;
+    short int r = SDReadByte(p_address);
+    r += SDReadByte(p_address + 1) << 8;
     BuildCheckSum(p_address, r);
     return r;
 }
@@ -692,12 +1180,65 @@ short int SDRead16BITS(int p_address)
 
 uint8_t SDRead8BITS(int p_address)
 {
-    ModelsFileNumber.seek(p_address);
-    uint8_t r = ModelsFileNumber.read();
+    uint8_t r = SDReadByte(p_address);
     BuildCheckSum(p_address, r);
     return r;
 }
 
+/*********************************************************************************************************************************/
+// The input filter settings follow the transmitter parameters' checksum, after their own marker and with their own checksum,
+// so that the older layout is still read exactly as it was. Files without them (or with a bad checksum) get the defaults.
+
+void ReadInputFilterSettings()
+{
+    uint8_t FilterType[PROPOCHANNELS];
+    uint8_t Deadband[PROPOCHANNELS];
+    FileCheckSum = 0;
+    if (SDRead16BITS(SDCardAddress) != TXFILTERSMARKER)
+    {
+        DefaultInputFilters();
+        return;
+    }
+    SDCardAddress += 2;
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        FilterType[i] = SDRead8BITS(SDCardAddress);
+        ++SDCardAddress;
+        Deadband[i] = SDRead8BITS(SDCardAddress);
+        ++SDCardAddress;
+    }
+    DoingCheckSm = true;
+    uint32_t Stored = SDRead32BITS(SDCardAddress);
+    DoingCheckSm = false;
+    SDCardAddress += 5; // (and the indicator byte)
+    if (Stored != FileCheckSum)
+    {
+        DefaultInputFilters();
+        return;
+    }
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        InputFilterType[i] = CheckRange(FilterType[i], FILTER_NONE, FILTER_ONEEURO);
+        InputDeadband[i] = CheckRange(Deadband[i], 0, MAXINPUTDEADBAND);
+    }
+}
+
+/*********************************************************************************************************************************/
+void SaveInputFilterSettings()
+{
+    FileCheckSum = 0;
+    SDUpdate16BITS(SDCardAddress, TXFILTERSMARKER);
+    SDCardAddress += 2;
+    for (uint8_t i = 0; i < PROPOCHANNELS; ++i)
+    {
+        SDUpdate8BITS(SDCardAddress, InputFilterType[i]);
+        ++SDCardAddress;
+        SDUpdate8BITS(SDCardAddress, InputDeadband[i]);
+        ++SDCardAddress;
+    }
+    SaveCheckSum32();
+}
+
 /*********************************************************************************************************************************/
 /******************************************* LOAD ALL PARAMS *********************************************************************/
 /*********************************************************************************************************************************/
@@ -709,13 +1250,17 @@ bool LoadAllParameters()
     int j = 0;
     int i = 0;
     FileCheckSum = 0;
-    if (!ModelsFileOpen)
+    if (!ModelsFileOpen && !ModelStoreInUse())
         OpenModelsFile();
-    if (!ModelsFileOpen)
+    if (!ModelsFileOpen && !ModelStoreInUse())
         return false;
     SDCardAddress = 0;
+    LoadSDBlock(0, TXSIZE);
     if ((SDRead16BITS(SDCardAddress)) != 12345)
+    {
+        ForgetSDBlock();
         return false; // not a good file?!
+    }
     SDCardAddress += 2;
     for (i = 0; i < CHANNELSUSED; ++i)
     {
@@ -895,8 +1440,9 @@ bool LoadAllParameters()
     ++SDCardAddress;
     Buddy_Hi_Position = SDRead8BITS(SDCardAddress);
     ++SDCardAddress;
-
     ReadCheckSum32();
+    ReadInputFilterSettings();
+    ForgetSDBlock();
     CheckTrimValues();
     MemoryForTransmtter = SDCardAddress;
     if ((ModelNumber < 1) || (ModelNumber > 90))
@@ -914,11 +1460,12 @@ void SaveTransmitterParameters()
     bool EON = false;
     int j = 0;
     int i = 0;
-    if (!ModelsFileOpen)
+    if (!ModelsFileOpen && !ModelStoreInUse())
         OpenModelsFile();
 
     SDCardAddress = 0;
     FileCheckSum = 0;
+    LoadSDBlock(0, TXSIZE); // keeps the spare bytes as they were
 
     SDUpdate16BITS(SDCardAddress, 12345); // marker that file exists!
 
@@ -1079,8 +1626,9 @@ void SaveTransmitterParameters()
     ++SDCardAddress;
     SDUpdate8BITS(SDCardAddress, Buddy_Hi_Position);
     ++SDCardAddress;
-
     SaveCheckSum32(); // Save the Transmitter parametres checksm
+    SaveInputFilterSettings();
+    SaveSDBlock();
     CloseModelsFile();
 }
 
@@ -1094,7 +1642,7 @@ void SaveTransmitterParameters()
 
 void SaveAllParameters()
 {
-    if (!ModelsFileOpen)
+    if (!ModelsFileOpen && !ModelStoreInUse())
         OpenModelsFile();
     SaveTransmitterParameters();
     MemoryForTransmtter = SDCardAddress - 2;
@@ -1132,13 +1680,19 @@ void SaveOneModel(uint32_t mnum)
     FileCheckSum = 0;
     if ((mnum < 1) || (mnum > MAXMODELNUMBER))
         return; // There is no model zero!
-    if (!ModelsFileOpen)
+    if (!ModelsFileOpen && !ModelStoreInUse() && !BackupStoreInUse())
         OpenModelsFile();
     SDCardAddress = TXSIZE;                  //  spare bytes for TX stuff
     SDCardAddress += (mnum - 1) * MODELSIZE; //  spare bytes for Model params
     if (SingleModelFlag)
         SDCardAddress = 0;
     StartLocation = SDCardAddress;
+#ifdef DB_SD
+    uint32_t SDTimer = micros();
+#endif
+    LoadSDBlock(StartLocation, MODELSIZE); // keeps the spare bytes as they were
+    StartModelDirectory();
+    BeginModelSection(MSEC_IDENTITY);
     ModelDefined = 42;
     SDUpdate8BITS(SDCardAddress, ModelDefined);
     ++SDCardAddress;
@@ -1152,6 +1706,7 @@ void SaveOneModel(uint32_t mnum)
         ++SDCardAddress;
     }
 
+    BeginModelSection(MSEC_CURVES);
     for (i = 0; i < CHANNELSUSED; ++i)
     {
         for (j = 1; j <= 4; ++j)
@@ -1168,6 +1723,7 @@ void SaveOneModel(uint32_t mnum)
             ++SDCardAddress;
         }
     }
+    BeginModelSection(MSEC_MIXES);
     for (j = 0; j < MAXMIXES; ++j)
     {
         for (i = 0; i < 17; ++i)
@@ -1176,6 +1732,7 @@ void SaveOneModel(uint32_t mnum)
             ++SDCardAddress;
         }
     }
+    BeginModelSection(MSEC_TRIMS);
     for (j = 0; j < BANKS_USED + 1; ++j)
     {
         for (i = 0; i < CHANNELSUSED + 1; ++i)
@@ -1192,6 +1749,7 @@ void SaveOneModel(uint32_t mnum)
             ++SDCardAddress;
         }
     }
+    BeginModelSection(MSEC_SETTINGS);
     SDUpdate8BITS(SDCardAddress, RXCellCount);
     ++SDCardAddress;
     SDUpdate16BITS(SDCardAddress, TrimMultiplier);
@@ -1252,6 +1810,7 @@ void SaveOneModel(uint32_t mnum)
 
     // *********************************************************************************
 
+    BeginModelSection(MSEC_CHANNELS);
     for (i = 0; i < CHANNELSUSED; ++i)
     {
         SDUpdate8BITS(SDCardAddress, FailSafeChannel[i]);
@@ -1265,6 +1824,7 @@ void SaveOneModel(uint32_t mnum)
             ++SDCardAddress;
         }
     }
+    BeginModelSection(MSEC_EXPO);
     for (j = 0; j < BANKS_USED + 1; ++j)
     {
         for (i = 0; i < CHANNELSUSED + 1; ++i)
@@ -1283,6 +1843,7 @@ void SaveOneModel(uint32_t mnum)
         }
     }
 
+    BeginModelSection(MSEC_MACROS);
     for (j = 0; j < BYTESPERMACRO; ++j)
     {
         for (i = 0; i < MAXMACROS; ++i)
@@ -1291,12 +1852,14 @@ void SaveOneModel(uint32_t mnum)
             ++SDCardAddress;
         }
     }
+    BeginModelSection(MSEC_MODELID);
     for (i = 0; i < 8; ++i)
     {
         SDUpdate8BITS(SDCardAddress, ModelsMacUnionSaved.Val8[i]);
         ++SDCardAddress;
     }
 
+    BeginModelSection(MSEC_OUTPUTS);
     SDUpdate8BITS(SDCardAddress, UseMotorKill);
     ++SDCardAddress;
     SDUpdate8BITS(SDCardAddress, MotorChannelZero);
@@ -1371,6 +1934,7 @@ void SaveOneModel(uint32_t mnum)
         ++SDCardAddress;
     }
 
+    BeginModelSection(MSEC_ROTORFLIGHT);
     for (j = 0; j < 4; ++j)
     {
         for (i = 0; i < MAX_PID_WORDS + 5; ++i)
@@ -1421,12 +1985,28 @@ void SaveOneModel(uint32_t mnum)
         ++SDCardAddress;
     }
 
-    SaveCheckSum32(); // Save the Model parametres checksm
+    EndModelSection();
+    SaveCheckSum32(); // Save the Model parametres checksm (still written, for older firmware)
 
-    // ********************** Add more
+    // ********************** Add more (each new section goes in ModelSections.h's list)
+    BeginModelSection(MSEC_BANKS);
+    SDUpdate8BITS(SDCardAddress, BankCrossfadeTime);
+    ++SDCardAddress;
+    for (uint32_t jj = 0; jj < BANKS_USED; ++jj)
+        for (uint32_t ii = 0; ii < CHANNELSUSED; ++ii)
+        {
+            SDUpdate8BITS(SDCardAddress, ServoSpeedDown[jj][ii]);
+            ++SDCardAddress;
+        }
+    WriteModelDirectory();
+    SaveSDBlock();
+    NoteModelInCatalog(mnum);
 
     OneModelMemory = SDCardAddress - StartLocation;
 #ifdef DB_SD
+    Serial.print("Model written in ");
+    Serial.print(micros() - SDTimer);
+    Serial.println(" us.");
     Serial.print("Saved model: ");
     Serial.println(ModelName);
     Serial.println(" ");
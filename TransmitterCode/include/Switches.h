@@ -13,10 +13,12 @@ FASTRUN void ReadTheSwitchesAndTrims() // and indeed read digital trims if these
 {
     byte flag = 0;
     static uint8_t PreviousTrim = 255;
+    bool FastScanRunning = (millis() - LastFastSwitchScan) < 20; // If so, Switch[] is already debounced and up to date
     for (int i = 0; i < 8; ++i)
     {
-        Switch[i] = !digitalRead(SwitchNumber[i]);   // These are reversed because they are active low
-        TrimSwitch[i] = !digitalRead(TrimNumber[i]); // These are reversed because they are active low
+        if (!FastScanRunning)
+            Switch[i] = !digitalRead(SwitchNumber[i]); // These are reversed because they are active low
+        TrimSwitch[i] = !digitalRead(TrimNumber[i]);   // These are reversed because they are active low
         if (TrimSwitch[i])
             ++flag; // A finger is on a trim lever...
         if ((TrimSwitch[i]) && (PreviousTrim != i))
@@ -170,7 +172,7 @@ void ReadAutoAndMotorSwitch()
     }
 }
 /************************************************************************************************************/
-void ReadDualRateSwitch()
+FASTRUN void UpdateDualRateValue() // Only the state. No sounds, logs or screen updates here.
 {
     if (!BuddyPupilOnWireless || BuddyHasAllSwitches)
     {
@@ -207,6 +209,12 @@ void ReadDualRateSwitch()
     {
         DualRateValue = 100;
     }
+}
+
+/************************************************************************************************************/
+void ReadDualRateSwitch()
+{
+    UpdateDualRateValue();
 
     // Respond to a change
     if (PreviousDualRateInUse != DualRateInUse)
@@ -271,6 +279,105 @@ FASTRUN uint16_t ReadThreePositionSwitch(uint8_t InputDevice)
     return 1500; // Default for channels 12+
 }
 
+/************************************************************************************************************/
+// Fast switch scanning.
+// The 8 edge switch pins are grouped by GPIO port, so each pass needs only a few port reads. This runs on every pipeline
+// pass, not just every 50 ms in ManageTransmitter(). Motor kill, safety and bank changes therefore reach the model
+// within a packet or two. Sounds, logging and screen updates still follow a little later in GetBank().
+
+void InitFastSwitchScan()
+{
+    SwitchPortsUsed = 0;
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        volatile uint32_t *Reg = portInputRegister(SwitchNumber[i]);
+        uint8_t p = 0;
+        while (p < SwitchPortsUsed && SwitchPortReg[p] != Reg)
+            ++p;
+        if (p == SwitchPortsUsed)
+            SwitchPortReg[SwitchPortsUsed++] = Reg; // a new port
+        SwitchPortOf[i] = p;
+        SwitchPinMask[i] = digitalPinToBitMask(SwitchNumber[i]);
+        ScannedSwitchPins[i] = SwitchNumber[i];
+        SwitchBounceCount[i] = 0;
+    }
+}
+
+/************************************************************************************************************/
+// A switch changes state only after SWITCHDEBOUNCECOUNT consecutive passes all disagree with its current state.
+
+FASTRUN void ScanSwitchesFast()
+{
+    uint32_t PortValue[8];
+    bool Changed = false;
+    uint32_t EdgeTime = 0;
+
+    if ((CurrentMode != NORMAL) && (CurrentMode != LISTENMODE))
+        return; // not needed if calibrating
+    if (BuddyPupilOnWireless && !BuddyHasAllSwitches)
+        return;
+    if (memcmp(ScannedSwitchPins, SwitchNumber, sizeof(ScannedSwitchPins)))
+        InitFastSwitchScan(); // switch pins were swapped or reloaded
+
+    for (uint8_t p = 0; p < SwitchPortsUsed; ++p)
+        PortValue[p] = *SwitchPortReg[p];
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        bool Raw = !(PortValue[SwitchPortOf[i]] & SwitchPinMask[i]); // active low
+        if (Raw == Switch[i])
+        {
+            SwitchBounceCount[i] = 0;
+            continue;
+        }
+        if (!SwitchBounceCount[i])
+            SwitchEdgeTime[i] = micros(); // first sight of a new position
+        if (++SwitchBounceCount[i] >= SWITCHDEBOUNCECOUNT)
+        {
+            Switch[i] = Raw;
+            SwitchBounceCount[i] = 0;
+            if (!Changed)
+                EdgeTime = SwitchEdgeTime[i];
+            Changed = true;
+        }
+    }
+    LastFastSwitchScan = millis();
+    if (!Changed)
+        return;
+
+    ReadSafetySwitch();
+    ReadBankSwitch();
+    ReadAutoAndMotorSwitch();
+    if (SafetyON)
+        MotorEnabled = false;
+    UpdateDualRateValue();
+    ReadChannelSwitches9to12();
+    if (!SwitchLatencyPending)
+    {
+        SwitchLatencyStart = EdgeTime;
+        SwitchLatencyPending = true;
+    }
+}
+
+/************************************************************************************************************/
+// Called after a packet carrying channel data was acknowledged. Completes a switch-to-air latency measurement.
+
+FASTRUN void SwitchReachedAir()
+{
+    if (!SwitchLatencyPending)
+        return;
+    SwitchLatencyPending = false;
+    uint32_t Latency = micros() - SwitchLatencyStart;
+    SwitchLatencyLast = Latency;
+    if (Latency > SwitchLatencyMax)
+        SwitchLatencyMax = Latency;
+    SwitchLatencySum += Latency;
+    ++SwitchLatencyCount;
+#ifdef DB_SWITCHES
+    Look1("Switch to air latency (us): ");
+    Look(Latency);
+#endif
+}
+
 /************************************************************************************************************/
 void CalibrateEdgeSwitches()
 { // This function avoids the need to rotate the four edge switches if installed backwards
@@ -0,0 +1,156 @@
+// *************************************** TextCommands.h *****************************************
+
+// The Nextion's word commands ("FrontView", "Setup3", "GOTO:GraphView" ...) and the function that handles each one.
+// ButtonWasPressed() finds the command with FindTextCommand(): one hash, one table read and one compare per prefix.
+// test/TextCommandsTest.cpp checks that every command still reaches the handler that the old chain of InStrng() tests
+// called.
+
+#include <Arduino.h>
+#include "1Definitions.h"
+
+#ifndef TEXT_COMMANDS_H
+#define TEXT_COMMANDS_H
+
+/*********************************************************************************************************************************/
+struct TextCommand
+{
+    const char *Name;
+    void (*Handler)();
+};
+
+constexpr TextCommand TextCommands[] = {
+    {"StCH", SubTrimChannelChosen},
+    {"StEDIT", SubTrimValueEdited},
+    {"MainSetup", MainSetupChosen},
+    {"Mark", MarkGPSLocation},
+    {"DataEnd", DataViewEnd},
+    {"Clear", ClearDataView},
+    {"AltZero", ZeroAltitude},
+    {"HelpView", StartHelpView},
+    {"DecMinute", DecMinute},
+    {"IncMinute", IncMinute},
+    {"DecHour", DecHour},
+    {"IncHour", IncHour},
+    {"DecYear", DecYear},
+    {"IncYear", IncYear},
+    {"DecDate", DecDate},
+    {"IncDate", IncDate},
+    {"DecMonth", DecMonth},
+    {"IncMonth", IncMonth},
+    {"GOTO:", ReturnFromHelp},
+    {"Exrite", CurveTypeEdited},
+    {"SendModel", SendModelPressed},
+    {"FailSAVE", SaveFailSafe},
+    {"FailSafe", StartFailSafeView},
+    {"OneSwitchView", StartOneSwitchView},
+    {"SwitchesView1", SwitchesViewEdited},
+    {"InputsView", StartInputsView},
+    {"DelFile", DeleteModFilePressed},
+    {"SwitchesView", StartSwitchesView},
+    {"CalibrateView", StartCalibrateView},
+    {"Export", ExportModel},
+    {"Import", ImportModel},
+    {"SetupCol", ColoursSetupEnd},
+    {"TypeView", StartTypeView},
+    {"RXBAT", RXBatteryTypeChosen},
+    {"TrimView", StartTrimView},
+    {"TRIMS50", CentreAllTrims},
+    {"Setup", SetupChannel},
+    {"FrontView", FrontViewShown},
+    {"SticksView", StartSticksView},
+    {"ReScan", RescanWaveband},
+    {"ScanMode", CycleScanMode},
+    {"LogSort", CycleLogSort},
+    {"WorstLinks", ShowWorstLinks},
+    {"ModFile", ExportModelFile},
+    {"MIXESVIEW", StartMixesView},
+    {"MixesView", MixesViewEdited},
+    {"GraphView", GraphViewShown},
+    {"DataView", StartDataView},
+    {"FM 1", SelectBank1},
+    {"FM 2", SelectBank2},
+    {"FM 3", SelectBank3},
+    {"FM 4", SelectBank4},
+    {"Reset", ResetExpo},
+    {"ClickX", CurveClickedX},
+    {"ClickY", CurveClickedY},
+    {"Calibrate1", CalibrateButtonPressed}};
+
+#define TEXTCOMMANDS (sizeof(TextCommands) / sizeof(TextCommands[0]))
+
+/*********************************************************************************************************************************/
+// Perfect hash. At compile time a seed is searched for that puts every command in a different slot, so a lookup is one hash,
+// one table read and one compare. If a new command ever makes that impossible, the static_assert below says so.
+
+constexpr uint32_t ConstFNV1aHash(const char *text, uint32_t Hash = FNV1A_SEED)
+{
+    return *text ? ConstFNV1aHash(text + 1, (Hash ^ (uint8_t)*text) * 16777619u) : Hash;
+}
+
+constexpr uint16_t TextCommandSlot(uint32_t Hash, uint32_t Seed)
+{
+    return (uint16_t)(((Hash ^ Seed) * 2654435761u) >> (32 - TEXTCOMMANDHASHBITS));
+}
+
+struct TextCommandIndex
+{
+    bool Found;
+    uint32_t Seed;
+    uint8_t Slot[1 << TEXTCOMMANDHASHBITS]; // index into TextCommands[], or 255 if empty
+};
+
+constexpr TextCommandIndex BuildTextCommandIndex()
+{
+    TextCommandIndex Index{};
+    for (uint32_t Seed = 1; Seed < 10000; ++Seed)
+    {
+        bool Clash = false;
+        for (uint16_t s = 0; s < (1 << TEXTCOMMANDHASHBITS); ++s)
+            Index.Slot[s] = 255;
+        for (uint8_t i = 0; i < TEXTCOMMANDS && !Clash; ++i)
+        {
+            uint16_t s = TextCommandSlot(ConstFNV1aHash(TextCommands[i].Name), Seed);
+            if (Index.Slot[s] != 255)
+                Clash = true;
+            Index.Slot[s] = i;
+        }
+        if (!Clash)
+        {
+            Index.Found = true;
+            Index.Seed = Seed;
+            return Index;
+        }
+    }
+    return Index;
+}
+
+constexpr TextCommandIndex TextCommandLookup = BuildTextCommandIndex();
+static_assert(TEXTCOMMANDS < 255, "Too many text commands for a uint8_t index");
+static_assert(TextCommandLookup.Found, "No perfect hash seed found for TextCommands[]. Increase TEXTCOMMANDHASHBITS");
+
+/*********************************************************************************************************************************/
+// The command is at the start of TextIn (after any blanked channel-name event) and may be followed by an argument, as in
+// "Setup3", "GOTO:GraphView" or "Import MODEL.MOD". So each prefix is looked up and the longest match wins.
+// ("SetupCol" beats "Setup", "SwitchesView1" beats "SwitchesView".)
+
+const TextCommand *FindTextCommand()
+{
+    uint16_t Start = 0;
+    while (TextIn[Start] == ' ' && Start < MAXTEXTIN - MAXTEXTCOMMAND)
+        ++Start;
+    const char *Text = (const char *)&TextIn[Start];
+    const TextCommand *Found = nullptr;
+    uint32_t Hash = FNV1A_SEED;
+    for (uint8_t Length = 1; Length <= MAXTEXTCOMMAND && Text[Length - 1]; ++Length)
+    {
+        Hash = FNV1aHashByte(Hash, Text[Length - 1]);
+        uint8_t i = TextCommandLookup.Slot[TextCommandSlot(Hash, TextCommandLookup.Seed)];
+        if (i == 255)
+            continue;
+        if (strlen(TextCommands[i].Name) == Length && !strncmp(TextCommands[i].Name, Text, Length))
+            Found = &TextCommands[i];
+    }
+    return Found;
+}
+
+#endif
@@ -12,6 +12,7 @@ void ForceDataRedisplay()
 {
     LastShowTime = 0; //
     ForceVoltDisplay = true;
+    ForgetNextionShadows();
     for (int i = 0; i < 5; ++i)
     {
         for (int j = 0; j < 17; ++j)
@@ -215,6 +216,39 @@ void CheckForNextionButtonPress()
         ButtonWasPressed();
 }
 
+// **********************************************************************************************************************************
+// FNV-1a: a tiny, fast string hash.
+
+uint32_t FNV1aHashByte(uint32_t Hash, uint8_t b)
+{
+    return (Hash ^ b) * 16777619u;
+}
+
+uint32_t FNV1aHash(const char *text)
+{
+    uint32_t Hash = FNV1A_SEED;
+    while (*text)
+        Hash = FNV1aHashByte(Hash, *text++);
+    return Hash;
+}
+
+// **********************************************************************************************************************************
+// CRC-32 (the zip / Ethernet one), four bits at a time so the table stays small. Pass the last result as Crc to continue.
+
+uint32_t Crc32(const uint8_t *Data, uint32_t Length, uint32_t Crc)
+{
+    static const uint32_t Nibble[16] = {0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+                                        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+    Crc = ~Crc;
+    while (Length--)
+    {
+        Crc ^= *Data++;
+        Crc = (Crc >> 4) ^ Nibble[Crc & 15];
+        Crc = (Crc >> 4) ^ Nibble[Crc & 15];
+    }
+    return ~Crc;
+}
+
 // **********************************************************************************************************************************
 
 uint8_t Ascii(char c)
@@ -1091,6 +1125,7 @@ void DelayWithDog(uint32_t HowLong)
     while ((millis() - ThisMoment) < HowLong)
     {
         KickTheDog();
+        DrainNextionQueue();
         CheckPowerOffButton();
         if (ModelMatched && BoundFlag)
         {
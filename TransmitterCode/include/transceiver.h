@@ -187,7 +187,12 @@ void CheckInactivityTimeout()
 {
     int SecondsRemaining = (Inactivity_Timeout / 1000) - (millis() - Inactivity_Start) / 1000;
     if (SecondsRemaining <= 0)
+    {
+        FlushModelStore(true);             // Don't lose changes still in PSRAM
+        CloseLogWriter();                  // ... or log lines still in RAM
+        StopBlackbox();                    // ... or blackbox records
         digitalWrite(POWER_OFF_PIN, HIGH); // INACTIVITY POWER OFF HERE!!
+    }
 }
 /************************************************************************************************************/
 FASTRUN void FailedPacket()
@@ -348,7 +353,7 @@ void SuccessfulPacket()
 
 FASTRUN uint8_t EncodeTheChangedChannels()
 {
-    const uint8_t Smallest_Change = 4;           // Very tiny changes in channel values are ignored. That's most likely only noise...
+    const uint8_t Smallest_Change = 1;           // Input noise is now removed by each input's filter and deadband (InputFilters.h), so any change is a real one
     const uint8_t MaximumChannelsPerPacket = 8;  // Not more that 8 channels will be sent in one packet
     uint8_t NumberOfChangedChannels = 0;         // Number of channels that have changed or timed out since last packet
     static uint32_t LastSendTime[CHANNELSUSED] = // Place to store the last moment when we sent each packet
@@ -398,6 +403,7 @@ FASTRUN void SendData()
 
     uint8_t NumberOfChangedChannels = 0;
     static uint8_t ByteCountToTransmit = 2;
+    bool ChannelsInThisPacket = false;
 
     FixArmingChannel();
 
@@ -414,6 +420,7 @@ FASTRUN void SendData()
     else
     {
         NumberOfChangedChannels = EncodeTheChangedChannels(); // Returns the number of channels that have changed, as well as loading the raw data buffer with the changed channels.
+        ChannelsInThisPacket = NumberOfChangedChannels;
     }
     if (NumberOfChangedChannels)
     {                                                                      // Any channels changed? Or parameters to send?
@@ -430,14 +437,21 @@ FASTRUN void SendData()
     if (BuddyMasterOnWireless)
         SendSpecialPacket(); // Talk to the buddy pupil if we are a master also 200 x per second
     ++TotalPacketsAttempted;
-    if (Radio1.write(&DataTosend, ByteCountToTransmit))
+    bool Acked = Radio1.write(&DataTosend, ByteCountToTransmit); // Send the data packet complete with ChannelBitMask and compressed data
+    uint8_t Retries = UseLog ? Radio1.getARC() : 0;             // For the blackbox. (Read now, before a reconnect uses the radio)
+    if (Acked)
     {
         SuccessfulPacket();
+        if (ChannelsInThisPacket)
+            SwitchReachedAir(); // Measures switch-to-air latency if a switch just moved
     }
     else
     {
         FailedPacket();
-    } // Send the data packet complete with ChannelBitMask and compressed data
+    }
+    RecordBlackbox((Acked ? BLACKBOX_ACKED : 0) | (ChannelsInThisPacket ? BLACKBOX_CHANNELS : 0) |
+                       ((NumberOfChangedChannels && !ChannelsInThisPacket) ? BLACKBOX_PARAMETERS : 0),
+                   NumberOfChangedChannels, Retries);
 #ifdef DB_PACKETDATA
     ShowPacketData(ByteCountToTransmit, NumberOfChangedChannels); // Just for debugging
 #endif
@@ -452,6 +466,7 @@ FASTRUN void SendData()
 
 void DoScanEnd()
 {
+    Radio1.txDelay = ScanSavedTxDelay;
     ConfigureRadio();
     DontChangePipeAddress = false;
     CurrentMode = NORMAL;
@@ -461,6 +476,8 @@ void DoScanEnd()
 void DoScanInit()
 {
     Radio1.setDataRate(RF24_1MBPS); // Scan only works at this default rate
+    ScanSavedTxDelay = Radio1.txDelay;
+    Radio1.txDelay = 0;             // Nothing is sent while scanning, so stopListening() needn't wait
     CurrentMode = SCANWAVEBAND;     // Fhss == No transmitting please, we are scanning.
     BoundFlag = false;
     ScanAllChannels(true);
@@ -530,32 +547,146 @@ void DrawFhssBox()
 }
 
 /************************************************************************************************************/
-void ScanAllChannels(bool cls)
+// Scanner engine. Each call does one sweep and then draws it as a separate stage.
+// The sweep takes SCANSAMPLES readings of RPD (received power > -64 dBm) on every channel, so each channel scores
+// 0 - SCANSAMPLES per sweep. While the receiver settles the Nextion queue keeps moving, so the last sweep's drawing goes
+// out during this one. Drawing is batched with BuildNextionCommand() and skipped while the display is still behind.
+
+FASTRUN void SweepWaveband(uint8_t *Hits)
+{
+    for (uint8_t Sc = 0; Sc < SCANCHANNELS; ++Sc)
+    {
+        Radio1.setChannel(Sc);
+        Radio1.startListening();
+        uint32_t Start = micros();
+        DrainNextionQueue();
+        Hits[Sc] = 0;
+        for (uint8_t s = 0; s < SCANSAMPLES; ++s)
+        {
+            while (micros() - Start < SCANSETTLE + (s * SCANSAMPLEGAP))
+                ; // RPD needs the receiver settled and then 40 us of signal
+            if (Radio1.testCarrier())
+                ++Hits[Sc];
+        }
+        Radio1.stopListening(); // txDelay is 0 while scanning so this is quick
+    }
+}
+
+/************************************************************************************************************/
+void BuildFill(int x, int y, int w, int h, int c)
+{
+    char CB[60];
+    snprintf(CB, sizeof(CB), "fill %d,%d,%d,%d,%d", x, y, w, h, c);
+    BuildNextionCommand(CB);
+}
+
+/************************************************************************************************************/
+// Bars grow by one blob per sweep towards their share of the busiest channel, and shrink after ScanSensitivity quiet sweeps.
+// In peak hold mode a line marks the tallest each bar has been.
+
+void DrawScanBars(uint8_t *RawHits)
 {
     const uint16_t x1 = xx1;
     const uint16_t y1 = yy1;
     const uint8_t BlobHeight = 4;
     const uint8_t BlobWidth = 5;
     const uint16_t GraphHeight = 255; // pixel height of the graph area
-    uint16_t Sc;
-    uint16_t x2, y2;
-
-    char NB[12];
-    char NB1[12];
-    char NB2[12];
-    char NB3[12];
-    char NB4[12];
-    char CB[100];
-    char fyll[] = "fill ";
-    char NewYellow[15];
-    char NA[1] = "";
-
-    static uint8_t AllChannels[127]; // current rendered height (pixels)
-    static uint8_t NoCarrier[127];
-    static uint32_t TotalHits[127];
+    uint16_t x2;
+
+    uint32_t PeakHits = 1; // avoid divide-by-zero
+    for (uint8_t Sc = 0; Sc < SCANCHANNELS; ++Sc)
+        if (TotalHits[Sc] > PeakHits)
+            PeakHits = TotalHits[Sc];
+
+    ClearNextionCommand();
+    for (uint8_t Sc = 0; Sc < SCANCHANNELS; ++Sc)
+    {
+        x2 = x1 + (Sc * 5);
+
+        // Target rendered height for this channel, scaled to GraphHeight and snapped to the BlobHeight grid
+        uint8_t TargetHeight = (uint8_t)(((uint32_t)TotalHits[Sc] * GraphHeight) / PeakHits);
+        TargetHeight = (TargetHeight / BlobHeight) * BlobHeight;
+        uint8_t CurrentHeight = AllChannels[Sc];
+
+        if (TargetHeight > CurrentHeight)
+        { // Grow upward by one blob
+            uint8_t NewHeight = CurrentHeight + BlobHeight;
+            if (NewHeight > TargetHeight)
+                NewHeight = TargetHeight;
+            BuildFill(x2, y1 + GraphHeight - CurrentHeight - BlobHeight, BlobWidth, BlobHeight, HighlightColour);
+            AllChannels[Sc] = NewHeight;
+        }
+        else if (TargetHeight < CurrentHeight)
+        { // Shrink: only reduce if NoCarrier threshold met
+            if (++NoCarrier[Sc] < ScanSensitivity)
+                continue;
+            uint8_t NewHeight = CurrentHeight - BlobHeight;
+            if (NewHeight < TargetHeight)
+                NewHeight = TargetHeight;
+            BuildFill(x2, y1 + GraphHeight - CurrentHeight, BlobWidth, BlobHeight, 0);
+            AllChannels[Sc] = NewHeight;
+            NoCarrier[Sc] = 0;
+        }
+        else if (RawHits[Sc] && CurrentHeight > 0)
+        { // On target: refresh the colour (handles the case where a rescale left stale black pixels)
+            BuildFill(x2, y1 + GraphHeight - CurrentHeight, BlobWidth, BlobHeight, HighlightColour);
+        }
+        else
+            continue;
+
+        if (ScanMode == SCANPEAKHOLD && AllChannels[Sc] >= PeakHeight[Sc] && AllChannels[Sc] < GraphHeight - 1)
+        {
+            PeakHeight[Sc] = AllChannels[Sc];
+            BuildFill(x2, y1 + GraphHeight - PeakHeight[Sc] - 1, BlobWidth, 1, SpecialColour);
+        }
+    }
+    if (strlen(NextionCommand))
+        QueueNextionCommand(NextionCommand);
+}
+
+/************************************************************************************************************/
+uint16_t WaterfallColour(uint8_t Level) // black, then blue (a little) to red (every sample)
+{
+    if (!Level)
+        return 0;
+    uint16_t f = (Level * 255) / SCANSAMPLES;
+    uint16_t r = f >> 3;
+    uint16_t g = ((f < 128) ? f : 255 - f) >> 1;
+    uint16_t b = (255 - f) >> 3;
+    return (r << 11) | (g << 5) | b;
+}
+
+/************************************************************************************************************/
+// One row per sweep, newest at the marker line. Neighbouring channels with the same score share one fill.
+
+void DrawWaterfallRow(uint8_t *RawHits)
+{
+    uint16_t y = yy1 + 1 + (WaterfallRow * WATERFALLROWHEIGHT);
+    uint8_t Sc = 0;
+
+    ClearNextionCommand();
+    while (Sc < SCANCHANNELS)
+    {
+        uint8_t Run = 1;
+        while (Sc + Run < SCANCHANNELS && RawHits[Sc + Run] == RawHits[Sc])
+            ++Run;
+        BuildFill(xx1 + (Sc * 5), y, Run * 5, WATERFALLROWHEIGHT, WaterfallColour(RawHits[Sc]));
+        Sc += Run;
+    }
+    if (++WaterfallRow >= WATERFALLROWS)
+        WaterfallRow = 0;
+    BuildFill(xx1, yy1 + 1 + (WaterfallRow * WATERFALLROWHEIGHT), SCANCHANNELS * 5, 1, HighlightColour);
+    QueueNextionCommand(NextionCommand);
+}
+
+/************************************************************************************************************/
+void ScanAllChannels(bool cls)
+{
+    uint8_t RawHits[SCANCHANNELS]; // samples with carrier THIS sweep, per channel
     static uint32_t HitCount = 0;
     static uint32_t LocalTimer = millis();
     static uint32_t Seconds_so_far = 1;
+    static uint32_t Sweeps = 0;
 
     char Quietest[] = "Quietest";
     char Noisyest[] = "Noisyest";
@@ -570,128 +701,53 @@ void ScanAllChannels(bool cls)
         LocalTimer = millis();
         SendValue(Count3, HitCount / Seconds_so_far);
         ++Seconds_so_far;
+#ifdef DB_FHSS
+        Look1("Scanner sweeps per second: ");
+        Look(Sweeps);
+#endif
+        Sweeps = 0;
     }
 
     if (cls)
     {
-        for (int i = 0; i < 125; i++)
+        for (uint8_t i = 0; i < SCANCHANNELS; i++)
         {
             NoCarrier[i] = 0;
             AllChannels[i] = 0;
+            PeakHeight[i] = 0;
             TotalHits[i] = 0;
         }
+        WaterfallRow = 0;
         HitCount = 0;
         Seconds_so_far = 1;
         LocalTimer = millis();
         return;
     }
 
-    Str(NewYellow, HighlightColour, 0);
-
-    // ── PASS 1: scan all channels, accumulate raw hit counts ──────────────────
-    // We use a local raw array this sweep; TotalHits accumulates across sweeps.
-    uint8_t RawHits[126] = {0}; // hits detected THIS sweep, per channel
-
-    for (Sc = 0; Sc <= 125; ++Sc)
+    // ── Stage 1: sweep ────────────────────────────────────────────────────────
+    SweepWaveband(RawHits);
+    ++Sweeps;
+    for (uint8_t Sc = 0; Sc < SCANCHANNELS; ++Sc)
     {
-        if (NEXTION.available())
-            return;
-
-        Radio1.setChannel(Sc);
-        Radio1.startListening();
-        delayMicroseconds(120);
-        Radio1.stopListening();
-
-        if (Radio1.testCarrier())
-        {
-            RawHits[Sc] = 1;
-            ++TotalHits[Sc];
+        TotalHits[Sc] += RawHits[Sc];
+        if (RawHits[Sc])
             ++HitCount;
-        }
     }
 
-    // ── Find the peak TotalHits across all channels (for scaling) ─────────────
-    uint32_t PeakHits = 1; // avoid divide-by-zero
-    for (Sc = 0; Sc <= 125; ++Sc)
-        if (TotalHits[Sc] > PeakHits)
-            PeakHits = TotalHits[Sc];
-
-    // ── PASS 2: update rendered bar heights with proportional scaling ─────────
-    for (Sc = 0; Sc <= 125; ++Sc)
-    {
-        if (NEXTION.available())
-            return;
-
-        x2 = x1 + (Sc * 5);
-
-        // Target rendered height for this channel, scaled to GraphHeight
-        uint8_t TargetHeight = (uint8_t)(((uint32_t)TotalHits[Sc] * GraphHeight) / PeakHits);
-        // Snap to BlobHeight grid
-        TargetHeight = (TargetHeight / BlobHeight) * BlobHeight;
-
-        uint8_t CurrentHeight = AllChannels[Sc];
-
-        if (TargetHeight > CurrentHeight)
-        {
-            // Grow upward by one blob
-            uint8_t NewHeight = CurrentHeight + BlobHeight;
-            if (NewHeight > TargetHeight)
-                NewHeight = TargetHeight;
-
-            y2 = y1 + GraphHeight - CurrentHeight - BlobHeight; // top of new blob
-            SendCharArray(CB, fyll,
-                          Str(NB, x2, 1),
-                          Str(NB1, y2, 1),
-                          Str(NB2, BlobWidth, 1),
-                          Str(NB3, BlobHeight, 1),
-                          NewYellow, NA, NA, NA, NA, NA, NA);
-
-            AllChannels[Sc] = NewHeight;
-        }
-        else if (TargetHeight < CurrentHeight)
-        {
-            // Shrink: only reduce if NoCarrier threshold met
-            ++NoCarrier[Sc];
-            if (NoCarrier[Sc] >= ScanSensitivity)
-            {
-                uint8_t NewHeight = CurrentHeight - BlobHeight;
-                if (NewHeight < TargetHeight)
-                    NewHeight = TargetHeight;
-
-                y2 = y1 + GraphHeight - CurrentHeight; // top of blob to erase
-                SendCharArray(CB, fyll,
-                              Str(NB, x2, 1),
-                              Str(NB1, y2, 1),
-                              Str(NB2, BlobWidth, 1),
-                              Str(NB3, BlobHeight, 1),
-                              Str(NB4, 0, 0), NA, NA, NA, NA, NA, NA);
-
-                AllChannels[Sc] = NewHeight;
-                NoCarrier[Sc] = 0;
-            }
-        }
-        else
-        {
-            // On target — if a hit arrived this sweep, refresh the colour
-            // (handles the case where a rescale left stale black pixels)
-            if (RawHits[Sc] && CurrentHeight > 0)
-            {
-                y2 = y1 + GraphHeight - CurrentHeight;
-                SendCharArray(CB, fyll,
-                              Str(NB, x2, 1),
-                              Str(NB1, y2, 1),
-                              Str(NB2, BlobWidth, 1),
-                              Str(NB3, BlobHeight, 1),
-                              NewYellow, NA, NA, NA, NA, NA, NA);
-            }
-        }
-    }
+    // ── Stage 2: draw (a touch is handled first, and a display that's still busy just misses a sweep) ──
+    if (NextionInputWaiting() || NextionQueueUsed() > SCANMAXBACKLOG)
+        return;
+    StartNextionRenderTiming("Scanner sweep");
+    if (ScanMode == SCANWATERFALL)
+        DrawWaterfallRow(RawHits);
+    else
+        DrawScanBars(RawHits);
 
     // ── Best / worst channel reporting ────────────────────────────────────────
     static uint16_t BestScore = 0;
     static uint16_t WorstScore = 0;
 
-    for (Sc = 0; Sc < 83; ++Sc)
+    for (uint8_t Sc = 0; Sc < 83; ++Sc)
     {
         if (TotalHits[Sc] <= TotalHits[BestScore])
             BestScore = Sc;
@@ -699,13 +755,21 @@ void ScanAllChannels(bool cls)
             WorstScore = Sc;
     }
 
-    strcpy(NextionCommand, "");
+    ClearNextionCommand();
     BuildValue(Quietest, BestScore);
     BuildValue(Noisyest, WorstScore);
     BuildValue(Count1, TotalHits[WorstScore]);
     BuildValue(Count, TotalHits[BestScore]);
     SendCommand(NextionCommand);
 }
+
+/************************************************************************************************************/
+void CycleScanMode() // bars, bars with peak hold, waterfall
+{
+    if (++ScanMode > SCANWATERFALL)
+        ScanMode = SCANBARS;
+    RescanWaveband();
+}
 // ************************************************************************************************************/
 #ifdef DB_FHSS
 float PStartTime = 0;
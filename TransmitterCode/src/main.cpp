@@ -145,10 +145,14 @@
 #include "ModelExchange.h"
 #include "BuddyWireless.h"
 #include "SDcard.h"
+#include "ModelSections.h"
 #include "Telemetry.h"
 #include "LogFiles.h"
 #include "DualRates.h"
 #include "Mixes.h"
+#include "Curves.h"
+#include "Pipeline.h"
+#include "Crossfade.h"
 #include "MenuOptions.h"
 #include "LogFilesList.h"
 #include "Help.h"
@@ -163,12 +167,20 @@
 #include "RF_PID_Advanced.h"
 #include "RF_Save_Restore.h"
 #include "SDFiles.h"
+#include "ModelCatalog.h"
+#include "ModelStore.h"
+#include "Blackbox.h"
+#include "DirectoryCache.h"
+#include "BackupStore.h"
+#include "FlightSummaries.h"
 #include "ChooseImage.h"
 #include "Calibrate.h"
+#include "InputFilters.h"
 #include "RF_Governor_Profile.h"
 #include "RF_Governor_Global.h"
 #include "Model_IDs.h"
 #include "Motor_sign.h"
+#include "TextCommands.h"
 
 /*********************************************************************************************************************************/
 
@@ -248,6 +260,7 @@ void RedLedOn() // heer
             PlaySound(DISCONNECTEDMSG);
         if (UseLog)
             LogDisConnection();
+        SaveFlightSummary();
         if (CurrentView == FRONTVIEW)
         {
             SendText((char *)"Connected", na);
@@ -396,112 +409,75 @@ FASTRUN void ShowServoPos()
         StickPosition = constrain(StickPosition, BOXLEFT + 2, (BOXRIGHT - BOXLEFT) - 1);                          // not outside box!
 
         // Only redraw if the position has changed enough
-        if ((abs(StickPosition - SavedLineX) > MinimumDistance))
+        if (!CurveCursorX || (abs(StickPosition - SavedLineX) > MinimumDistance))
         {
-            // Simply do a full redraw - this is easiest and most reliable
-            DisplayCurve();
-            // Then draw vertical line for stick position on top
-            DrawLine(StickPosition, BOXTOP + 3, StickPosition, (BOXBOTTOM - 3) - BOXTOP, HighlightColour);
+            if (ShownCurveKey != CurveSettingsKey() || ShownCurvePoint != CurrentPoint)
+                DisplayCurve(); // the curve was edited since it was drawn
+            MoveCurveCursor(StickPosition);
             SavedLineX = StickPosition;
         }
     }
 }
 
 /*********************************************************************************************************************************/
-uint16_t CatmullSplineInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
-{
-    xPoints[0] = ChannelMin[InputChannel];
-    xPoints[1] = ChannelMidLow[InputChannel];
-    xPoints[2] = ChannelCentre[InputChannel];
-    xPoints[3] = ChannelMidHi[InputChannel];
-    xPoints[4] = ChannelMax[InputChannel];
-    yPoints[4] = IntoHigherRes(CurveDots[4]);
-    yPoints[3] = IntoHigherRes(CurveDots[3]);
-    yPoints[2] = IntoHigherRes(CurveDots[2]);
-    yPoints[1] = IntoHigherRes(CurveDots[1]);
-    yPoints[0] = IntoHigherRes(CurveDots[0]);
-    return Interpolation::CatmullSpline(xPoints, yPoints, PointsCount, InputValue);
-}
+/**************************** This function implements slowed servos for flaps, U/Cs etc. ****************************************/
 /*********************************************************************************************************************************/
-uint16_t StraightLineInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
+// Slowed servos (flaps, U/Cs etc.) move towards their target at ServoSpeed x 100 microseconds per second whatever the packet
+// rate. ServoSpeedDown can give a different speed for the return journey. Positions are 16.16 fixed point so even very slow
+// servos advance a little on every pass. Only the channels in SlowedChannels are visited.
+FASTRUN void SlowAnyServos()
 {
-    uint16_t k = 0;
-    if (InputValue >= ChannelMidHi[InputChannel])
-    {
-        k = map(InputValue, ChannelMidHi[InputChannel], ChannelMax[InputChannel], IntoHigherRes(CurveDots[3]), IntoHigherRes(CurveDots[4]));
-    }
-
-    if (InputValue >= ChannelCentre[InputChannel] && InputValue <= (ChannelMidHi[InputChannel]))
-    {
-        k = map(InputValue, ChannelCentre[InputChannel], ChannelMidHi[InputChannel], IntoHigherRes(CurveDots[2]), IntoHigherRes(CurveDots[3]));
-    }
-
-    if (InputValue >= ChannelMidLow[InputChannel] && InputValue <= ChannelCentre[InputChannel])
-    {
-        k = map(InputValue, ChannelMidLow[InputChannel], ChannelCentre[InputChannel], IntoHigherRes(CurveDots[1]), IntoHigherRes(CurveDots[2]));
-    }
-
-    if (InputValue <= ChannelMidLow[InputChannel])
-    {
-        k = map(InputValue, ChannelMin[InputChannel], ChannelMidLow[InputChannel], IntoHigherRes(CurveDots[0]), IntoHigherRes(CurveDots[1]));
+    static uint32_t LastSlewTime = 0;
+    uint32_t RightNow = micros();
+    uint32_t Elapsed = RightNow - LastSlewTime;
+    LastSlewTime = RightNow;
+    if (Elapsed > MAXSLEWINTERVAL)
+        Elapsed = MAXSLEWINTERVAL;
+
+    uint16_t Pending = SlowedChannels;
+    while (Pending)
+    {
+        uint8_t i = __builtin_ctz(Pending);
+        Pending &= Pending - 1;
+        uint32_t Target = (uint32_t)SendBuffer[i] << 16;
+        if (!CurrentPosition[i])
+            CurrentPosition[i] = Target; // Must start somewhere
+        uint8_t Speed = ServoSpeed[Bank - 1][i];
+        if ((Target < CurrentPosition[i]) && ServoSpeedDown[Bank - 1][i])
+            Speed = ServoSpeedDown[Bank - 1][i];
+        if (Speed >= 100)
+        {
+            CurrentPosition[i] = Target; // full speed this way
+        }
+        else
+        {
+            uint32_t Step = ((uint64_t)Elapsed * Speed * 8192) / 1250; // 100 us per second per unit of speed = 6.5536 (in 16.16) per us
+            if (Target > CurrentPosition[i])
+                CurrentPosition[i] = ((Target - CurrentPosition[i]) > Step) ? CurrentPosition[i] + Step : Target;
+            else
+                CurrentPosition[i] = ((CurrentPosition[i] - Target) > Step) ? CurrentPosition[i] - Step : Target;
+        }
+        SendBuffer[i] = (CurrentPosition[i] + 0x8000) >> 16; // Modify next servo position
+        PreMixBuffer[i] = SendBuffer[i];                      // Maybe mix the slowed version
     }
-
-    return k;
 }
 /*********************************************************************************************************************************/
-uint16_t ExponentialInterpolation(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel)
+// Which channels are slowed in the current bank? Rebuilt with the pipeline dependencies (bank change, model load, edits etc.)
+void BuildSlowedChannels()
 {
-    uint16_t k = 0;
-    if (InputValue >= ChannelCentre[InputChannel])
+    uint16_t Mask = 0;
+    for (uint8_t i = 0; i < CHANNELSUSED; ++i)
     {
-        k = MapWithExponential(InputValue - ChannelCentre[InputChannel], 0, ChannelMax[InputChannel] - ChannelCentre[InputChannel], 0, IntoHigherRes(CurveDots[4]) - IntoHigherRes(CurveDots[2]), Exponential[Bank][OutputChannel]) + IntoHigherRes(CurveDots[2]);
+        uint8_t Down = ServoSpeedDown[Bank - 1][i];
+        if ((ServoSpeed[Bank - 1][i] < 100) || (Down && Down < 100))
+            Mask |= (1 << i);
     }
-    else
+    for (uint8_t i = 0; i < CHANNELSUSED; ++i)
     {
-        k = MapWithExponential(ChannelCentre[InputChannel] - InputValue, 0, ChannelCentre[InputChannel] - ChannelMin[InputChannel], IntoHigherRes(CurveDots[2]) - IntoHigherRes(CurveDots[0]), 0, Exponential[Bank][OutputChannel]) + IntoHigherRes(CurveDots[0]);
-    }
-    return k;
-}
-
-/*********************************************************************************************************************************/
-// ************* Small function pointer array for interpolation types ************************************************************
-
-uint16_t (*Interpolate[3])(uint16_t InputValue, uint16_t InputChannel, uint16_t OutputChannel){
-    StraightLineInterpolation,  // 0
-    CatmullSplineInterpolation, // 1
-    ExponentialInterpolation    // 2
-};
-
-/*********************************************************************************************************************************/
-/**************************** This function implements slowed servos for flaps, U/Cs etc. ****************************************/
-/*********************************************************************************************************************************/
-
-void SlowAnyServos() // This function implements slowed servos for flaps, U/Cs etc.
-{
-    static uint32_t SlowTime[16]; // TODO: Make it BY BANK and not every bank <<<<<<<<<<<<<<*****************************
-    for (int i = 0; i < 16; ++i)
-    { // Test every channel
-        if (ServoSpeed[Bank - 1][i] < 100)
-        { // If ServoSpeed = 100, use full speed. No slowing
-            if ((millis() - SlowTime[i]) > 10)
-            {                           // This next part runs only 100 times per second
-                SlowTime[i] = millis(); // Store start time of this iteration
-                if (CurrentPosition[i] == 0)
-                    CurrentPosition[i] = SendBuffer[i];            // Must start somewhere
-                int distance = SendBuffer[i] - CurrentPosition[i]; // Define how far to move
-                int SSize = ServoSpeed[Bank - 1][i];               // Get step size
-                if (SSize > abs(distance))
-                    SSize = 1; // This avoids overshooting the limit
-                if (distance < 0)
-                    SSize = -SSize; // Negative?
-                if (!distance)
-                    SSize = 0;               // Already arrived?
-                CurrentPosition[i] += SSize; // Move Current Position a little bit towards goal
-            }
-            SendBuffer[i] = CurrentPosition[i]; // Modify next servo position
-            PreMixBuffer[i] = SendBuffer[i];    // Maybe mix the slowed version
-        }
+        if ((SlowedChannels & ~Mask) & (1 << i))
+            CurrentPosition[i] = 0; // No longer slowed, so restart from wherever it is if slowed again
     }
+    SlowedChannels = Mask;
 }
 /*********************************************************************************************************************************/
 void RerouteOutputs()
@@ -519,42 +495,15 @@ void RerouteOutputs()
     }
 }
 
-/*********************************************************************************************************************************/
-
-void DoTrimsAndSubtrims()
-{
-
-    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
-    {
-        uint16_t InputChannel = InPutStick[OutputChannel]; // Input sticks knobs & switches are mapped by user
-        // ClaudeFix-2-7-2026 Signed maths! SendBuffer is uint16_t: a low curve value plus a negative
-        // subtrim/trim used to wrap below zero to ~65000, and constrain then
-        // clamped it to MAXMICROS -- FULL deflection in the WRONG direction.
-        int TrimmedValue = (int)SendBuffer[OutputChannel];
-        TrimmedValue += (SubTrims[OutputChannel] - 127) * 5;                       // ADD SUBTRIM to output channel, (Range 0 - 127 - 254) multiplier is always 5 otherwise subtrim might keep changing
-        TrimmedValue += GetTrimAmount(InputChannel);                               // ADD TRIM to output channel
-        SendBuffer[OutputChannel] = constrain(TrimmedValue, MINMICROS, MAXMICROS); // Keep within limits
-        PreMixBuffer[OutputChannel] = SendBuffer[OutputChannel];                   // premixbuffer will be needed again...
-    }
-}
-//**************************************************************************************************************************************************************
-void CalculateAllOutputs()
-{
-    for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
-    {
-        GetCurveDots(OutputChannel, DualRateValue);                                                                                                                // This for the Dual Rates function
-        PreMixBuffer[OutputChannel] = Interpolate[InterpolationTypes[Bank][OutputChannel]](InputsBuffer[OutputChannel], InPutStick[OutputChannel], OutputChannel); // Use function pointer array to invoke selected interpolation.
-        SendBuffer[OutputChannel] = PreMixBuffer[OutputChannel];                                                                                                   // Copy now to SendBuffer in case no mixes are needed
-    }
-}
 //**************************************************************************************************************************************************************
 void GetAllInputs()
 {
+    ReadFilteredInputs(); // Each stick and knob is read once, filtered and deadbanded (see InputFilters.h)
     for (uint16_t OutputChannel = 0; OutputChannel < CHANNELSUSED; ++OutputChannel)
     {
         if (InPutStick[OutputChannel] < 8)
         {
-            InputsBuffer[OutputChannel] = AnalogueReed(InPutStick[OutputChannel]); // Get values from sticks' pots (taking into account mode 1 and mode 2!)
+            InputsBuffer[OutputChannel] = FilteredInput[InPutStick[OutputChannel]]; // Get values from sticks' pots (taking into account mode 1 and mode 2!)
         }
         else
         {
@@ -571,14 +520,61 @@ FASTRUN void GetNewChannelValues()
     if (!NewCompressNeeded)
     {
         NewCompressNeeded = true;
-        GetAllInputs();        // Get all user inputs from sticks, pots and switches
-        MixInputs();           // Mixes InputsBuffer[] and returns results in InputsBuffer[] (All 16 channels)
-        CalculateAllOutputs(); // Calculate all outputs
-        SlowAnyServos();       // Some servos may need to be slowed down for flaps etc.
-        MixOutputs();          // If needed, Mixes PremixBuffer and returns it in SendBuffer.
-        DoTrimsAndSubtrims();  // Add trims to output after mixing.
-        RerouteOutputs();      // This function might re-route outputs to user-defined channels.
-        ServoReverse();        // This function reverses servos if needed.
+#ifdef DB_PIPELINE
+        uint32_t PipelineStart = micros();
+#endif
+        ScanSwitchesFast();                 // Debounced switches every pass: motor kill, safety and bank act at once
+        GetAllInputs();                     // Get all user inputs from sticks, pots and switches
+        uint16_t Dirty = GetDirtyOutputs(); // Which channels' inputs have changed since last time?
+        CheckForBankCrossfade();            // Has the bank just changed?
+        if (BankCrossfading)                //
+            EvaluateCrossfadeBank();        // If so, the OLD bank is evaluated first, into CrossfadeBuffer[]
+        MixInputs();                        // Mixes InputsBuffer[] and returns results in InputsBuffer[] (All 16 channels)
+        CalculateChangedOutputs(Dirty);     // Calculate only those outputs whose inputs changed
+        SlowAnyServos();                    // Some servos may need to be slowed down for flaps etc.
+        MixOutputs();                       // If needed, Mixes PremixBuffer and returns it in SendBuffer.
+        DoTrimsAndSubtrims();               // Add trims to output after mixing.
+        if (BankCrossfading)                //
+            BlendBanks();                   // Blend old bank's outputs into new bank's
+        RerouteOutputs();                   // This function might re-route outputs to user-defined channels.
+        ServoReverse();                     // This function reverses servos if needed.
+#ifdef DB_PIPELINE
+        static uint32_t PipelineMicros = 0;
+        static uint32_t PipelineMaxMicros = 0;
+        static uint32_t PipelineCurves = 0;
+        static uint32_t PipelinePasses = 0;
+        static uint32_t PipelineFadePasses = 0;
+        static uint32_t PipelineReportTime = 0;
+        uint32_t ThisPass = micros() - PipelineStart;
+        PipelineMicros += ThisPass;
+        if (ThisPass > PipelineMaxMicros)
+            PipelineMaxMicros = ThisPass;
+        PipelineCurves += __builtin_popcount(Dirty);
+        if (BankCrossfading)
+            ++PipelineFadePasses;
+        ++PipelinePasses;
+        if (millis() - PipelineReportTime >= 1000)
+        {
+            PipelineReportTime = millis();
+            Look1("Pipeline passes: ");
+            Look1(PipelinePasses);
+            Look1("  Average us per pass: ");
+            Look1((float)PipelineMicros / PipelinePasses);
+            Look1("  Average curves per pass: ");
+            Look1((float)PipelineCurves / PipelinePasses);
+            Look1("  Max us: ");
+            Look1(PipelineMaxMicros);
+            Look1("  Crossfade passes: ");
+            Look1(PipelineFadePasses);
+            Look1("  Budget us: ");
+            Look(FHSS_data::PaceMaker * 1000); // The whole loop, not just the pipeline, must fit inside this.
+            PipelineMicros = 0;
+            PipelineMaxMicros = 0;
+            PipelineFadePasses = 0;
+            PipelineCurves = 0;
+            PipelinePasses = 0;
+        }
+#endif
     }
 }
 /*********************************************************************************************************************************/
@@ -943,7 +939,9 @@ FLASHMEM void setup()
     pinMode(POWER_OFF_PIN, OUTPUT);
     digitalWrite(POWER_OFF_PIN, LOW); // default is LOW anyway. HIGH to turn off
     BlueLedOn();
-    NEXTION.begin(921600); // BAUD rate also set in display code THIS IS THE MAX
+    NEXTION.addMemoryForRead(NextionRxBuffer, sizeof(NextionRxBuffer));
+    NEXTION.addMemoryForWrite(NextionTxBuffer, sizeof(NextionTxBuffer));
+    NEXTION.begin(NEXTIONMAXBAUD); // BAUD rate also set in display code THIS IS THE MAX. StartNextionLink() checks it.
     InitMaxMin();
     InitCentreDegrees();
     SetBrightness(1);
@@ -961,18 +959,25 @@ FLASHMEM void setup()
     delay(300); // <<********************* MUST ALLOW DOG TO INITIALISE
 
     DelayWithDog(WARMUPDELAY);
+    StartNextionLink(); // Display has booted by now
 
     if (CheckFileExists(ModelsFile))
     {
+        ReplayModelsJournal(); // Finish any save that a power cut interrupted
+        if (!ReadModelCatalog())
+            MigrateOldModels(); // models.dat is new to us, so it may hold models without section directories
         if (!LoadAllParameters())
         { // if file not good ..
             ErrorState = CHECKSUMERROR;
         }
+        LoadModelStore();
+        LoadModelCatalog();
     }
     else
     {
         ErrorState = MODELSFILENOTFOUND; // if no file ... or no SD
     }
+    StartBlackbox(); // Ready to record packets when logging is on
 
     SetBrightness(1);         // Set low brightness for splash screen
     SendCommand(pSplashView); // show splash screen **************************
@@ -1090,6 +1095,7 @@ void RationaliseBuddy()
         FHSS_data::PaceMaker = PACEMAKER_BUDDY;
         LinkRatesToBanks = true;
     }
+    InitInputFilters(); // Filter coefficients depend on the pipeline (packet) rate
 }
 /*********************************************************************************************************************************/
 void GetFrameRate()
@@ -1123,88 +1129,6 @@ int InStrng(char *text1, char *text2)
     return 0; // Found no match
 }
 
-/***********************************************************************************************************/
-
-int GetDateAsInt(int f)
-{ // dates are in format 23-08-24.LOG ie 23rd August '24
-  // DateInt is 23 + (8 * 31)  + (24 * 31 * 12) =  23 + 248 + 8768 = 9019
-    int DateInt = 0;
-    char Date[10];
-    for (int i = 0; i < 2; ++i)
-        Date[i] = TheFilesList[f][i];
-    Date[2] = 0;
-    DateInt = atoi(Date); // the DAY
-    for (int i = 3; i < 5; ++i)
-        Date[i - 3] = TheFilesList[f][i];
-    Date[2] = 0;
-    DateInt += atoi(Date) * 31; // the MONTH
-    for (int i = 6; i < 8; ++i)
-        Date[i - 6] = TheFilesList[f][i];
-    Date[2] = 0;
-    DateInt += atoi(Date) * 31 * 12; // the YEAR
-    return DateInt;
-}
-
-/***********************************************************************************************************/
-void SortByDateInDescendingOrder()
-{
-    int f = 0;
-    bool flag = true;
-    int Scount = 0;
-    char TempArray[18];
-    int d1, d2;
-    while (flag && Scount < 10000)
-    {
-        flag = false;
-        for (f = 0; f < ExportedFileCounter - 1; ++f)
-        {
-            d1 = GetDateAsInt(f);
-            d2 = GetDateAsInt(f + 1);
-            if (d1 < d2)
-            { // Sort by date in descending order so recent log files are at the top
-                strcpy(TempArray, TheFilesList[f]);
-                strcpy(TheFilesList[f], TheFilesList[f + 1]);
-                strcpy(TheFilesList[f + 1], TempArray);
-                flag = true;
-                ++Scount;
-            }
-        }
-    }
-}
-/****************************************************************************************************************************/
-
-/** Bubble sort */
-void SortDirectory() // Bubble sort for alphabetising the files. Not ideal for dates but OK for names.
-                     // TODO: Make a version that sorts by date in reverse order
-{
-    int f = 0;
-    bool flag = true;
-    int Scount = 0;
-    char TempArray[18];
-
-    if (strcmp(MOD, ".LOG") == 0)
-    { // if it's a log file, sort by date in descending order
-        SortByDateInDescendingOrder();
-        return;
-    }
-
-    while (flag && Scount < 10000)
-    {
-        flag = false;
-        for (f = 0; f < ExportedFileCounter - 1; ++f)
-        {
-            if (strcmp(TheFilesList[f], TheFilesList[f + 1]) > 0)
-            {
-                strcpy(TempArray, TheFilesList[f]);
-                strcpy(TheFilesList[f], TheFilesList[f + 1]);
-                strcpy(TheFilesList[f + 1], TempArray);
-                flag = true;
-                ++Scount;
-            }
-        }
-    }
-}
-
 /*********************************************************************************************************************************/
 /** @brief Discover which channel to setup */
 int GetChannel()
@@ -1433,7 +1357,6 @@ int AnalogueReed(uint8_t InputChannel)
 
 void SetDefaultValues()
 {
-    uint16_t j = 0;
     uint16_t i = 0;
     char empty[33] = "Not in use";
 
@@ -1446,150 +1369,9 @@ void SetDefaultValues()
         ModelName[i + 1] = 0;
         ++i;
     }
-
-    char DefaultChannelNames[CHANNELSUSED][11] = {{"Aileron"}, {"Elevator"}, {"Throttle"}, {"Rudder"}, {"Ch 5"}, {"Ch 6"}, {"Ch 7"}, {"Ch 8"}, {"Ch 9"}, {"Ch 10"}, {"Ch 11"}, {"Ch 12"}, {"Ch 13"}, {"Ch 14"}, {"Ch 15"}, {"Ch 16"}};
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        for (j = 1; j <= 4; ++j)
-        {
-            MaxDegrees[j][i] = 150;
-            MidHiDegrees[j][i] = 120;
-            CentreDegrees[j][i] = 90;
-            MidLowDegrees[j][i] = 60;
-            MinDegrees[j][i] = 30;
-        }
-    }
-
-    for (j = 0; j < MAXMIXES; ++j)
-    {
-        for (i = 0; i < CHANNELSUSED; ++i)
-        {
-            Mixes[j][i] = 0;
-        }
-    }
-
-    for (j = 0; j < BANKS_USED + 1; ++j)
-    { // must have fudged this somewhere.... Probably 1-5 instead of 0-4
-        for (i = 0; i < CHANNELSUSED; ++i)
-        {
-            Trims[j][i] = 80; // MIDPOINT is 80 !
-        }
-    }
-    RXCellCount = 3;
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        InPutStick[i] = i;
-        ChannelOutPut[i] = i;
-    }
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        FailSafeChannel[i] = false;
-    }
-
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        for (j = 0; j < 10; ++j)
-        {
-            ChannelNames[i][j] = DefaultChannelNames[i][j];
-        }
-    }
-    for (j = 1; j <= BANKS_USED; ++j)
-    {
-        for (i = 0; i < CHANNELSUSED; ++i)
-        {
-            Exponential[j][i] = DEFAULT_EXPO; // 0% (50) expo = default
-        }
-    }
-    for (j = 1; j <= BANKS_USED; ++j) // ClaudeFix-2-7-2026 banks are 1-based at runtime (matches the Exponential loop above); 0..3 left bank 4 inheriting the previous model's curve types
-    {
-        for (i = 0; i < CHANNELSUSED; ++i)
-        {
-            InterpolationTypes[j][i] = EXPONENTIALCURVES; // Expo is default
-        }
-    }
-    for (i = 0; i < CHANNELSUSED; ++i)
-    {
-        SubTrims[i] = 127; // centre (0 - 254)
-    }
-    for (j = 0; j < BYTESPERMACRO; ++j)
-    {
-        for (i = 0; i < MAXMACROS; ++i)
-        {
-            MacrosBuffer[i][j] = 0;
-        }
-    }
-    for (int i = 0; i < 4; ++i)
-    {
-        InputTrim[i] = i;
-    }
-
-    if (CurrentView == CALIBRATEVIEW)
-    {
-        UseMotorKill = false;
-        MotorChannelZero = 50;
-        MotorChannel = 15;
-    }
-    else
-    {
-        UseMotorKill = true;
-        MotorChannelZero = 30;
-        MotorChannel = 2;
-    }
-
-    ReversedChannelBITS = 0; //  No channel reversed
-    RxVoltageCorrection = 0;
-    ModelsMacUnionSaved.Val64 = 0;
+    for (i = 0; i < sizeof(ModelSectionKinds) / sizeof(ModelSectionKinds[0]); ++i)
+        SetSectionDefaults(ModelSectionKinds[i].ID);
     UseDualRates = false;
-    Drate1 = 100;
-    Drate2 = 75;
-    Drate3 = 50;
-    DualRateChannels[0] = 1;
-    DualRateChannels[1] = 2;
-    DualRateChannels[2] = 4;
-    DualRateChannels[3] = 0;
-    DualRateChannels[4] = 0;
-    DualRateChannels[5] = 0;
-    DualRateChannels[6] = 0;
-    DualRateChannels[7] = 0;
-
-    for (int i = 0; i < 4; ++i)
-    {
-        BanksInUse[i] = i + 4;
-    }
-    for (int j = 0; j < 4; ++j)
-    {
-        for (int i = 0; i < 16; ++i)
-        {
-            ServoSpeed[j][i] = 100;
-        }
-    }
-    for (i = 0; i < 4; ++i)
-    {
-        DualRateRate[i] = 0;
-    }
-    TrimMultiplier = 5;
-    for (int i = 0; i < 11; ++i)
-    {
-        ServoFrequency[i] = 50;
-        ServoCentrePulse[i] = 1500;
-    }
-    ArmingChannel = 6; // for Rotorflight
-    GearRatio = 10.3;  // for helicopters with swash plates. This is the ratio between servo movement and blade pitch change. 10.3 is a typical value for a 700 size heli
-    for (j = 0; j < 4; ++j)
-    {
-        for (i = 0; i < MAX_PID_WORDS + 5; ++i)
-            Saved_PID_Values[i][j] = 0;
-        for (i = 0; i < MAX_RATES_BYTES; ++i)
-            Saved_Rate_Values[i][j] = 0;
-        for (i = 0; i < MAX_RATES_ADVANCED_BYTES; ++i)
-            Saved_Rate_Advanced_Values[i][j] = 0;
-        for (i = 0; i < MAX_PIDS_ADVANCED_BYTES; ++i)
-            Saved_PID_Advanced_Values[i][j] = 0;
-    }
-    strcpy(ModelImageFileName, "Noimage");
     DisplayModelImage();
     ModelDefined = 42;
 }
@@ -1677,15 +1459,46 @@ FASTRUN void updateInterpolationTypes()
 }
 
 /*********************************************************************************************************************************/
+// The curve on the graph screen is drawn as line segments. Working them out means calling the interpolation functions
+// point by point, so they are cached, keyed by everything that shapes the curve. An edit changes the key and so
+// the curve is worked out again. Going back to a curve seen recently finds it still cached.
 
-FASTRUN void DisplayCurve()
+uint32_t CurveSettingsKey()
+{
+    uint8_t c = ChanneltoSet - 1;
+    uint8_t Settings[] = {Bank, ChanneltoSet, InterpolationTypes[Bank][c], Exponential[Bank][c], MinDegrees[Bank][c],
+                          MidLowDegrees[Bank][c], CentreDegrees[Bank][c], MidHiDegrees[Bank][c], MaxDegrees[Bank][c]};
+    uint32_t Hash = FNV1A_SEED;
+    for (uint8_t i = 0; i < sizeof(Settings); ++i)
+        Hash = FNV1aHashByte(Hash, Settings[i]);
+    return Hash;
+}
+
+/*********************************************************************************************************************************/
+void AddCurveSegment(CachedCurve *Curve, int x1, int y1, int x2, int y2)
 {
+    if (Curve->Count >= MAXCURVESEGMENTS)
+        return;
+    CurveSegment *s = &Curve->Segment[Curve->Count++];
+    s->x1 = x1;
+    s->y1 = y1;
+    s->x2 = x2;
+    s->y2 = y2;
+}
 
-    int p = 0;
-    char cmdBuffer[512] = "";          // Buffer for commands
-    char tempCmd[80];                  // Temporary buffer for individual commands
-    char endMarker[] = "\xFF\xFF\xFF"; // Nextion end marker
+/*********************************************************************************************************************************/
+void AppendCurveSegment(char *cmdBuffer, CurveSegment *s)
+{
+    char tempCmd[80];
+    sprintf(tempCmd, "line %d,%d,%d,%d,%d\xFF\xFF\xFF", s->x1, s->y1, s->x2, s->y2, ForeGroundColour);
+    strcat(cmdBuffer, tempCmd);
+}
+
+/*********************************************************************************************************************************/
+// Works out the segments for the current channel's curve. xPoints[] and yPoints[] must be set (GetDotPositions()).
 
+FASTRUN void BuildCurveSegments(CachedCurve *Curve)
+{
     float HalfXRange;
     float TopHalfYRange;
     float BottomHalfYRange;
@@ -1693,56 +1506,261 @@ FASTRUN void DisplayCurve()
     int yDot1;
     int xDot2 = 0;
     int yDot2 = 0;
-    int DotSize = 4;
-    int DotColour = 65535; // White
     double xPoint, yPoint;
 
-    // Constrain degrees values
-    p = constrain(MinDegrees[Bank][ChanneltoSet - 1], 0, 180);
-    MinDegrees[Bank][ChanneltoSet - 1] = p;
-    p = constrain(MidLowDegrees[Bank][ChanneltoSet - 1], 0, 180);
-    MidLowDegrees[Bank][ChanneltoSet - 1] = p;
-    p = constrain(CentreDegrees[Bank][ChanneltoSet - 1], 0, 180);
-    CentreDegrees[Bank][ChanneltoSet - 1] = p;
-    p = constrain(MidHiDegrees[Bank][ChanneltoSet - 1], 0, 180);
-    MidHiDegrees[Bank][ChanneltoSet - 1] = p;
-    p = constrain(MaxDegrees[Bank][ChanneltoSet - 1], 0, 180);
-    MaxDegrees[Bank][ChanneltoSet - 1] = p;
-
-    GetDotPositions();
+    Curve->Count = 0;
+    if (InterpolationTypes[Bank][ChanneltoSet - 1] == STRAIGHTLINES)
+    { // Linear
+        for (uint8_t i = 0; i < 4; ++i)
+            AddCurveSegment(Curve, xPoints[i], yPoints[i], xPoints[i + 1], yPoints[i + 1]);
+    }
+    else if (InterpolationTypes[Bank][ChanneltoSet - 1] == SMOOTHEDCURVES)
+    { // CatmullSpline
+        yDot2 = 0;
+        int adaptiveStep = 12; // Larger than original 8 to reduce points
 
-    // 1. First batch: Clear box and send top row values
+        for (xPoint = xPoints[0]; xPoint <= xPoints[4]; xPoint += adaptiveStep)
+        {
+            if (adaptiveStep > xPoints[4] - xPoint)
+            {
+                adaptiveStep = xPoints[4] - xPoint;
+            }
+            if (adaptiveStep < 1)
+                adaptiveStep = 1;
 
-    // Clear the box
+            yPoint = Interpolation::CatmullSpline(xPoints, yPoints, PointsCount, xPoint);
+            xDot1 = xPoint;
+            yDot1 = yPoint;
 
-    sprintf(tempCmd, "fill %d,%d,%d,%d,%d", 36, 36, 360, 360, 0);
+            if (yDot2 == 0)
+            {
+                xDot2 = xDot1;
+                yDot2 = yDot1;
+                continue; // Skip first point, nothing to draw yet
+            }
+            AddCurveSegment(Curve, xDot1, yDot1, xDot2, yDot2);
+            xDot2 = xDot1;
+            yDot2 = yDot1;
+        }
+    }
+    else if (InterpolationTypes[Bank][ChanneltoSet - 1] == EXPONENTIALCURVES)
+    { // EXPO
+        HalfXRange = xPoints[4] - xPoints[2];
+        TopHalfYRange = yPoints[4] - yPoints[2];
+        BottomHalfYRange = yPoints[2] - yPoints[0];
+        yDot2 = 0;
+        int adaptiveStep = 14; // Increased from APPROXIMATION = 7
 
-    strcat(cmdBuffer, tempCmd);
-    strcat(cmdBuffer, endMarker);
+        // Left half of exponential curve
+        for (xPoint = 0; xPoint <= HalfXRange; xPoint += adaptiveStep)
+        {
+            yPoint = MapWithExponential(HalfXRange - xPoint, HalfXRange, 0, 0, BottomHalfYRange,
+                                        Exponential[Bank][ChanneltoSet - 1]);
+            if (adaptiveStep > HalfXRange - xPoint)
+            {
+                adaptiveStep = HalfXRange - xPoint;
+            }
+            if (adaptiveStep < 1)
+                adaptiveStep = 1;
 
-    // Top row values - sent in a single batch
-    sprintf(tempCmd, "n1.val=%d", DegsToPercent(MinDegrees[Bank][ChanneltoSet - 1]));
-    strcat(cmdBuffer, tempCmd);
-    strcat(cmdBuffer, endMarker);
+            yDot1 = yPoint + yPoints[0];
+            xDot1 = xPoint + xPoints[0];
 
-    sprintf(tempCmd, "n2.val=%d", DegsToPercent(MidLowDegrees[Bank][ChanneltoSet - 1]));
-    strcat(cmdBuffer, tempCmd);
-    strcat(cmdBuffer, endMarker);
+            if (yDot2 == 0)
+            {
+                xDot2 = xDot1;
+                yDot2 = yDot1;
+                continue; // Skip first point, nothing to draw yet
+            }
+            AddCurveSegment(Curve, xDot1, yDot1, xDot2, yDot2);
+            xDot2 = xDot1;
+            yDot2 = yDot1;
+        }
 
-    sprintf(tempCmd, "n3.val=%d", DegsToPercent(CentreDegrees[Bank][ChanneltoSet - 1]));
-    strcat(cmdBuffer, tempCmd);
-    strcat(cmdBuffer, endMarker);
+        // Reset for right half of exponential curve
+        adaptiveStep = 14;
+        yDot2 = 0;
 
-    sprintf(tempCmd, "n4.val=%d", DegsToPercent(MidHiDegrees[Bank][ChanneltoSet - 1]));
-    strcat(cmdBuffer, tempCmd);
-    strcat(cmdBuffer, endMarker);
+        // Right half of exponential curve
+        for (xPoint = HalfXRange; xPoint >= 0; xPoint -= adaptiveStep)
+        {
+            yPoint = MapWithExponential(xPoint, 0, HalfXRange, 0, TopHalfYRange,
+                                        Exponential[Bank][ChanneltoSet - 1]);
+
+            if (adaptiveStep > xPoint)
+            {
+                adaptiveStep = xPoint;
+            }
+            if (adaptiveStep < 1)
+                adaptiveStep = 1;
+
+            yDot1 = yPoint + yPoints[2];
+            xDot1 = xPoint + xPoints[2];
+
+            if (yDot2 == 0)
+            {
+                xDot2 = xDot1;
+                yDot2 = yDot1;
+                continue; // Skip first point, nothing to draw yet
+            }
+            AddCurveSegment(Curve, xDot1, yDot1, xDot2, yDot2);
+            xDot2 = xDot1;
+            yDot2 = yDot1;
+        }
+    }
+}
+
+/*********************************************************************************************************************************/
+FASTRUN CachedCurve *GetCurveSegments()
+{
+    uint32_t Key = CurveSettingsKey();
+    CachedCurve *Curve = &GraphCurveCache[Key % GRAPHCURVECACHESIZE];
+    if (!Curve->Valid || Curve->Key != Key)
+    {
+        BuildCurveSegments(Curve);
+        Curve->Key = Key;
+        Curve->Valid = true;
+    }
+    return Curve;
+}
+
+/*********************************************************************************************************************************/
+// Adds one control point's dot. The selected one gets its rings, as DisplayCurve() draws them.
+void AppendCurveDot(char *cmdBuffer, uint8_t i)
+{
+    char tempCmd[80];
+    int x = (int)xPoints[i];
+    int y = (int)yPoints[i];
+    if (i != CurrentPoint - 1)
+    {
+        sprintf(tempCmd, "cirs %d,%d,%d,%d\xFF\xFF\xFF", x, y, CURVEDOTSIZE, White);
+        strcat(cmdBuffer, tempCmd);
+        return;
+    }
+    sprintf(tempCmd, "cirs %d,%d,%d,%d\xFF\xFF\xFF", x, y, 10, White);
+    strcat(cmdBuffer, tempCmd);
+    sprintf(tempCmd, "cirs %d,%d,%d,%d\xFF\xFF\xFF", x, y, 8, HighlightColour);
+    strcat(cmdBuffer, tempCmd);
+    sprintf(tempCmd, "cirs %d,%d,%d,%d\xFF\xFF\xFF", x, y, 6, HighlightColour);
+    strcat(cmdBuffer, tempCmd);
+    sprintf(tempCmd, "cirs %d,%d,%d,%d\xFF\xFF\xFF", x, y, CURVEDOTSIZE + 3, Black);
+    strcat(cmdBuffer, tempCmd);
+}
+
+/*********************************************************************************************************************************/
+// Moves the stick position line on the graph. The old line is drawn over in the box's colour. Then anything it crossed is
+// drawn again: the reference lines, the curve segments that span that column and any dot close to it. So each move costs
+// a few commands, not a whole new curve.
+
+FASTRUN void MoveCurveCursor(uint16_t NewX)
+{
+    char cmdBuffer[512] = "";
+    char tempCmd[80];
+    int Top = BOXTOP + 3;
+    int Bottom = (BOXBOTTOM - 3) - BOXTOP;
+    int x = CurveCursorX;
+
+    if (x)
+    {
+        GetDotPositions(); // The mixer uses xPoints[] and yPoints[] too
+        sprintf(tempCmd, "line %d,%d,%d,%d,%d\xFF\xFF\xFF", x, Top, x, Bottom, 0);
+        strcat(cmdBuffer, tempCmd);
+        int yRef = (BOXHEIGHT / 2) + 20;
+        if (x >= (int)xPoints[0] && x <= BOXWIDTH)
+        {
+            sprintf(tempCmd, "line %d,%d,%d,%d,%d\xFF\xFF\xFF", (int)xPoints[0], yRef, BOXWIDTH, yRef, SpecialColour);
+            strcat(cmdBuffer, tempCmd);
+        }
+        if (x == (int)xPoints[2])
+        {
+            sprintf(tempCmd, "line %d,%d,%d,%d,%d\xFF\xFF\xFF", x, BOXTOP, x, BOXHEIGHT, SpecialColour);
+            strcat(cmdBuffer, tempCmd);
+        }
+        CachedCurve *Curve = GetCurveSegments();
+        for (uint8_t i = 0; i < Curve->Count && strlen(cmdBuffer) < 400; ++i)
+        {
+            CurveSegment *s = &Curve->Segment[i];
+            if (x >= min(s->x1, s->x2) && x <= max(s->x1, s->x2))
+                AppendCurveSegment(cmdBuffer, s);
+        }
+        bool Expo = (InterpolationTypes[Bank][ChanneltoSet - 1] == EXPONENTIALCURVES);
+        for (uint8_t i = 0; i < 5; ++i)
+        {
+            if (Expo && (i == 1 || i == 3))
+                continue; // not shown
+            if (abs(x - (int)xPoints[i]) <= 10)
+                AppendCurveDot(cmdBuffer, i);
+        }
+    }
+    sprintf(tempCmd, "line %d,%d,%d,%d,%d\xFF\xFF\xFF", NewX, Top, NewX, Bottom, HighlightColour);
+    strcat(cmdBuffer, tempCmd);
+    QueueNextionText(cmdBuffer);
+    CurveCursorX = NewX;
+}
+
+/*********************************************************************************************************************************/
+
+FASTRUN void DisplayCurve()
+{
+
+    int p = 0;
+    char cmdBuffer[512] = "";          // Buffer for commands
+    char tempCmd[80];                  // Temporary buffer for individual commands
+    char endMarker[] = "\xFF\xFF\xFF"; // Nextion end marker
+
+    int xDot1;
+    int yDot1;
+    int xDot2 = 0;
+    int yDot2 = 0;
+    int DotSize = CURVEDOTSIZE;
+    int DotColour = White;
+
+    // Constrain degrees values
+    p = constrain(MinDegrees[Bank][ChanneltoSet - 1], 0, 180);
+    MinDegrees[Bank][ChanneltoSet - 1] = p;
+    p = constrain(MidLowDegrees[Bank][ChanneltoSet - 1], 0, 180);
+    MidLowDegrees[Bank][ChanneltoSet - 1] = p;
+    p = constrain(CentreDegrees[Bank][ChanneltoSet - 1], 0, 180);
+    CentreDegrees[Bank][ChanneltoSet - 1] = p;
+    p = constrain(MidHiDegrees[Bank][ChanneltoSet - 1], 0, 180);
+    MidHiDegrees[Bank][ChanneltoSet - 1] = p;
+    p = constrain(MaxDegrees[Bank][ChanneltoSet - 1], 0, 180);
+    MaxDegrees[Bank][ChanneltoSet - 1] = p;
+
+    GetDotPositions();
+
+    // 1. First batch: Clear box and send top row values
+
+    // Clear the box
+
+    sprintf(tempCmd, "fill %d,%d,%d,%d,%d", 36, 36, 360, 360, 0);
+
+    strcat(cmdBuffer, tempCmd);
+    strcat(cmdBuffer, endMarker);
+
+    // Top row values - sent in a single batch
+    sprintf(tempCmd, "n1.val=%d", DegsToPercent(MinDegrees[Bank][ChanneltoSet - 1]));
+    strcat(cmdBuffer, tempCmd);
+    strcat(cmdBuffer, endMarker);
+
+    sprintf(tempCmd, "n2.val=%d", DegsToPercent(MidLowDegrees[Bank][ChanneltoSet - 1]));
+    strcat(cmdBuffer, tempCmd);
+    strcat(cmdBuffer, endMarker);
+
+    sprintf(tempCmd, "n3.val=%d", DegsToPercent(CentreDegrees[Bank][ChanneltoSet - 1]));
+    strcat(cmdBuffer, tempCmd);
+    strcat(cmdBuffer, endMarker);
+
+    sprintf(tempCmd, "n4.val=%d", DegsToPercent(MidHiDegrees[Bank][ChanneltoSet - 1]));
+    strcat(cmdBuffer, tempCmd);
+    strcat(cmdBuffer, endMarker);
 
     sprintf(tempCmd, "n5.val=%d", DegsToPercent(MaxDegrees[Bank][ChanneltoSet - 1]));
     strcat(cmdBuffer, tempCmd);
     strcat(cmdBuffer, endMarker);
 
     // Send first batch of commands
-    NEXTION.print(cmdBuffer);
+    QueueNextionText(cmdBuffer);
     cmdBuffer[0] = '\0'; // Reset buffer
 
     // 2. Second batch: Draw box and reference lines
@@ -1805,174 +1823,28 @@ FASTRUN void DisplayCurve()
     }
 
     // Send the second batch of commands
-    NEXTION.print(cmdBuffer);
+    QueueNextionText(cmdBuffer);
     cmdBuffer[0] = '\0'; // Reset buffer
 
-    // 4. Draw the curve based on interpolation type
-
-    if (InterpolationTypes[Bank][ChanneltoSet - 1] == STRAIGHTLINES)
-    { // Linear
-        // Draw just 4 straight lines - already efficient, just batch them
-        sprintf(tempCmd, "line %d,%d,%d,%d,%d",
-                (int)xPoints[0], (int)yPoints[0], (int)xPoints[1], (int)yPoints[1], ForeGroundColour);
-        strcat(cmdBuffer, tempCmd);
-        strcat(cmdBuffer, endMarker);
-
-        sprintf(tempCmd, "line %d,%d,%d,%d,%d",
-                (int)xPoints[1], (int)yPoints[1], (int)xPoints[2], (int)yPoints[2], ForeGroundColour);
-        strcat(cmdBuffer, tempCmd);
-        strcat(cmdBuffer, endMarker);
-
-        sprintf(tempCmd, "line %d,%d,%d,%d,%d",
-                (int)xPoints[2], (int)yPoints[2], (int)xPoints[3], (int)yPoints[3], ForeGroundColour);
-        strcat(cmdBuffer, tempCmd);
-        strcat(cmdBuffer, endMarker);
-
-        sprintf(tempCmd, "line %d,%d,%d,%d,%d",
-                (int)xPoints[3], (int)yPoints[3], (int)xPoints[4], (int)yPoints[4], ForeGroundColour);
-        strcat(cmdBuffer, tempCmd);
-        strcat(cmdBuffer, endMarker);
-    }
-    else if (InterpolationTypes[Bank][ChanneltoSet - 1] == SMOOTHEDCURVES)
-    { // CatmullSpline
-        // Use adaptive step size for smooth curves
-        yDot2 = 0;
-        // Increase step size to reduce total points
-        int adaptiveStep = 12; // Larger than original 8 to reduce points
-
-        for (xPoint = xPoints[0]; xPoint <= xPoints[4]; xPoint += adaptiveStep)
-        {
-            if (adaptiveStep > xPoints[4] - xPoint)
-            {
-                adaptiveStep = xPoints[4] - xPoint;
-            }
-            if (adaptiveStep < 1)
-                adaptiveStep = 1;
-
-            yPoint = Interpolation::CatmullSpline(xPoints, yPoints, PointsCount, xPoint);
-            xDot1 = xPoint;
-            yDot1 = yPoint;
-
-            if (yDot2 == 0)
-            {
-                xDot2 = xDot1;
-                yDot2 = yDot1;
-                continue; // Skip first point, nothing to draw yet
-            }
-
-            sprintf(tempCmd, "line %d,%d,%d,%d,%d", xDot1, yDot1, xDot2, yDot2, ForeGroundColour);
-            strcat(cmdBuffer, tempCmd);
-            strcat(cmdBuffer, endMarker);
-
-            // Send if buffer getting full
-            if (strlen(cmdBuffer) > 400)
-            {
-                NEXTION.print(cmdBuffer);
-                cmdBuffer[0] = '\0'; // Reset buffer
-            }
+    // 4. Draw the curve. Its segments are cached and only worked out again when its points change.
 
-            xDot2 = xDot1;
-            yDot2 = yDot1;
-        }
-    }
-    else if (InterpolationTypes[Bank][ChanneltoSet - 1] == EXPONENTIALCURVES)
-    { // EXPO
-        // For exponential curves
+    if (InterpolationTypes[Bank][ChanneltoSet - 1] == EXPONENTIALCURVES)
         CheckInvisiblePoint();
-
-        HalfXRange = xPoints[4] - xPoints[2];
-        TopHalfYRange = yPoints[4] - yPoints[2];
-        BottomHalfYRange = yPoints[2] - yPoints[0];
-        yDot2 = 0;
-
-        // Use adaptive step size but with fewer points
-        int adaptiveStep = 14; // Increased from APPROXIMATION = 7
-
-        // Left half of exponential curve
-        for (xPoint = 0; xPoint <= HalfXRange; xPoint += adaptiveStep)
-        {
-            yPoint = MapWithExponential(HalfXRange - xPoint, HalfXRange, 0, 0, BottomHalfYRange,
-                                        Exponential[Bank][ChanneltoSet - 1]);
-
-            if (adaptiveStep > HalfXRange - xPoint)
-            {
-                adaptiveStep = HalfXRange - xPoint;
-            }
-            if (adaptiveStep < 1)
-                adaptiveStep = 1;
-
-            yDot1 = yPoint + yPoints[0];
-            xDot1 = xPoint + xPoints[0];
-
-            if (yDot2 == 0)
-            {
-                xDot2 = xDot1;
-                yDot2 = yDot1;
-                continue; // Skip first point, nothing to draw yet
-            }
-
-            sprintf(tempCmd, "line %d,%d,%d,%d,%d", xDot1, yDot1, xDot2, yDot2, ForeGroundColour);
-            strcat(cmdBuffer, tempCmd);
-            strcat(cmdBuffer, endMarker);
-
-            // Send if buffer getting full
-            if (strlen(cmdBuffer) > 400)
-            {
-                NEXTION.print(cmdBuffer);
-                cmdBuffer[0] = '\0'; // Reset buffer
-            }
-
-            xDot2 = xDot1;
-            yDot2 = yDot1;
-        }
-
-        // Reset for right half of exponential curve
-        adaptiveStep = 14;
-        yDot2 = 0;
-
-        // Right half of exponential curve
-        for (xPoint = HalfXRange; xPoint >= 0; xPoint -= adaptiveStep)
+    CachedCurve *Curve = GetCurveSegments();
+    for (uint8_t i = 0; i < Curve->Count; ++i)
+    {
+        AppendCurveSegment(cmdBuffer, &Curve->Segment[i]);
+        if (strlen(cmdBuffer) > 400) // Send if buffer getting full
         {
-            yPoint = MapWithExponential(xPoint, 0, HalfXRange, 0, TopHalfYRange,
-                                        Exponential[Bank][ChanneltoSet - 1]);
-
-            if (adaptiveStep > xPoint)
-            {
-                adaptiveStep = xPoint;
-            }
-            if (adaptiveStep < 1)
-                adaptiveStep = 1;
-
-            yDot1 = yPoint + yPoints[2];
-            xDot1 = xPoint + xPoints[2];
-
-            if (yDot2 == 0)
-            {
-                xDot2 = xDot1;
-                yDot2 = yDot1;
-                continue; // Skip first point, nothing to draw yet
-            }
-
-            sprintf(tempCmd, "line %d,%d,%d,%d,%d", xDot1, yDot1, xDot2, yDot2, ForeGroundColour);
-            strcat(cmdBuffer, tempCmd);
-            strcat(cmdBuffer, endMarker);
-
-            // Send if buffer getting full
-            if (strlen(cmdBuffer) > 400)
-            {
-                NEXTION.print(cmdBuffer);
-                cmdBuffer[0] = '\0'; // Reset buffer
-            }
-
-            xDot2 = xDot1;
-            yDot2 = yDot1;
+            QueueNextionText(cmdBuffer);
+            cmdBuffer[0] = '\0'; // Reset buffer
         }
     }
 
     // Send any remaining curve drawing commands
     if (strlen(cmdBuffer) > 0)
     {
-        NEXTION.print(cmdBuffer);
+        QueueNextionText(cmdBuffer);
         cmdBuffer[0] = '\0'; // Reset buffer
     }
 
@@ -2005,7 +1877,7 @@ FASTRUN void DisplayCurve()
     }
 
     // Send the dots batch
-    NEXTION.print(cmdBuffer);
+    QueueNextionText(cmdBuffer);
     cmdBuffer[0] = '\0'; // Reset buffer
 
     // Create a special command to highlight the selected point with a filled circle
@@ -2036,6 +1908,9 @@ FASTRUN void DisplayCurve()
 
     // Update interpolation types UI
     updateInterpolationTypes();
+    ShownCurveKey = Curve->Key;
+    ShownCurvePoint = CurrentPoint;
+    CurveCursorX = 0; // the box was cleared
 }
 
 /*********************************************************************************************************************************/
@@ -2488,8 +2363,10 @@ FASTRUN void DisplayCurveAndServoPos()
 {
     ClearBox();
     DelayWithDog(5);
+    DisplayCurve();
     SavedLineX = 52735; // just to be massvely different
-    ShowServoPos();     // this calls displaycurve!!!
+    ShowServoTimer = 0; // draw the stick position line now
+    ShowServoPos();
     ClearText();
 }
 
@@ -2878,11 +2755,12 @@ void FixFileName()
 }
 
 /******************************************************************************************************************************/
+// Saves the model, once, as a backup in the backup store (see BackupStore.h). The store reads it back and checks it.
+// An ordinary .MOD file of the same name (the user has agreed to overwrite it) is removed, so there's only one of that name.
+
 void WriteBackup()
 {
-
     char ModExt[] = ".MOD";
-    uint8_t Iterations = 4;
     char ProgressStart[] = "vis Progress,1";
     char ProgressEnd[] = "vis Progress,0";
     char Progress[] = "Progress";
@@ -2891,15 +2769,18 @@ void WriteBackup()
     if ((strlen(SingleModelFile) <= 12) && (InStrng(ModExt, SingleModelFile) > 0))
     {
         SendCommand(ProgressStart);
-        for (int i = 0; i < Iterations; i++)
-        {
-            CloseModelsFile();
-            SingleModelFlag = true;
-            SaveOneModel(1);
-            SendValue(Progress, i * (100 / Iterations)); // write several times is needed!! :-)
-        }
         CloseModelsFile();
+        SingleModelFlag = true;
+        BackupStoreSaving = true;
+        SaveOneModel(1);
+        BackupStoreSaving = false;
         SingleModelFlag = false;
+        if (!FileError && BackupFileOnCard(SingleModelFile))
+        {
+            AddPath(SingleModelFile);
+            TINYCARD.remove(SearchFile);
+        }
+        NoteFileAdded(SingleModelFile);
     }
     else
     {
@@ -2914,12 +2795,48 @@ void WriteBackup()
 }
 
 /******************************************************************************************************************************/
-void EndRenameModel()
+// Writes the model, once, to an ordinary .MOD file that a PC can copy off the card. Any backup of that name in the store is
+// removed, so there's only one of that name.
+
+void WriteModelFile()
 {
-    char NewName[31] = "NewName";
-    GetText(NewName, ModelName, sizeof(ModelName)); // ClaudeFix-2-7-2026
-    SaveOneModel(ModelNumber);
-    GotoModelsView();
+    char ModExt[] = ".MOD";
+    char ProgressStart[] = "vis Progress,1";
+    char ProgressEnd[] = "vis Progress,0";
+    char Progress[] = "Progress";
+    SendValue(Progress, 1);
+    FixFileName();
+    if ((strlen(SingleModelFile) <= 12) && (InStrng(ModExt, SingleModelFile) > 0))
+    {
+        SendCommand(ProgressStart);
+        CloseModelsFile();
+        RemoveBackup(SingleModelFile);
+        SingleModelFlag = true;
+        OpenModelsFile();
+        SaveOneModel(1);
+        CloseModelsFile();
+        SingleModelFlag = false;
+        NoteFileAdded(SingleModelFile);
+    }
+    else
+    {
+        FileError = true;
+    }
+    if (FileError)
+        ShowFileErrorMsg();
+    SendValue(Progress, 100);
+    DelayWithDog(100);
+    SendCommand(ProgressEnd);
+    LastFileInView = 120;
+}
+
+/******************************************************************************************************************************/
+void EndRenameModel()
+{
+    char NewName[31] = "NewName";
+    GetText(NewName, ModelName, sizeof(ModelName)); // ClaudeFix-2-7-2026
+    SaveOneModel(ModelNumber);
+    GotoModelsView();
 }
 
 /******************************************************************************************************************************/
@@ -3107,1119 +3024,797 @@ void (*NumberedFunctions[LASTFUNCTION])(){
 }; // This list might become longer but a new one is now started above without the 127 limit
 
 /*********************************************************************************************************************************
- *                          BUTTON WAS PRESSED (DEAL WITH INPUT FROM NEXTION DISPLAY)                                            *
+ *                          TEXT COMMANDS FROM NEXTION (the ones that are words, not numbers)                                    *
  *********************************************************************************************************************************/
-// ClaudeFix-16-7-2026 A channel-name event ("CH3NAME=Gear") can share one serial read
-// with another touch event (e.g. leaving the Inputs screen). The dispatcher
-// matched the OTHER event first and its ClearText() discarded the freshly
-// typed name — "sometimes the new name disappears". Handle every name event
-// up front, then blank it from TextIn so normal dispatch continues with
-// whatever else arrived in the same read.
-void HandleChannelNameEvents()
+// Each word command has its own handler. ButtonWasPressed() finds the handler through a perfect hash built at compile time
+// (see TextCommandLookup below), so finding it takes the same time however many commands there are.
+// ButtonWasPressed() clears TextIn after every handler.
+
+void SubTrimChannelChosen()
+{ // select sub trim channel
+    char s0[] = "s0";
+    char n0[] = "n0";
+    char h0[] = "h0";
+    SubTrimToEdit = GetValue(s0) - 1;
+    if (SubTrimToEdit > 15)
+        SubTrimToEdit = 0; // ClaudeFix-2-7-2026 0 or comms-error 65535 indexed SubTrims[254]
+    SendValue(n0, SubTrims[SubTrimToEdit] - 127);
+    SendValue(h0, SubTrims[SubTrimToEdit]);
+}
+/*********************************************************************************************************************************/
+void SubTrimValueEdited()
+{ // edit sub trim value
+    char n0[] = "n0";
+    SubTrims[SubTrimToEdit] = GetValue(n0) + 127; // 127 is mid point in 8 bit value 0 - 254
+}
+/*********************************************************************************************************************************/
+void MainSetupChosen()
+{ //  goto main TX setup screen
+    ClearText();
+    if (CurrentView == CALIBRATEVIEW)
+        ReadOneModel(ModelNumber); // because it was cleared for calibration
+    SaveAllParameters();
+    CurrentView = TXSETUPVIEW;
+    SendCommand(pTXSetupView);
+    LastTimeRead = 0;
+    CurrentView = TXSETUPVIEW;
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void MarkGPSLocation()
 {
-    char pat[12];
-    for (int ch = 1; ch <= 16; ++ch)
+    GPSMarkHere = 255; // Mark this at RX
+    GPS_RX_MaxDistance = 0;
+    AddParameterstoQueue(GPS_MARK_LOCATION); // 3 is the ID of the MARK HERE parameter
+}
+/*********************************************************************************************************************************/
+void DataViewEnd()
+{ //  Exit from Data screen
+    SendCommand(pRXSetupView);
+    CurrentView = RXSETUPVIEW;
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void ClearDataView()
+{ //  Clear Data screen
+    ZeroDataScreen();
+    ClearSuccessRate();
+}
+/*********************************************************************************************************************************/
+void ZeroAltitude()
+{ //  Set zero altitude on data screen by recording current altitude for subraction later
+    GroundModelAltitude = RXModelAltitudeBMP280;
+    GPS_RX_GroundAltitude = GPS_RX_Altitude;
+    GPS_RX_Maxaltitude = 0;
+    RXMAXModelAltitude = 0;
+}
+/*********************************************************************************************************************************/
+void StartHelpView()
+{ // Display Help screen(s)
+    SavedCurrentView = CurrentView;
+    CurrentView = HELP_VIEW;
+    SendHelp();
+}
+/*********************************************************************************************************************************/
+void ReturnFromHelp()
+{ // Return from Help screen returns here to relevent config screen
+    char WhichPage[] = "page                                 "; // excessive spaces for page name
+    char LOG[] = ".LOG";
+    char CopyToAllBanks[] = "callfm";
+    char ModelsView_ModelNumber[] = "ModelNumber";
+    char MixesView_MixNumber[] = "MixNumber";
+    int i = 5;
+    while (uint8_t(TextIn[i]) && i < 30)
     {
-        snprintf(pat, sizeof(pat), "CH%dNAME=", ch);
-        int p = InStrng(pat, TextIn);
-        if (p <= 0)
-            continue;
-        int start = p - 1;                    // InStrng positions are 1-based
-        int k = start + (int)strlen(pat);     // the typed name begins here
-        DoNewChannelName(ch, k);
-        int j = k, cnt = 0;                   // blank exactly what was consumed
-        while (uint8_t(TextIn[j]) > 0 && cnt < 10) { ++j; ++cnt; }
-        for (int b = start; b < j; ++b)
-            TextIn[b] = ' ';
+        WhichPage[i] = TextIn[i];
+        ++i;
+        WhichPage[i] = 0;
     }
-}
-
-FASTRUN void ButtonWasPressed()
-{
-    HandleChannelNameEvents(); // ClaudeFix-16-7-2026 names first — see comment above
-
-    int Command_number = GetIntFromTextIn(0);
-    if (Command_number)
-    { // is there anything ?
-        StartInactvityTimeout();
-        ScreenTimeTimer = millis();                       // reset screen timeout counter
-        uint32_t NumberedCommand = Command_number & 0x7F; // NextionCommand.FirstDWord & 0x7F; // Just clear the hi BIT ( i.e. -128)
-        uint32_t NumberedCommand1 = Command_number >> 8;  // Shift over to the right to get a number up to 24 BITS
-
-#ifdef DB_NEXTION
-        if ((TextIn[0] < 128) && (TextIn[0] > 28))
-        {
-            Look1("Command WORD: ");
-            Look(TextIn);
-        }
-
-        if ((TextIn[0] > 128) && (TextIn[0] < 255))
-        {
-            Look1("7 BIT Command NUMBER: ");
-            Look(NumberedCommand);
-        }
-
-        if (TextIn[0] == 0)
-        {
-            Look1("24 BIT command NUMBER: ");
-            Look(NumberedCommand1);
-        }
-#endif
-        if (!TextIn[0])
-        { //  Now expanded to handle FAR more than 127 functions
-            if (NumberedCommand1 < LASTFUNCTION1)
-            {
-                NumberedFunctions1[NumberedCommand1](); // Call the needed 24 BIT function -- with a function pointer
-            }
-            ClearText();
-            return;
-        }
-
-        if (TextIn[0] >= 128)
-        {
-            if (NumberedCommand < LASTFUNCTION)
-            {
-                NumberedFunctions[NumberedCommand](); // Call the needed 7 BIT function -- with a function pointer
-            }
-            ClearText();
-            return;
-        }
-        // By here, TextIn[0] must be start of a character based command
-
-        // The very old code below here is gradually and carefully being replaced by new code in multiple functions - it works fine but is not as efficient as the new code
-
-        int i = 0;
-        int j = 0;
-        int p = 0;
-        char Setup[] = "Setup";
-        char ClickX[] = "ClickX";
-        char ClickY[] = "ClickY";
-        char Reset[] = "Reset";
-        char Front_View[] = "FrontView";
-        char Sticks_View[] = "SticksView";
-        char Graph_View[] = "GraphView";
-        char SetupView[] = "MainSetup";
-        char DataEnd[] = "DataEnd";
-        char Data_View[] = "DataView";
-        char CalibrateView[] = "CalibrateView";
-        char TrimView[] = "TrimView";
-        char TRIMS50[] = "TRIMS50";
-        char MIXES_VIEW[] = "MIXESVIEW"; // first call
-        char Mixes_View[] = "MixesView";
-        char FM1[] = "FM 1";
-        char FM2[] = "FM 2";
-        char FM3[] = "FM 3";
-        char FM4[] = "FM 4";
-        char ReScan[] = "ReScan";
-        char MixesView_MixNumber[] = "MixNumber";
-        char ModelsView_ModelNumber[] = "ModelNumber";
-        char SvT11[] = "t11";
-        char CMsg1[] = "Move all controls to their full\r\nextent several times,\r\nthen press Next.";
-        char SvB0[] = "b0";
-        char CMsg2[] = "Next ...";
-        char Cmsg3[] = "Centre all channels.\r\nPut edge switches fully back,\r\nor fully forward, then press Finish.";
-        char Cmsg4[] = "Finish";
-        char Cmsg5[] = "Repeat?";
-        char Cmsg6[] = "Calbrate again?";
-        char TypeView[] = "TypeView";
-        char CopyToAllBanks[] = "callfm";
-        char RXBAT[] = "RXBAT";
-        char r2s[] = "r2s";
-        char r3s[] = "r3s";
-        char r4s[] = "r4s";
-        char r5s[] = "r5s";
-        char r6s[] = "r6s";
-        char r12s[] = "r12s";
-        char r0[] = "r0";
-        char r1[] = "r1";
-        char SwitchesView[] = "SwitchesView";
-        char SwitchesView1[] = "SwitchesView1";
-        char OneSwitchView[] = "OneSwitchView";
-        char PageOneSwitchView[] = "page OneSwitchView";
-        char InputsView[] = "InputsView";
-        char Export[] = "Export";
-        char Import[] = "Import";
-        char DelFile[] = "DelFile";
-        char ModExt[] = ".MOD";
-        char FailSAVE[] = "FailSAVE";
-        char FailSafe[] = "FailSafe";
-        char fs[16][5] = {"fs1", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11", "fs12", "fs13", "fs14", "fs15", "fs16"};
-        char CH1NAME[] = "CH1NAME=";
-        char CH2NAME[] = "CH2NAME=";
-        char CH3NAME[] = "CH3NAME=";
-        char CH4NAME[] = "CH4NAME=";
-        char CH5NAME[] = "CH5NAME=";
-        char CH6NAME[] = "CH6NAME=";
-        char CH7NAME[] = "CH7NAME=";
-        char CH8NAME[] = "CH8NAME=";
-        char CH9NAME[] = "CH9NAME=";
-        char CH10NAME[] = "CH10NAME=";
-        char CH11NAME[] = "CH11NAME=";
-        char CH12NAME[] = "CH12NAME=";
-        char CH13NAME[] = "CH13NAME=";
-        char CH14NAME[] = "CH14NAME=";
-        char CH15NAME[] = "CH15NAME=";
-        char CH16NAME[] = "CH16NAME=";
-        char HelpView[] = "HelpView";
-        char SendModel[] = "SendModel";
-        char Exrite[] = "Exrite";
-        char ExpR[] = "Exp";
-        char Smooth[] = "Smooth";
-        char Lines[] = "Lines";
-        char GOTO[] = "GOTO:";
-        char WhichPage[] = "page                                 "; // excessive spaces for page name
-        char AddMinute[] = "IncMinute";
-        char Dec_Minute[] = "DecMinute";
-        char Dec_Hour[] = "DecHour";
-        char Inc_Hour[] = "IncHour";
-        char Inc_Year[] = "IncYear";
-        char Dec_Year[] = "DecYear";
-        char Inc_Date[] = "IncDate";
-        char Dec_Date[] = "DecDate";
-        char Inc_Month[] = "IncMonth";
-        char Dec_Month[] = "DecMonth";
-        char DataView_Clear[] = "Clear";
-        char DataView_AltZero[] = "AltZero";
-        char Mark[] = "Mark";
-        char SetupCol[] = "SetupCol";
-        char Fm_pco[] = "Fm.pco";
-        char FrontView_BackGround[] = "FrontView.BackGround";
-        char FrontView_ForeGround[] = "FrontView.ForeGround";
-        char FrontView_Special[] = "FrontView.Special";
-        char FrontView_Highlight[] = "FrontView.Highlight";
-        char n0[] = "n0";
-        char Expo[] = "Expo";
-        char h0[] = "h0";
-        char StCH[] = "StCH";
-        char s0[] = "s0";
-        char StEDIT[] = "StEDIT";
-        char Prompt[60];
-        char overwr[] = "Overwrite ";
-        char ques[] = "?";
-        char hhead[] = "Create backup file for";
-        char fprompt[] = "Filename?";
-        char ProgressStart[] = "vis Progress,1";
-        char ProgressEnd[] = "vis Progress,0";
-        char Progress[] = "Progress";
-
-        char NotConnected[] = "Model isn't connected!";
-        char IsConnected[] = "Warning: model is connected!";
-        char invisb1[] = "vis b1,0";
-        char invisb0[] = "vis b0,0";
-        char visb1[] = "vis b1,1";
-        char visb0[] = "vis b0,1";
-        char LOG[] = ".LOG";
-        char PromtBeforeSendingModelFile[100];
-
-        // ************************* test many input words from Nextion *****************
-
-        if (InStrng(StCH, TextIn))
-        { // select sub trim channel
-            SubTrimToEdit = GetValue(s0) - 1;
-            if (SubTrimToEdit > 15)
-                SubTrimToEdit = 0; // ClaudeFix-2-7-2026 0 or comms-error 65535 indexed SubTrims[254]
-            SendValue(n0, SubTrims[SubTrimToEdit] - 127);
-            SendValue(h0, SubTrims[SubTrimToEdit]);
-            ClearText();
-            return;
-        }
-
-        if (InStrng(StEDIT, TextIn))
-        {                                                 // edit sub trim value
-            SubTrims[SubTrimToEdit] = GetValue(n0) + 127; // 127 is mid point in 8 bit value 0 - 254
-            ClearText();
-            return;
-        }
-
-        if (InStrng(SetupView, TextIn) > 0)
-        { //  goto main TX setup screen
-            ClearText();
-            if (CurrentView == CALIBRATEVIEW)
-                ReadOneModel(ModelNumber); // because it was cleared for calibration
-            SaveAllParameters();
-            CurrentView = TXSETUPVIEW;
-            SendCommand(pTXSetupView);
-            LastTimeRead = 0;
-            CurrentView = TXSETUPVIEW;
-            ClearText();
-            UpdateModelsNameEveryWhere();
-            return;
-        }
-
-        if (InStrng(Mark, TextIn) > 0)
-        {
-            GPSMarkHere = 255; // Mark this at RX
-            GPS_RX_MaxDistance = 0;
-            AddParameterstoQueue(GPS_MARK_LOCATION); // 3 is the ID of the MARK HERE parameter
-            ClearText();
-            return;
-        }
-
-        if (InStrng(DataEnd, TextIn) > 0)
-        { //  Exit from Data screen
-            SendCommand(pRXSetupView);
-            CurrentView = RXSETUPVIEW;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(DataView_Clear, TextIn) > 0)
-        { //  Clear Data screen
-            ZeroDataScreen();
-            ClearSuccessRate();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(DataView_AltZero, TextIn) > 0)
-        { //  Set zero altitude on data screen by recording current altitude for subraction later
-            GroundModelAltitude = RXModelAltitudeBMP280;
-            GPS_RX_GroundAltitude = GPS_RX_Altitude;
-            GPS_RX_Maxaltitude = 0;
-            RXMAXModelAltitude = 0;
-            ClearText();
-            return;
-        }
-
-        if (InStrng(HelpView, TextIn) > 0)
-        { // Display Help screen(s)
-            SavedCurrentView = CurrentView;
-            CurrentView = HELP_VIEW;
-            SendHelp();
-            ClearText();
-            return;
-        }
-        if (InStrng(Dec_Minute, TextIn) > 0)
-        {
-            DecMinute();
-            ClearText();
-            return;
-        }
-        if (InStrng(AddMinute, TextIn) > 0)
-        {
-            IncMinute();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Dec_Hour, TextIn) > 0)
-        {
-            DecHour();
-            ClearText();
-            return;
-        }
-        if (InStrng(Inc_Hour, TextIn) > 0)
-        {
-            IncHour();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Dec_Year, TextIn) > 0)
-        {
-            DecYear();
-            ClearText();
-            return;
-        }
-        if (InStrng(Inc_Year, TextIn) > 0)
-        {
-            IncYear();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Dec_Date, TextIn) > 0)
-        {
-            DecDate();
-            ClearText();
-            return;
-        }
-        if (InStrng(Inc_Date, TextIn) > 0)
-        {
-            IncDate();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Dec_Month, TextIn) > 0)
-        {
-            DecMonth();
-            ClearText();
-            return;
-        }
-        if (InStrng(Inc_Month, TextIn) > 0)
-        {
-            IncMonth();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(GOTO, TextIn) > 0)
-        { // Return from Help screen returns here to relevent config screen
-            i = 5;
-            while (uint8_t(TextIn[i]) && i < 30)
-            {
-                WhichPage[i] = TextIn[i];
-                ++i;
-                WhichPage[i] = 0;
-            }
-            // Look1("Returned from help: ");
-            // Look(TextFileName);
-            // Look(WhichPage);
-            // Look(SavedCurrentView);
-
-            if (InStrng(LOG, TextFileName))
-            {
-                CurrentView = DATAVIEW;
-                SavedCurrentView = DATAVIEW;
-                strcpy(WhichPage, pDataView);
-                //  Look(WhichPage);
-            }
-            // Get page name to which to return
-
-            SendCommand(WhichPage); // this sends nextion back to last screen
-
-            CurrentView = SavedCurrentView;
-
-            if (CurrentView == GRAPHVIEW)
-            {
-                DisplayCurveAndServoPos();
-                SendValue(CopyToAllBanks, 0);
-            }
-            if (CurrentView == SWITCHES_VIEW)
-                UpdateSwitchesView();
-            if (CurrentView == ONE_SWITCH_VIEW)
-                UpdateOneSwitchView();
-            if (CurrentView == MODELSVIEW)
-                SendValue(ModelsView_ModelNumber, ModelNumber);
-            if (CurrentView == REVERSEVIEW)
-                StartReverseView();
-            if (CurrentView == DATAVIEW)
-                ForceDataRedisplay();
-            if (CurrentView == PONGVIEW)
-                StartPong();
-
-            if (CurrentView == MIXESVIEW)
-            {
-                if (MixNumber == 0)
-                    MixNumber = 1;
-                LastMixNumber = 33;                        // just to be differernt
-                SendValue(MixesView_MixNumber, MixNumber); // New load of mix window
-                ShowMixValues();
-            }
-
-            if (CurrentView == CALIBRATEVIEW)
-            {
-                Force_ReDisplay();
-                ShowServoPos();
-            }
-
-            if ((CurrentView == STICKSVIEW) || (CurrentView == FRONTVIEW))
-            {
-                Force_ReDisplay();
-                ShowServoPos();
-                if (CurrentView == FRONTVIEW)
-                {
-                    ForceVoltDisplay = true;
-                    LastConnectionQuality = 0;
-                    DisplayModelImage();
-                    GotoFrontView();
-                }
-            }
-
-            if (CurrentView == LOGVIEW)
-            {
-                GotoFrontView(); // otherwise it goes round for ever ... might fix later
-            }
-
-            if (CurrentView == CHOOSEIMAGEVIEW)
-            {
-                StartChooseImage();
-                ClearText();
-                return;
-            }
-            if (CurrentView == RXSETUPVIEW)
-            {
-                SendCommand(pRXSetupView);
-                return;
-            }
-            else // this handles those we forgot
-            {
-                GotoFrontView(); // otherwise it goes round for ever ... might fix later
-                ClearText();
-                return;
-            }
-        }
-
-        if (InStrng(Exrite, TextIn) > 0)
-        { //  *******************
-            if (GetValue(ExpR))
-            {
-                InterpolationTypes[Bank][ChanneltoSet - 1] = EXPONENTIALCURVES;
-            }
-            if (GetValue(Smooth))
-            {
-                InterpolationTypes[Bank][ChanneltoSet - 1] = SMOOTHEDCURVES;
-            }
-            if (GetValue(Lines))
-            {
-                InterpolationTypes[Bank][ChanneltoSet - 1] = STRAIGHTLINES;
-            }
-            Exponential[Bank][ChanneltoSet - 1] = GetValue(Expo) + 50; // Note: Getting this value from slider was not reliable (could not return 36!)
-            ClearText();
-            DisplayCurveAndServoPos();
-            return;
-        }
-
-        if (InStrng(SendModel, TextIn) > 0)
-        {
-            i = strlen(SendModel);
-            j = 0;
-            while (uint8_t(TextIn[i]) > 0)
-            {
-                SingleModelFile[j] = TextIn[i];
-                ++j;
-                ++i;
-                SingleModelFile[j] = 0;
-            }
-
-            strcpy(PromtBeforeSendingModelFile, "Is '");
-            strcat(PromtBeforeSendingModelFile, SingleModelFile);
-            strcat(PromtBeforeSendingModelFile, "' up to date?\r\nPress 'OK' to send it now, \r\n(otherwise press 'Cancel').");
-
-            if (!GetConfirmation(pModelsView, PromtBeforeSendingModelFile))
-            {
-                ClearText();
-                return;
-            }
-            else // OK was pressed
-            {
-                SendModelFile();
-                ClearText();
-                return;
-            }
-        }
-        if (InStrng(FailSAVE, TextIn) > 0)
-        { //  the FAILSAFE setup is sent to receiver ************** FAILSAFE SETUP **************
-
-            if (!BoundFlag || !ModelMatched)
-            {
-                MsgBox(pFailSafe, NotConnected);
-                ClearText();
-                SendCommand(ProgressEnd);
-                return;
-            }
-
-            SendCommand(ProgressStart);
-            for (int i = 0; i < 16; ++i)
-            {
-                FailSafeChannel[i] = GetValue(fs[i]);
-                SendValue(Progress, i * 100 / 16);
-            }
-            SendValue(Progress, 100);
-            AddParameterstoQueue(FAILSAFE_SETTINGS); // 1 is the ID for the FAILSAFE parameters
-            ClearText();
-            SendCommand(ProgressEnd);
-            return;
-        }
-
-        if (InStrng(FailSafe, TextIn) > 0)
-        {
-            SendCommand(pFailSafe);
-            CurrentView = FAILSAFE_VIEW;
-            UpdateButtonLabels();
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(OneSwitchView, TextIn) > 0)
-        {
-            SwitchEditNumber = GetChannel(); // which switch?
-            CurrentView = ONE_SWITCH_VIEW;
-            SendCommand(PageOneSwitchView);
-            UpdateOneSwitchView();
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(SwitchesView1, TextIn) > 0)
-        { //  read switch values from screen (could be 1-4)
-            ReadNewSwitchFunction();
-        }
-
-        if (InStrng(InputsView, TextIn) > 0)
-        {
-            if (ModelMatched) //  model is connected warning
-            {
-                if (!GetConfirmation(pRXSetupView, IsConnected))
-                {
-                    ClearText();
-                    return;
-                }
-            }
-            SendCommand(pInputsView);
-            CurrentView = INPUTS_VIEW;
-            UpdateButtonLabels();
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+    if (InStrng(LOG, TextFileName))
+    {
+        CurrentView = DATAVIEW;
+        SavedCurrentView = DATAVIEW;
+        strcpy(WhichPage, pDataView);
+    }
+    // Get page name to which to return
 
-        if (InStrng(CH1NAME, TextIn) > 0)
-        {
-            p = InStrng(CH1NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(1, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH2NAME, TextIn) > 0)
-        {
-            p = InStrng(CH2NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(2, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH3NAME, TextIn) > 0)
-        {
-            p = InStrng(CH3NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(3, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH4NAME, TextIn) > 0)
-        {
-            p = InStrng(CH4NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(4, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH5NAME, TextIn) > 0)
-        {
-            p = InStrng(CH5NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(5, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH6NAME, TextIn) > 0)
-        {
-            p = InStrng(CH6NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(6, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH7NAME, TextIn) > 0)
-        {
-            p = InStrng(CH7NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(7, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH8NAME, TextIn) > 0)
-        {
-            p = InStrng(CH8NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(8, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH9NAME, TextIn) > 0)
-        {
-            p = InStrng(CH9NAME, TextIn);
-            i = p + 7;
-            DoNewChannelName(9, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH10NAME, TextIn) > 0)
-        {
-            p = InStrng(CH10NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(10, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH11NAME, TextIn) > 0)
-        {
-            p = InStrng(CH11NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(11, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH12NAME, TextIn) > 0)
-        {
-            p = InStrng(CH12NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(12, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH13NAME, TextIn) > 0)
-        {
-            p = InStrng(CH13NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(13, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH14NAME, TextIn) > 0)
-        {
-            p = InStrng(CH14NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(14, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH15NAME, TextIn) > 0)
-        {
-            p = InStrng(CH15NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(15, i);
-            ClearText();
-            return;
-        }
-        if (InStrng(CH16NAME, TextIn) > 0)
-        {
-            p = InStrng(CH16NAME, TextIn);
-            i = p + 8;
-            DoNewChannelName(16, i);
-            ClearText();
-            return;
-        }
+    SendCommand(WhichPage); // this sends nextion back to last screen
 
-        if (InStrng(DelFile, TextIn) > 0)
-        { // Delete a MOD file
-            p = InStrng(DelFile, TextIn);
-            DeleteMODfile(p);
-            return;
-        }
+    CurrentView = SavedCurrentView;
 
-        if (InStrng(SwitchesView, TextIn))
-        {
-            SendCommand(pSwitchesView);
-            UpdateSwitchesView(); // display saved values
-            CurrentView = SWITCHES_VIEW;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+    if (CurrentView == GRAPHVIEW)
+    {
+        DisplayCurveAndServoPos();
+        SendValue(CopyToAllBanks, 0);
+    }
+    if (CurrentView == SWITCHES_VIEW)
+        UpdateSwitchesView();
+    if (CurrentView == ONE_SWITCH_VIEW)
+        UpdateOneSwitchView();
+    if (CurrentView == MODELSVIEW)
+        SendValue(ModelsView_ModelNumber, ModelNumber);
+    if (CurrentView == REVERSEVIEW)
+        StartReverseView();
+    if (CurrentView == DATAVIEW)
+        ForceDataRedisplay();
+    if (CurrentView == PONGVIEW)
+        StartPong();
 
-        if (InStrng(CalibrateView, TextIn))
-        {
-            if (LedWasGreen)
-            {
-                MsgBox(pTXSetupView, (char *)"Still connected!");
-                ClearText();
-                return;
-            }
+    if (CurrentView == MIXESVIEW)
+    {
+        if (MixNumber == 0)
+            MixNumber = 1;
+        LastMixNumber = 33;                        // just to be differernt
+        SendValue(MixesView_MixNumber, MixNumber); // New load of mix window
+        ShowMixValues();
+    }
 
-            SendCommand(pCalibrateView);
-            Force_ReDisplay();
-            CurrentView = CALIBRATEVIEW;
-            ClearText();
-            return;
-        }
+    if (CurrentView == CALIBRATEVIEW)
+    {
+        Force_ReDisplay();
+        ShowServoPos();
+    }
 
-        if (InStrng(Export, TextIn))
+    if ((CurrentView == STICKSVIEW) || (CurrentView == FRONTVIEW))
+    {
+        Force_ReDisplay();
+        ShowServoPos();
+        if (CurrentView == FRONTVIEW)
         {
-            GetDefaultFilename();
-            if (GetBackupFilename(pModelsView, SingleModelFile, ModelName, hhead, fprompt))
-            {
-                FixFileName();
-                if (CheckFileExists(SingleModelFile))
-                {
-                    strcpy(Prompt, overwr);
-                    strcat(Prompt, SingleModelFile);
-                    strcat(Prompt, ques);
-                    if (GetConfirmation(pModelsView, Prompt))
-                    {
-                        WriteBackup();
-                    }
-                }
-                else
-                {
-                    WriteBackup();
-                }
-            }
-            strcpy(MOD, ".MOD");
-            BuildDirectory();
-            strcpy(Mfiles, "Mfiles");
-            LoadFileSelector();
-            ClearText();
-            return;
+            ForceVoltDisplay = true;
+            LastConnectionQuality = 0;
+            DisplayModelImage();
+            GotoFrontView();
         }
+    }
 
-        p = InStrng(Import, TextIn);
-        if (p > 0)
-        {
-            j = 0;
-            i = p + 5;
-            while (TextIn[i] > 0)
-            {
-                SingleModelFile[j] = toUpperCase(TextIn[i]);
-                ++j;
-                ++i;
-                SingleModelFile[j] = 0;
-            }
-            strcpy(Prompt, overwr);
-            strcat(Prompt, ModelName);
-            strcat(Prompt, ques);
-            if (GetConfirmation(pModelsView, Prompt))
-            {
-                SendCommand(ProgressStart);
-                DelayWithDog(10);
-                SendValue(Progress, 5);
-                DelayWithDog(10);
-                if (InStrng(ModExt, SingleModelFile) == 0)
-                    strcat(SingleModelFile, ModExt);
-                SingleModelFlag = true;
-                SendValue(Progress, 10);
-                DelayWithDog(10);
-                CloseModelsFile();
-                ReadOneModel(1);
-                SendValue(Progress, 50);
-                DelayWithDog(10);
-                SingleModelFlag = false;
-                CloseModelsFile();
-                SendValue(Progress, 75);
-                DelayWithDog(10);
-                SaveAllParameters();
-                CloseModelsFile();
-                UpdateModelsNameEveryWhere();
-                SendValue(Progress, 100);
-                DelayWithDog(10);
-                SendCommand(ProgressEnd);
-                DisplayModelImage();
-                if (FileError)
-                    ShowFileErrorMsg();
-                DelayWithDog(150); // ClaudeFix-14-7-2026 let the display finish the image redraw before the big list command
-                LoadModelSelector();
-            }
-            ClearText();
-            // Look1("Importing model file: "); //here import.
-            // Look(SingleModelFile);
-            return;
-        }
+    if (CurrentView == LOGVIEW)
+    {
+        GotoFrontView(); // otherwise it goes round for ever ... might fix later
+    }
 
-        if (InStrng(SetupCol, TextIn) > 0)
-        { // This is  return fr Colours setup
-            HighlightColour = GetOtherValue((char *)"High.pco");
-            ForeGroundColour = GetOtherValue((char *)"Example.pco");
-            BackGroundColour = GetOtherValue((char *)"Fm.bco");
-            SpecialColour = GetOtherValue(Fm_pco);
-            SendValue(FrontView_BackGround, BackGroundColour);
-            SendValue(FrontView_ForeGround, ForeGroundColour);
-            SendValue(FrontView_Special, SpecialColour);
-            SendValue(FrontView_Highlight, HighlightColour);
-            SaveTransmitterParameters();
-            CurrentView = TXSETUPVIEW;
-            SendCommand(pTXSetupView);
-            LastTimeRead = 0;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+    if (CurrentView == CHOOSEIMAGEVIEW)
+    {
+        StartChooseImage();
+        return;
+    }
+    if (CurrentView == RXSETUPVIEW)
+    {
+        SendCommand(pRXSetupView);
+        return;
+    }
+    GotoFrontView(); // this handles those we forgot. Otherwise it goes round for ever ... might fix later
+}
+/*********************************************************************************************************************************/
+void CurveTypeEdited()
+{
+    char ExpR[] = "Exp";
+    char Smooth[] = "Smooth";
+    char Lines[] = "Lines";
+    char Expo[] = "Expo";
+    if (GetValue(ExpR))
+    {
+        InterpolationTypes[Bank][ChanneltoSet - 1] = EXPONENTIALCURVES;
+    }
+    if (GetValue(Smooth))
+    {
+        InterpolationTypes[Bank][ChanneltoSet - 1] = SMOOTHEDCURVES;
+    }
+    if (GetValue(Lines))
+    {
+        InterpolationTypes[Bank][ChanneltoSet - 1] = STRAIGHTLINES;
+    }
+    Exponential[Bank][ChanneltoSet - 1] = GetValue(Expo) + 50; // Note: Getting this value from slider was not reliable (could not return 36!)
+    ClearText();
+    DisplayCurveAndServoPos();
+}
+/*********************************************************************************************************************************/
+void SendModelPressed()
+{
+    char SendModel[] = "SendModel";
+    char PromtBeforeSendingModelFile[100];
+    int i = strlen(SendModel);
+    int j = 0;
+    while (uint8_t(TextIn[i]) > 0)
+    {
+        SingleModelFile[j] = TextIn[i];
+        ++j;
+        ++i;
+        SingleModelFile[j] = 0;
+    }
 
-        if (InStrng(TypeView, TextIn) > 0)
-        {
-            SendCommand(pTypeView);
-            SendValue(r2s, 0); // Zero all RX batt cell count
-            SendValue(r3s, 0);
-            SendValue(r4s, 0);
-            SendValue(r5s, 0);
-            SendValue(r6s, 0);
-            SendValue(r12s, 0);
-            SendValue(r0, 0);
-            SendValue(r1, 0);
-            if (RXCellCount == 2)
-                SendValue(r2s, 1); // Then update RX batt cell count
-            if (RXCellCount == 3)
-                SendValue(r3s, 1);
-            if (RXCellCount == 4)
-                SendValue(r4s, 1);
-            if (RXCellCount == 5)
-                SendValue(r5s, 1);
-            if (RXCellCount == 6)
-                SendValue(r6s, 1);
-            if (RXCellCount == 12)
-                SendValue(r12s, 1);
-            if (TXLiPo)
-                SendValue(r1, 1);
-            else
-                SendValue(r0, 1);
+    strcpy(PromtBeforeSendingModelFile, "Is '");
+    strcat(PromtBeforeSendingModelFile, SingleModelFile);
+    strcat(PromtBeforeSendingModelFile, "' up to date?\r\nPress 'OK' to send it now, \r\n(otherwise press 'Cancel').");
 
-            ClearText();
-            UpdateModelsNameEveryWhere();
-            return;
-        }
+    if (GetConfirmation(pModelsView, PromtBeforeSendingModelFile)) // OK was pressed
+        SendModelFile();
+}
+/*********************************************************************************************************************************/
+void SaveFailSafe()
+{ //  the FAILSAFE setup is sent to receiver ************** FAILSAFE SETUP **************
+    char fs[16][5] = {"fs1", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11", "fs12", "fs13", "fs14", "fs15", "fs16"};
+    char NotConnected[] = "Model isn't connected!";
+    char ProgressStart[] = "vis Progress,1";
+    char ProgressEnd[] = "vis Progress,0";
+    char Progress[] = "Progress";
 
-        if (InStrng(RXBAT, TextIn) > 0)
-        { // UPdate RX batt cell count
-            if (GetValue(r2s) == 1)
-                RXCellCount = 2;
-            if (GetValue(r3s) == 1)
-                RXCellCount = 3;
-            if (GetValue(r4s) == 1)
-                RXCellCount = 4;
-            if (GetValue(r5s) == 1)
-                RXCellCount = 5;
-            if (GetValue(r6s) == 1)
-                RXCellCount = 6;
-            if (GetValue(r12s) == 1)
-                RXCellCount = 12;
-            if (GetValue(r0) == 1)
-                TXLiPo = false; // TX LIFE
-            if (GetValue(r1) == 1)
-                TXLiPo = true; // TX LIPO
-            SaveAllParameters();
-            ClearText();
-            return;
-        }
+    if (!BoundFlag || !ModelMatched)
+    {
+        MsgBox(pFailSafe, NotConnected);
+        ClearText();
+        SendCommand(ProgressEnd);
+        return;
+    }
 
-        if (InStrng(TrimView, TextIn) > 0)
-        { // TrimView just appeared, so update it.
-            StartTrimView();
+    SendCommand(ProgressStart);
+    for (int i = 0; i < 16; ++i)
+    {
+        FailSafeChannel[i] = GetValue(fs[i]);
+        SendValue(Progress, i * 100 / 16);
+    }
+    SendValue(Progress, 100);
+    AddParameterstoQueue(FAILSAFE_SETTINGS); // 1 is the ID for the FAILSAFE parameters
+    ClearText();
+    SendCommand(ProgressEnd);
+}
+/*********************************************************************************************************************************/
+void StartFailSafeView()
+{
+    SendCommand(pFailSafe);
+    CurrentView = FAILSAFE_VIEW;
+    UpdateButtonLabels();
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void StartOneSwitchView()
+{
+    char PageOneSwitchView[] = "page OneSwitchView";
+    SwitchEditNumber = GetChannel(); // which switch?
+    CurrentView = ONE_SWITCH_VIEW;
+    SendCommand(PageOneSwitchView);
+    UpdateOneSwitchView();
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void StartSwitchesView()
+{
+    SendCommand(pSwitchesView);
+    UpdateSwitchesView(); // display saved values
+    CurrentView = SWITCHES_VIEW;
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void SwitchesViewEdited()
+{ //  read switch values from screen (could be 1-4)
+    ReadNewSwitchFunction();
+    StartSwitchesView(); // and show them again
+}
+/*********************************************************************************************************************************/
+void StartInputsView()
+{
+    char IsConnected[] = "Warning: model is connected!";
+    if (ModelMatched) //  model is connected warning
+    {
+        if (!GetConfirmation(pRXSetupView, IsConnected))
             return;
-        }
-
-        if (InStrng(TRIMS50, TextIn) > 0)
+    }
+    SendCommand(pInputsView);
+    CurrentView = INPUTS_VIEW;
+    UpdateButtonLabels();
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void DeleteModFilePressed()
+{ // Delete a MOD file
+    char DelFile[] = "DelFile";
+    DeleteMODfile(InStrng(DelFile, TextIn));
+}
+/*********************************************************************************************************************************/
+void StartCalibrateView()
+{
+    if (LedWasGreen)
+    {
+        MsgBox(pTXSetupView, (char *)"Still connected!");
+        return;
+    }
+    SendCommand(pCalibrateView);
+    Force_ReDisplay();
+    CurrentView = CALIBRATEVIEW;
+}
+/*********************************************************************************************************************************/
+void ExportModel()
+{
+    char Prompt[60];
+    char overwr[] = "Overwrite ";
+    char ques[] = "?";
+    char hhead[] = "Create backup file for";
+    char fprompt[] = "Filename?";
+    GetDefaultFilename();
+    if (GetBackupFilename(pModelsView, SingleModelFile, ModelName, hhead, fprompt))
+    {
+        FixFileName();
+        if (CheckFileExists(SingleModelFile))
         {
-            for (i = 0; i < 16; ++i) // ClaudeFix-2-7-2026 was < 15: channel 16's trim never reset
-            {
-                Trims[Bank][i] = 80; // Mid value is 80
-            }
-            if (CopyTrimsToAll)
+            strcpy(Prompt, overwr);
+            strcat(Prompt, SingleModelFile);
+            strcat(Prompt, ques);
+            if (GetConfirmation(pModelsView, Prompt))
             {
-                for (i = 0; i < 15; ++i)
-                {
-                    for (int fm = 1; fm < 5; ++fm)
-                    {
-                        Trims[fm][i] = 80;
-                    }
-                }
+                WriteBackup();
             }
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Setup, TextIn) > 0)
-        { // Which channel to setup ... Goes to GraphView
-            ChanneltoSet = GetChannel();
-            CurrentView = GRAPHVIEW;
-            SendCommand(pGraphView); // Set to GraphView
-            DisplayCurve();
-            updateInterpolationTypes();
-            UpdateModelsNameEveryWhere();
-            SendValue(CopyToAllBanks, 0);
-            ClearText();
-            return;
         }
-
-        if (InStrng(Front_View, TextIn))
-        {
-            CurrentView = FRONTVIEW;
-            ClearText();
-            PreviousBank = 250; // sure to be different
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(Sticks_View, TextIn))
+        else
         {
-            SendCommand(pSticksView);
-            Force_ReDisplay();
-            CurrentView = STICKSVIEW;
-            SendCommand(pSticksView); // Set to SticksView
-            UpdateModelsNameEveryWhere();
-            UpdateButtonLabels();
-            ClearText();
-            return;
+            WriteBackup();
         }
+    }
+    strcpy(MOD, ".MOD");
+    BuildDirectory();
+    strcpy(Mfiles, "Mfiles");
+    LoadFileSelector();
+}
+/*********************************************************************************************************************************/
+// "ModFile": as Export, but to an ordinary .MOD file for a PC (see WriteModelFile()).
 
-        if (InStrng(ReScan, TextIn))
+void ExportModelFile()
+{
+    char Prompt[60];
+    char overwr[] = "Overwrite ";
+    char ques[] = "?";
+    char hhead[] = "Create .MOD file for";
+    char fprompt[] = "Filename?";
+    GetDefaultFilename();
+    if (GetBackupFilename(pModelsView, SingleModelFile, ModelName, hhead, fprompt))
+    {
+        FixFileName();
+        if (CheckFileExists(SingleModelFile))
         {
-            DrawFhssBox();
-            DoScanInit();
-            ClearText();
-            return;
-        }
-
-        if (InStrng(MIXES_VIEW, TextIn))
-        { // First call to load screen
-            SendCommand(pMixesView);
-            CurrentView = MIXESVIEW;
-            UpdateModelsNameEveryWhere();
-            if (MixNumber == 0)
-                MixNumber = 1;
-            LastMixNumber = MixNumber;
-            SendValue(MixesView_MixNumber, MixNumber); // New load of mix window
-            ShowMixValues();
-            DelayWithDog(100); // allow time for screen to load  before reading data
-            ReceiveLotsofData();
-            FixCHNames();
-            ClearText();
-            return;
-        }
-        if (InStrng(Mixes_View, TextIn))
-        { // Mix number OR a parameter has changed
-            CurrentView = MIXESVIEW;
-            uint8_t ThisMixNumber = MixNumber; // save it
-            MixNumber = GetValue(MixesView_MixNumber);
-            if (LastMixNumber != MixNumber) // Did number change?
-            {
-                SendCommand(invisb1);
-                SendCommand(invisb0);
-                LastMixNumber = MixNumber; // save new mix number
-                MixNumber = ThisMixNumber; // Force back to old number to grab last lot before doing new one
-                ReadMixValues();           // Read them from screen
-                SaveOneModel(ModelNumber); // Save them to SD card
-                MixNumber = LastMixNumber; // back to new one
-                ShowMixValues();           // show new lot
-                SendCommand(visb1);
-                SendCommand(visb0);
-            }
-            else
+            strcpy(Prompt, overwr);
+            strcat(Prompt, SingleModelFile);
+            strcat(Prompt, ques);
+            if (GetConfirmation(pModelsView, Prompt))
             {
-                ReadMixValues(); //
+                WriteModelFile();
             }
-            FixCHNames();
-            ClearText();
-            return;
         }
-
-        if (InStrng(Graph_View, TextIn))
+        else
         {
-            CurrentView = GRAPHVIEW;
-            ClearText();
-            return;
+            WriteModelFile();
         }
-
-        if (InStrng(Data_View, TextIn))
+    }
+    strcpy(MOD, ".MOD");
+    BuildDirectory();
+    strcpy(Mfiles, "Mfiles");
+    LoadFileSelector();
+}
+/*********************************************************************************************************************************/
+void ImportModel()
+{
+    char Import[] = "Import";
+    char ModExt[] = ".MOD";
+    char Prompt[60];
+    char overwr[] = "Overwrite ";
+    char ques[] = "?";
+    char ProgressStart[] = "vis Progress,1";
+    char ProgressEnd[] = "vis Progress,0";
+    char Progress[] = "Progress";
+    int j = 0;
+    int i = InStrng(Import, TextIn) + 5;
+    while (TextIn[i] > 0)
+    {
+        SingleModelFile[j] = toUpperCase(TextIn[i]);
+        ++j;
+        ++i;
+        SingleModelFile[j] = 0;
+    }
+    strcpy(Prompt, overwr);
+    strcat(Prompt, ModelName);
+    strcat(Prompt, ques);
+    if (GetConfirmation(pModelsView, Prompt))
+    {
+        SendCommand(ProgressStart);
+        DelayWithDog(10);
+        SendValue(Progress, 5);
+        DelayWithDog(10);
+        if (InStrng(ModExt, SingleModelFile) == 0)
+            strcat(SingleModelFile, ModExt);
+        SingleModelFlag = true;
+        SendValue(Progress, 10);
+        DelayWithDog(10);
+        CloseModelsFile();
+        ReadOneModel(1);
+        SendValue(Progress, 50);
+        DelayWithDog(10);
+        SingleModelFlag = false;
+        CloseModelsFile();
+        SendValue(Progress, 75);
+        DelayWithDog(10);
+        SaveAllParameters();
+        CloseModelsFile();
+        UpdateModelsNameEveryWhere();
+        SendValue(Progress, 100);
+        DelayWithDog(10);
+        SendCommand(ProgressEnd);
+        DisplayModelImage();
+        if (FileError)
+            ShowFileErrorMsg();
+        DelayWithDog(150); // ClaudeFix-14-7-2026 let the display finish the image redraw before the big list command
+        LoadModelSelector();
+    }
+}
+/*********************************************************************************************************************************/
+void ColoursSetupEnd()
+{ // This is  return fr Colours setup
+    char Fm_pco[] = "Fm.pco";
+    char FrontView_BackGround[] = "FrontView.BackGround";
+    char FrontView_ForeGround[] = "FrontView.ForeGround";
+    char FrontView_Special[] = "FrontView.Special";
+    char FrontView_Highlight[] = "FrontView.Highlight";
+    HighlightColour = GetOtherValue((char *)"High.pco");
+    ForeGroundColour = GetOtherValue((char *)"Example.pco");
+    BackGroundColour = GetOtherValue((char *)"Fm.bco");
+    SpecialColour = GetOtherValue(Fm_pco);
+    SendValue(FrontView_BackGround, BackGroundColour);
+    SendValue(FrontView_ForeGround, ForeGroundColour);
+    SendValue(FrontView_Special, SpecialColour);
+    SendValue(FrontView_Highlight, HighlightColour);
+    SaveTransmitterParameters();
+    CurrentView = TXSETUPVIEW;
+    SendCommand(pTXSetupView);
+    LastTimeRead = 0;
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void StartTypeView()
+{
+    char r2s[] = "r2s";
+    char r3s[] = "r3s";
+    char r4s[] = "r4s";
+    char r5s[] = "r5s";
+    char r6s[] = "r6s";
+    char r12s[] = "r12s";
+    char r0[] = "r0";
+    char r1[] = "r1";
+    SendCommand(pTypeView);
+    SendValue(r2s, 0); // Zero all RX batt cell count
+    SendValue(r3s, 0);
+    SendValue(r4s, 0);
+    SendValue(r5s, 0);
+    SendValue(r6s, 0);
+    SendValue(r12s, 0);
+    SendValue(r0, 0);
+    SendValue(r1, 0);
+    if (RXCellCount == 2)
+        SendValue(r2s, 1); // Then update RX batt cell count
+    if (RXCellCount == 3)
+        SendValue(r3s, 1);
+    if (RXCellCount == 4)
+        SendValue(r4s, 1);
+    if (RXCellCount == 5)
+        SendValue(r5s, 1);
+    if (RXCellCount == 6)
+        SendValue(r6s, 1);
+    if (RXCellCount == 12)
+        SendValue(r12s, 1);
+    if (TXLiPo)
+        SendValue(r1, 1);
+    else
+        SendValue(r0, 1);
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void RXBatteryTypeChosen()
+{ // UPdate RX batt cell count
+    char r2s[] = "r2s";
+    char r3s[] = "r3s";
+    char r4s[] = "r4s";
+    char r5s[] = "r5s";
+    char r6s[] = "r6s";
+    char r12s[] = "r12s";
+    char r0[] = "r0";
+    char r1[] = "r1";
+    if (GetValue(r2s) == 1)
+        RXCellCount = 2;
+    if (GetValue(r3s) == 1)
+        RXCellCount = 3;
+    if (GetValue(r4s) == 1)
+        RXCellCount = 4;
+    if (GetValue(r5s) == 1)
+        RXCellCount = 5;
+    if (GetValue(r6s) == 1)
+        RXCellCount = 6;
+    if (GetValue(r12s) == 1)
+        RXCellCount = 12;
+    if (GetValue(r0) == 1)
+        TXLiPo = false; // TX LIFE
+    if (GetValue(r1) == 1)
+        TXLiPo = true; // TX LIPO
+    SaveAllParameters();
+}
+/*********************************************************************************************************************************/
+void CentreAllTrims()
+{
+    for (int i = 0; i < 16; ++i) // ClaudeFix-2-7-2026 was < 15: channel 16's trim never reset
+    {
+        Trims[Bank][i] = 80; // Mid value is 80
+    }
+    if (CopyTrimsToAll)
+    {
+        for (int i = 0; i < 15; ++i)
         {
-            CurrentView = DATAVIEW;
-            LastShowTime = 0;
-            ForceDataRedisplay();
-            SendCommand(pDataView);
-            ClearText();
-            return;
+            for (int fm = 1; fm < 5; ++fm)
+            {
+                Trims[fm][i] = 80;
+            }
         }
+    }
+}
+/*********************************************************************************************************************************/
+void SetupChannel()
+{ // Which channel to setup ... Goes to GraphView
+    char CopyToAllBanks[] = "callfm";
+    ChanneltoSet = GetChannel();
+    CurrentView = GRAPHVIEW;
+    SendCommand(pGraphView); // Set to GraphView
+    DisplayCurve();
+    updateInterpolationTypes();
+    UpdateModelsNameEveryWhere();
+    SendValue(CopyToAllBanks, 0);
+}
+/*********************************************************************************************************************************/
+void FrontViewShown()
+{
+    CurrentView = FRONTVIEW;
+    PreviousBank = 250; // sure to be different
+    UpdateModelsNameEveryWhere();
+}
+/*********************************************************************************************************************************/
+void StartSticksView()
+{
+    SendCommand(pSticksView);
+    Force_ReDisplay();
+    CurrentView = STICKSVIEW;
+    SendCommand(pSticksView); // Set to SticksView
+    UpdateModelsNameEveryWhere();
+    UpdateButtonLabels();
+}
+/*********************************************************************************************************************************/
+void RescanWaveband()
+{
+    DrawFhssBox();
+    DoScanInit();
+}
+/*********************************************************************************************************************************/
+void StartMixesView()
+{ // First call to load screen
+    char MixesView_MixNumber[] = "MixNumber";
+    SendCommand(pMixesView);
+    CurrentView = MIXESVIEW;
+    UpdateModelsNameEveryWhere();
+    if (MixNumber == 0)
+        MixNumber = 1;
+    LastMixNumber = MixNumber;
+    SendValue(MixesView_MixNumber, MixNumber); // New load of mix window
+    ShowMixValues();
+    DelayWithDog(100); // allow time for screen to load  before reading data
+    ReceiveLotsofData();
+    FixCHNames();
+}
+/*********************************************************************************************************************************/
+void MixesViewEdited()
+{ // Mix number OR a parameter has changed
+    char MixesView_MixNumber[] = "MixNumber";
+    char invisb1[] = "vis b1,0";
+    char invisb0[] = "vis b0,0";
+    char visb1[] = "vis b1,1";
+    char visb0[] = "vis b0,1";
+    CurrentView = MIXESVIEW;
+    uint8_t ThisMixNumber = MixNumber; // save it
+    MixNumber = GetValue(MixesView_MixNumber);
+    if (LastMixNumber != MixNumber) // Did number change?
+    {
+        SendCommand(invisb1);
+        SendCommand(invisb0);
+        LastMixNumber = MixNumber; // save new mix number
+        MixNumber = ThisMixNumber; // Force back to old number to grab last lot before doing new one
+        ReadMixValues();           // Read them from screen
+        SaveOneModel(ModelNumber); // Save them to SD card
+        MixNumber = LastMixNumber; // back to new one
+        ShowMixValues();           // show new lot
+        SendCommand(visb1);
+        SendCommand(visb0);
+    }
+    else
+    {
+        ReadMixValues(); //
+    }
+    FixCHNames();
+}
+/*********************************************************************************************************************************/
+void GraphViewShown()
+{
+    CurrentView = GRAPHVIEW;
+}
+/*********************************************************************************************************************************/
+void StartDataView()
+{
+    CurrentView = DATAVIEW;
+    LastShowTime = 0;
+    ForceDataRedisplay();
+    SendCommand(pDataView);
+}
+/*********************************************************************************************************************************/
+void SelectBankFromScreen(uint8_t NewBank)
+{
+    Bank = NewBank;
+    PreviousBank = NewBank;
+    UpdateModelsNameEveryWhere();
+}
+void SelectBank1() { SelectBankFromScreen(1); }
+void SelectBank2() { SelectBankFromScreen(2); }
+void SelectBank3() { SelectBankFromScreen(3); }
+void SelectBank4() { SelectBankFromScreen(4); }
+/*********************************************************************************************************************************/
+void ResetExpo() // Now zeros EXPO only
+{
+    Exponential[Bank][ChanneltoSet - 1] = DEFAULT_EXPO;
+    InterpolationTypes[Bank][ChanneltoSet - 1] = EXPONENTIALCURVES; // expo = default
+    DisplayCurveAndServoPos();
+}
+/*********************************************************************************************************************************/
+void CurveClickedY() // Clicked to move point?
+{
+    char ClickY[] = "ClickY";
+    int p = InStrng(ClickY, TextIn);
+    if (p > 0)
+    {
+        YtouchPlace = GetNextNumber(p + 7, TextIn);
+        MovePoint();
+        DisplayCurveAndServoPos();
+    }
+}
+/*********************************************************************************************************************************/
+void CurveClickedX() // Clicked to move point?
+{
+    char ClickX[] = "ClickX";
+    XtouchPlace = GetNextNumber(InStrng(ClickX, TextIn) + 7, TextIn);
+    CurveClickedY(); // Y comes in the same message
+}
+/*********************************************************************************************************************************/
+void CalibrateButtonPressed()
+{
+    char SvT11[] = "t11";
+    char CMsg1[] = "Move all controls to their full\r\nextent several times,\r\nthen press Next.";
+    char SvB0[] = "b0";
+    char CMsg2[] = "Next ...";
+    char Cmsg3[] = "Centre all channels.\r\nPut edge switches fully back,\r\nor fully forward, then press Finish.";
+    char Cmsg4[] = "Finish";
+    char Cmsg5[] = "Repeat?";
+    char Cmsg6[] = "Calbrate again?";
 
-        if (InStrng(FM1, TextIn))
-        {
-            Bank = 1;
-            PreviousBank = 1;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+    if (CurrentMode == NORMAL)
+    {
+        Look("Starting calibration");
+        BlueLedOn();
+        SetDefaultValues();
+        ResetSwitchNumbers();
+        SaveTransmitterParameters();
+        ReduceLimits(); // Get setup for sticks calibration
+        CurrentMode = CALIBRATELIMITS;
+        CurrentView = CALIBRATEVIEW;
+        SendText1(SvT11, CMsg1);
+        SendText(SvB0, CMsg2);
+        BlueLedOn();
+        return;
+    }
+    if (CurrentMode == CALIBRATELIMITS)
+    {
+        CurrentMode = CENTRESTICKS;
+        CurrentView = CALIBRATEVIEW;
+        StartInputNoiseMeasurement(); // Sticks are at rest from now on, so measure their noise
+        SendText1(SvT11, Cmsg3);
+        SendText(SvB0, Cmsg4);
+        return;
+    }
+    if (CurrentMode == CENTRESTICKS)
+    {
+        CurrentMode = NORMAL;
+        RedLedOn();
+        SetDeadbandsFromNoise();     // Each input's deadband comes from its measured noise
+        SaveTransmitterParameters(); // Save calibrations
+        LoadAllParameters();         // Restore all current model settings
+        SendText(SvB0, Cmsg5);
+        SendText(SvT11, Cmsg6);
+        LastTimeRead = 0;
+    }
+}
 
-        if (InStrng(FM2, TextIn))
-        {
-            Bank = 2;
-            PreviousBank = 2;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+/*********************************************************************************************************************************
+ *                          BUTTON WAS PRESSED (DEAL WITH INPUT FROM NEXTION DISPLAY)                                            *
+ *********************************************************************************************************************************/
+// ClaudeFix-16-7-2026 A channel-name event ("CH3NAME=Gear") can share one serial read
+// with another touch event (e.g. leaving the Inputs screen). The dispatcher
+// matched the OTHER event first and its ClearText() discarded the freshly
+// typed name — "sometimes the new name disappears". Handle every name event
+// up front, then blank it from TextIn so normal dispatch continues with
+// whatever else arrived in the same read.
+void HandleChannelNameEvents()
+{
+    char pat[12];
+    for (int ch = 1; ch <= 16; ++ch)
+    {
+        snprintf(pat, sizeof(pat), "CH%dNAME=", ch);
+        int p = InStrng(pat, TextIn);
+        if (p <= 0)
+            continue;
+        int start = p - 1;                    // InStrng positions are 1-based
+        int k = start + (int)strlen(pat);     // the typed name begins here
+        DoNewChannelName(ch, k);
+        int j = k, cnt = 0;                   // blank exactly what was consumed
+        while (uint8_t(TextIn[j]) > 0 && cnt < 10) { ++j; ++cnt; }
+        for (int b = start; b < j; ++b)
+            TextIn[b] = ' ';
+    }
+}
 
-        if (InStrng(FM3, TextIn))
-        {
-            Bank = 3;
-            PreviousBank = 3;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+FASTRUN void ButtonWasPressed()
+{
+    InvalidatePipeline();      // Almost any screen command might edit curves, mixes, rates etc.
+    ForgetNextionShadows();    // A touch may have changed what widgets show
+    HandleChannelNameEvents(); // ClaudeFix-16-7-2026 names first — see comment above
 
-        if (InStrng(FM4, TextIn))
-        {
-            Bank = 4;
-            PreviousBank = 4;
-            UpdateModelsNameEveryWhere();
-            ClearText();
-            return;
-        }
+    int Command_number = GetIntFromTextIn(0);
+    if (Command_number)
+    { // is there anything ?
+        StartInactvityTimeout();
+        ScreenTimeTimer = millis();                       // reset screen timeout counter
+        uint32_t NumberedCommand = Command_number & 0x7F; // NextionCommand.FirstDWord & 0x7F; // Just clear the hi BIT ( i.e. -128)
+        uint32_t NumberedCommand1 = Command_number >> 8;  // Shift over to the right to get a number up to 24 BITS
 
-        if (InStrng(Reset, TextIn)) // Now zeros EXPO only
+#ifdef DB_NEXTION
+        if ((TextIn[0] < 128) && (TextIn[0] > 28))
         {
-            Exponential[Bank][ChanneltoSet - 1] = DEFAULT_EXPO;
-            InterpolationTypes[Bank][ChanneltoSet - 1] = EXPONENTIALCURVES; // expo = default
-            DisplayCurveAndServoPos();
-            return;
+            Look1("Command WORD: ");
+            Look(TextIn);
         }
 
-        p = (InStrng(ClickX, TextIn)); // Clicked to move point?
-        if (p > 0)
+        if ((TextIn[0] > 128) && (TextIn[0] < 255))
         {
-            XtouchPlace = GetNextNumber(p + 7, TextIn);
-            // This drops through to get Y as well before moving the point
+            Look1("7 BIT Command NUMBER: ");
+            Look(NumberedCommand);
         }
-        p = (InStrng(ClickY, TextIn)); // Clicked to move point?
-        if (p > 0)
+
+        if (TextIn[0] == 0)
         {
-            YtouchPlace = GetNextNumber(p + 7, TextIn);
-            MovePoint();
-            DisplayCurveAndServoPos();
-            return;
+            Look1("24 BIT command NUMBER: ");
+            Look(NumberedCommand1);
         }
-        if (CurrentMode == NORMAL)
-        {
-            if (strcmp(TextIn, "Calibrate1") == 0)
+#endif
+        if (!TextIn[0])
+        { //  Now expanded to handle FAR more than 127 functions
+            if (NumberedCommand1 < LASTFUNCTION1)
             {
-                Look("Starting calibration");
-                BlueLedOn();
-                SetDefaultValues();
-                ResetSwitchNumbers();
-                SaveTransmitterParameters();
-                ReduceLimits(); // Get setup for sticks calibration
-                CurrentMode = CALIBRATELIMITS;
-                CurrentView = CALIBRATEVIEW;
-                SendText1(SvT11, CMsg1);
-                SendText(SvB0, CMsg2);
-                ClearText();
-                BlueLedOn();
-                return;
+                NumberedFunctions1[NumberedCommand1](); // Call the needed 24 BIT function -- with a function pointer
             }
+            ClearText();
+            return;
         }
 
-        if (CurrentMode == CALIBRATELIMITS)
-        {
-            if (strcmp(TextIn, "Calibrate1") == 0)
-            {
-                CurrentMode = CENTRESTICKS;
-                CurrentView = CALIBRATEVIEW;
-                SendText1(SvT11, Cmsg3);
-                SendText(SvB0, Cmsg4);
-                ClearText();
-                return;
-            }
-        }
-        if (CurrentMode == CENTRESTICKS)
+        if (TextIn[0] >= 128)
         {
-            if (strcmp(TextIn, "Calibrate1") == 0)
+            if (NumberedCommand < LASTFUNCTION)
             {
-                CurrentMode = NORMAL;
-                RedLedOn();
-                SaveTransmitterParameters(); // Save calibrations
-                LoadAllParameters();         // Restore all current model settings
-                SendText(SvB0, Cmsg5);
-                SendText(SvT11, Cmsg6);
-                LastTimeRead = 0;
-                ClearText();
-                return;
+                NumberedFunctions[NumberedCommand](); // Call the needed 7 BIT function -- with a function pointer
             }
+            ClearText();
+            return;
         }
+        // By here, TextIn[0] must be start of a character based command
+
+        const TextCommand *Command = FindTextCommand();
+        if (Command)
+            Command->Handler();
     }
     ClearText(); // Let's have cleared text for next one!
 } // end ButtonWasPressed() (... at last!!!)
@@ -4421,7 +4016,7 @@ bool CheckModelName()
     char Mfiles[] = "Mfiles";
     char mn[] = "modelname";
 
-    if (NEXTION.available())
+    if (NextionInputWaiting())
         return false; // ClaudeFix-14-7-2026 a button press is waiting -- let it be handled before polling
 
     ModelNumber = GetValue(MMems) + 1;
@@ -4476,6 +4071,9 @@ void Close_TX_Down()
         SaveAllParameters();     // Save the model if it's not 'Not in use'
         DelayWithDog(500);       // Wait for 0.5 seconds to allow the message to be displayed
     }
+    FlushModelStore(true);        // Everything still in PSRAM goes to SD now
+    CloseLogWriter();             // and any log lines still in RAM
+    StopBlackbox();               // and blackbox records
     SendText(t0, ClosingDown);    // Show 'Closing down ...' on screen
     for (int i = 0; i < 100; ++i) // fade in screen brightness
     {
@@ -4657,6 +4255,7 @@ void FASTRUN ManageTransmitter()
     {
         return; // If it's almost time to send data, then do not start some other task which might easily take longer.
     }
+    DrainNextionQueue(); // Send a little more to the display
     if (ThisGap)
     {
         ProcessRecentCommsGap();
@@ -4697,6 +4296,11 @@ void FASTRUN ManageTransmitter()
     if (CurrentView == DUALRATESVIEW)
         CheckDualRatesScreen(RightNow);   // live channel names — no Refresh needed
 
+    ManageModelStore(RightNow); // Write a changed model back to SD, once things have settled
+    ManageLogRing(RightNow);    // Write queued log lines to SD
+    ManageBlackbox();           // Write a full blackbox buffer to SD
+    ManageLineIndex();          // Index a little more of the file being viewed
+
     if (RightNow - TransmitterLastManaged >= 50)
     {                      // 50 = 20 times a second
         CheckMaxCurrent(); // Check if max current has been exceeded
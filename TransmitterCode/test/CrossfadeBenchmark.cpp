@@ -0,0 +1,297 @@
+// *************************************** CrossfadeBenchmark.cpp *****************************************
+
+// Host benchmark of a bank crossfade pass (TransmitterCode/include/Crossfade.h): the old bank evaluated by
+// EvaluateCrossfadeBank(), the new bank's own pass, then BlendBanks(). Every stick moves on every pass so every curve is
+// recomputed, with 8 input and 8 output mixes, for each type of curve. The time per pass is set against the packet budget
+// at the top rate (PACEMAKER, 2 ms).
+// A Teensy 4.1 runs this code something like ten times slower than a desktop PC, so a pass must take under a twentieth
+// of the budget here to leave the rest of the loop its time. DB_PIPELINE in main.cpp reports the real figures on the
+// transmitter.
+//
+// Build:   g++ -std=c++14 -O2 -Wall -I host -o CrossfadeBenchmark CrossfadeBenchmark.cpp
+// Use:     ./CrossfadeBenchmark        (prints us per pass for each curve type, and exits with 1 if one is over)
+
+#include <Arduino.h>
+#include <chrono>
+
+// The firmware's 1Definitions.h needs the whole Teensy build, so the little that the pipeline's headers use is here
+// instead. It must match 1Definitions.h.
+#define Definitions_H
+#define PACEMAKER 2
+#define CHANNELSUSED 16
+#define BANKS_USED 4
+#define MAXMIXES 32
+#define PIPELINEFULLREFRESH 100
+#define MINMICROS 500
+#define MAXMICROS 2500
+#define HALFMICROSRANGE (MAXMICROS - MINMICROS) / 2
+#define M_MIX_OUTPUTS 0
+#define M_Bank 1
+#define M_MasterChannel 2
+#define M_SlaveChannel 3
+#define M_Reversed 4
+#define M_Percent 5
+#define M_MIX_INPUTS 6
+#define M_R2 7
+#define M_ONEDIRECTION 8
+#define M_OFFSET 9
+#define STRAIGHTLINES 0
+#define SMOOTHEDCURVES 1
+#define EXPONENTIALCURVES 2
+
+uint8_t Mixes[MAXMIXES + 1][17];
+uint8_t Bank = 1;
+uint8_t DualRateValue = 100;
+uint32_t ModelNumber = 1;
+bool MotorEnabled = false;
+uint8_t MotorChannel = 2;
+bool PipelineNeedsFullRefresh = true;
+uint16_t InputsBuffer[CHANNELSUSED + 1];
+uint16_t LastRawInputs[CHANNELSUSED + 1];
+uint16_t CurveDeps[CHANNELSUSED];
+uint16_t CurveCache[CHANNELSUSED + 1];
+uint16_t ChannelMax[CHANNELSUSED + 1];
+uint16_t ChannelMidHi[CHANNELSUSED + 1];
+uint16_t ChannelCentre[CHANNELSUSED + 1];
+uint16_t ChannelMidLow[CHANNELSUSED + 1];
+uint16_t ChannelMin[CHANNELSUSED + 1];
+uint16_t SendBuffer[CHANNELSUSED + 1];
+uint16_t PreMixBuffer[CHANNELSUSED + 1];
+uint16_t CrossfadeBuffer[CHANNELSUSED + 1];
+uint8_t BankCrossfadeTime = 0;
+uint8_t CrossfadeFromBank = 0;
+uint32_t CrossfadeStartTime = 0;
+bool BankCrossfading = false;
+uint8_t MaxDegrees[5][CHANNELSUSED + 1];
+uint8_t MidHiDegrees[5][CHANNELSUSED + 1];
+uint8_t CentreDegrees[5][CHANNELSUSED + 1];
+uint8_t MidLowDegrees[5][CHANNELSUSED + 1];
+uint8_t MinDegrees[5][CHANNELSUSED + 1];
+uint8_t SubTrims[CHANNELSUSED + 1];
+int Trims[BANKS_USED + 1][CHANNELSUSED + 1];
+uint8_t Exponential[BANKS_USED + 1][CHANNELSUSED + 1];
+uint8_t InterpolationTypes[BANKS_USED + 1][CHANNELSUSED + 1];
+uint8_t InPutStick[17] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+uint16_t TrimMultiplier = 5;
+uint8_t SticksMode = 2;
+uint16_t CurveDots[5];
+double PointsCount = 5;
+double xPoints[5];
+double yPoints[5];
+
+static uint32_t Now = 0;
+
+uint32_t millis()
+{
+    return Now;
+}
+
+uint16_t IntoHigherRes(uint8_t LowRes) // As in Utilities.h
+{
+    return map(LowRes, 0, 180, MINMICROS, MAXMICROS);
+}
+
+static float MapFloat(float x, float InMin, float InMax, float OutMin, float OutMax) // Teensy's map() is a template
+{
+    return (x - InMin) * (OutMax - OutMin) / (InMax - InMin) + OutMin;
+}
+
+float MapWithExponential(float xx, float Xxmin, float Xxmax, float Yymin, float Yymax, float Expo) // As in Utilities.h
+{
+    Expo = MapFloat(Expo, -100, 100, -0.25, 0.75);
+    xx = pow(xx * xx, Expo);
+    Xxmin = pow(Xxmin * Xxmin, Expo);
+    Xxmax = pow(Xxmax * Xxmax, Expo);
+    return MapFloat(xx, Xxmin, Xxmax, Yymin, Yymax);
+}
+
+int GetTrimAmount(uint8_t InputChannel) // As in Trims.h
+{
+    int tt = InputChannel;
+    if (SticksMode == 2)
+    {
+        if (InputChannel == 1)
+            tt = 2;
+        if (InputChannel == 2)
+            tt = 1;
+    }
+    return (Trims[Bank][tt] - 80) * TrimMultiplier;
+}
+
+void GetCurveDots(uint16_t OutputChannel, uint16_t TheRate) // As in DualRates.h at full rate
+{
+    CurveDots[0] = MinDegrees[Bank][OutputChannel];
+    CurveDots[1] = MidLowDegrees[Bank][OutputChannel];
+    CurveDots[2] = CentreDegrees[Bank][OutputChannel];
+    CurveDots[3] = MidHiDegrees[Bank][OutputChannel];
+    CurveDots[4] = MaxDegrees[Bank][OutputChannel];
+}
+
+void BuildSlowedChannels() // Slowed servos aren't part of a crossfade
+{
+}
+
+namespace Interpolation // InterpolationLib's Catmull-Rom spline: find the segment, then one cubic Hermite
+{
+    double CatmullSpline(double *X, double *Y, int n, double x)
+    {
+        int i = 0;
+        while ((i < n - 2) && (x >= X[i + 1]))
+            ++i;
+        double t = (x - X[i]) / (X[i + 1] - X[i]);
+        double t2 = t * t;
+        double t3 = t2 * t;
+        double m0 = (i > 0) ? (Y[i + 1] - Y[i - 1]) / (X[i + 1] - X[i - 1]) : (Y[i + 1] - Y[i]) / (X[i + 1] - X[i]);
+        double m1 = (i < n - 2) ? (Y[i + 2] - Y[i]) / (X[i + 2] - X[i]) : (Y[i + 1] - Y[i]) / (X[i + 1] - X[i]);
+        double h = X[i + 1] - X[i];
+        return (2 * t3 - 3 * t2 + 1) * Y[i] + (t3 - 2 * t2 + t) * h * m0 + (-2 * t3 + 3 * t2) * Y[i + 1] + (t3 - t2) * h * m1;
+    }
+}
+
+#include "../include/Mixes.h"
+#include "../include/Curves.h"
+#include "../include/Pipeline.h"
+#include "../include/Crossfade.h"
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, float Detail = 0)
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%.2f)\n", What, Detail);
+    ++Failures;
+}
+
+static uint32_t RandomState = 12345;
+
+static uint32_t Random(uint32_t Range) // xorshift32, so every run is the same
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState % Range;
+}
+
+/*********************************************************************************************************************************/
+// A busy model: every channel calibrated and curved differently in each bank, and 8 input and 8 output mixes.
+
+static void SetUpModel(uint8_t CurveType)
+{
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+    {
+        ChannelMin[ch] = 300 + Random(200);
+        ChannelMidLow[ch] = 1100 + Random(200);
+        ChannelCentre[ch] = 1900 + Random(200);
+        ChannelMidHi[ch] = 2700 + Random(200);
+        ChannelMax[ch] = 3500 + Random(200);
+        SubTrims[ch] = 117 + Random(21);
+        for (uint8_t b = 0; b <= BANKS_USED; ++b)
+        {
+            MinDegrees[b][ch] = 10 + Random(20);
+            MidLowDegrees[b][ch] = 45 + Random(10);
+            CentreDegrees[b][ch] = 85 + Random(10);
+            MidHiDegrees[b][ch] = 130 + Random(10);
+            MaxDegrees[b][ch] = 160 + Random(20);
+            Trims[b][ch] = 75 + Random(11);
+            Exponential[b][ch] = 20 + Random(60);
+            InterpolationTypes[b][ch] = CurveType;
+        }
+    }
+    memset(Mixes, 0, sizeof(Mixes));
+    for (uint8_t MixNumber = 1; MixNumber <= 16; ++MixNumber)
+    {
+        Mixes[MixNumber][(MixNumber <= 8) ? M_MIX_INPUTS : M_MIX_OUTPUTS] = 1;
+        Mixes[MixNumber][M_Bank] = Random(3); // every bank, bank 1 or bank 2
+        Mixes[MixNumber][M_MasterChannel] = 1 + Random(CHANNELSUSED);
+        Mixes[MixNumber][M_SlaveChannel] = 1 + Random(CHANNELSUSED);
+        Mixes[MixNumber][M_Percent] = 20 + Random(81);
+        Mixes[MixNumber][M_OFFSET] = 127;
+    }
+    BankCrossfadeTime = 50; // the longest, so the fade never finishes during a run
+    Bank = 1;
+    Now = 0;
+    PipelineNeedsFullRefresh = true;
+}
+
+static void MoveEveryStick(uint32_t PassNumber)
+{
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+        InputsBuffer[ch] = ChannelMin[ch] + ((PassNumber * 7 + ch * 131) % (ChannelMax[ch] - ChannelMin[ch]));
+}
+
+/*********************************************************************************************************************************/
+// The same stages, in the same order, as GetNewChannelValues(), less reading the inputs and slowed servos.
+
+static uint32_t FadePasses = 0;
+
+static void Pass(uint32_t PassNumber)
+{
+    MoveEveryStick(PassNumber);
+    uint16_t Dirty = GetDirtyOutputs();
+    CheckForBankCrossfade();
+    if (BankCrossfading)
+    {
+        EvaluateCrossfadeBank();
+        ++FadePasses;
+    }
+    MixInputs();
+    CalculateChangedOutputs(Dirty);
+    MixOutputs();
+    DoTrimsAndSubtrims();
+    if (BankCrossfading)
+        BlendBanks();
+}
+
+// Mean us per pass. With Fade, the bank flips between 1 and 2 every second so that a crossfade is always running.
+static double TimePasses(uint8_t CurveType, bool Fade)
+{
+    const uint32_t Passes = 200000;
+    SetUpModel(CurveType);
+    FadePasses = 0;
+    for (uint32_t i = 0; i < 1000; ++i) // warm up, and let the pipeline see this bank
+        Pass(i);
+    auto Start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < Passes; ++i)
+    {
+        Now += PACEMAKER;
+        if (Fade && !(i % (1000 / PACEMAKER)))
+            Bank = (Bank == 1) ? 2 : 1;
+        Pass(i);
+    }
+    auto Finish = std::chrono::steady_clock::now();
+    if (Fade)
+        Check(FadePasses >= Passes, "The crossfade stopped during the run", FadePasses);
+    return std::chrono::duration<double, std::micro>(Finish - Start).count() / Passes;
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    static const char *Names[] = {"Straight lines", "Catmull spline", "Exponential"};
+    const double Budget = PACEMAKER * 1000.0;
+    uint32_t Checksum = 0;
+
+    printf("Budget at the top rate: %.0f us per pass\n", Budget);
+    printf("%-16s %12s %14s %12s\n", "", "Normal us", "Crossfade us", "% of budget");
+    for (uint8_t CurveType = STRAIGHTLINES; CurveType <= EXPONENTIALCURVES; ++CurveType)
+    {
+        double Normal = TimePasses(CurveType, false);
+        double Fade = TimePasses(CurveType, true);
+        for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+            Checksum += SendBuffer[ch]; // so that nothing is optimised away
+        printf("%-16s %12.2f %14.2f %11.2f%%\n", Names[CurveType], Normal, Fade, Fade * 100 / Budget);
+        Check(Fade < Budget / 20, "A crossfade pass takes more than a twentieth of the budget", Fade);
+    }
+    printf("(checksum %u)\n", (unsigned)Checksum);
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("Crossfade: all passed\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+// *************************************** InputFiltersTest.cpp *****************************************
+
+// Host test for the input filters (TransmitterCode/include/InputFilters.h). A noisy stick is moved in a step, a slow
+// ramp and not at all, at the top packet rate, and each filter (with the deadband that calibration measures) is
+// compared with what was there before: the raw value, sent whenever it moved by Smallest_Change = 4.
+// The default stick filter must get a step through as quickly, and a slow deliberate movement through sooner, while
+// sending fewer noise-driven changes. No filter may take more than 20 ms over a step or lag a slow movement by more than
+// 30 ms. (The old path's own mean lag looks tiny only because its noisy samples overshoot as often as they trail.)
+//
+// Build:   g++ -std=c++14 -Wall -I host -o InputFiltersTest InputFiltersTest.cpp
+// Use:     ./InputFiltersTest        (prints the latencies, then each failure, and exits with 1 if there were any)
+
+#include <Arduino.h>
+
+// The firmware's 1Definitions.h needs the whole Teensy build, so the little that InputFilters.h uses is here instead.
+// It must match 1Definitions.h.
+#define Definitions_H
+#define MAXRESOLUTION 4095
+#define PROPOCHANNELS 8
+#define PACEMAKER 2
+#define FILTER_NONE 0
+#define FILTER_MEDIAN 1
+#define FILTER_BIQUAD 2
+#define FILTER_ONEEURO 3
+#define MEDIANFILTERSIZE 5
+#define MEDIANNOISEGAIN 0.54f
+#define BIQUADCUTOFF 30.0f
+#define ONEEURO_MINCUTOFF 12.0f
+#define ONEEURO_BETA 0.003f
+#define ONEEURO_DCUTOFF 1.0f
+#define DEFAULTINPUTDEADBAND 4
+#define MAXINPUTDEADBAND 24
+#define NOISEOUTLIER 32
+
+namespace FHSS_data
+{
+    uint8_t PaceMaker = PACEMAKER; // The top rate
+}
+uint8_t InputFilterType[PROPOCHANNELS];
+uint8_t InputDeadband[PROPOCHANNELS];
+
+static uint32_t Now = 0; // us
+static uint16_t Stick = 2048;
+
+uint32_t micros()
+{
+    return Now;
+}
+
+int AnalogueReed(uint8_t InputChannel)
+{
+    return Stick;
+}
+
+int CheckRange(int v, int min, int max) // As in main.cpp
+{
+    if (v < min)
+        return min;
+    if (v > max)
+        return max;
+    return v;
+}
+
+#include "../include/InputFilters.h"
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, float Detail = 0)
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%.1f)\n", What, Detail);
+    ++Failures;
+}
+
+static uint32_t RandomState = 12345;
+
+static float Noise() // Gaussian, sigma 1 ADC count (Box-Muller over xorshift32, so every run is the same)
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    float u1 = ((RandomState >> 8) + 1) / 16777217.0f;
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    float u2 = (RandomState >> 8) / 16777216.0f;
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * PI * u2);
+}
+
+#define OLDFILTER 255 // Raw, sent when it moves by 4
+#define OLDSMALLESTCHANGE 4
+#define PASSUS (PACEMAKER * 1000)
+
+/*********************************************************************************************************************************/
+// Each run feeds the same noise to one input and follows the value that EncodeTheChangedChannels() would send.
+
+struct Run
+{
+    uint8_t Filter;
+    uint16_t Sent;
+    uint32_t Sends;
+};
+
+static void StartRun(Run *r, uint8_t Filter)
+{
+    r->Filter = Filter;
+    r->Sends = 0;
+    RandomState = 12345;
+    Now = 0;
+    Stick = 2048;
+    InputFilterType[0] = (Filter == OLDFILTER) ? FILTER_NONE : Filter;
+    StartInputNoiseMeasurement(); // Calibration: sticks centred for two seconds
+    for (uint16_t i = 0; i < 2000 / PACEMAKER; ++i)
+        MeasureInputNoise(0, 2048 + lroundf(Noise()));
+    SetDeadbandsFromNoise();
+    for (uint16_t i = 0; i < MEDIANFILTERSIZE * 4; ++i) // Settle
+    {
+        Now += PASSUS;
+        ReadFilteredInputs();
+    }
+    r->Sent = (Filter == OLDFILTER) ? 2048 : FilteredInput[0];
+}
+
+static void Pass(Run *r, float Truth)
+{
+    Now += PASSUS;
+    Stick = lroundf(Truth + Noise());
+    uint16_t Value = Stick;
+    int16_t Smallest = OLDSMALLESTCHANGE;
+    if (r->Filter != OLDFILTER)
+    {
+        ReadFilteredInputs();
+        Value = FilteredInput[0];
+        Smallest = 1; // transceiver.h now sends any change
+    }
+    if (abs(Value - r->Sent) >= Smallest)
+    {
+        r->Sent = Value;
+        ++r->Sends;
+    }
+}
+
+// ms from a 200 count step until 90% of it has been sent
+static float StepLatency(uint8_t Filter)
+{
+    Run r;
+    StartRun(&r, Filter);
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        Pass(&r, 2248);
+        if (r.Sent >= 2228)
+            return (i + 1) * PACEMAKER;
+    }
+    return 9999;
+}
+
+// A slow, deliberate movement: 40 counts a second (1% of the stick's travel) for two seconds. Returns the ms until the
+// sent value has followed it by 3 counts, and the mean lag (ms) over its second half.
+static void RampLatency(uint8_t Filter, float *FirstMove, float *MeanLag)
+{
+    const float Slope = 40.0f / 1000; // counts per ms
+    Run r;
+    StartRun(&r, Filter);
+    uint16_t Start = r.Sent;
+    *FirstMove = 9999;
+    float LagSum = 0;
+    uint32_t Lags = 0;
+    for (uint32_t i = 1; i <= 2000 / PACEMAKER; ++i)
+    {
+        float Truth = 2048 + Slope * i * PACEMAKER;
+        Pass(&r, Truth);
+        if ((*FirstMove > 9998) && (r.Sent >= Start + 3))
+            *FirstMove = i * PACEMAKER;
+        if (i > 1000 / PACEMAKER)
+        {
+            LagSum += (Truth - r.Sent) / Slope;
+            ++Lags;
+        }
+    }
+    *MeanLag = LagSum / Lags;
+}
+
+// Changes sent in ten seconds of a stick held still
+static uint32_t StillSends(uint8_t Filter)
+{
+    Run r;
+    StartRun(&r, Filter);
+    for (uint32_t i = 0; i < 10000 / PACEMAKER; ++i)
+        Pass(&r, 2048.3f);
+    return r.Sends;
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    static const uint8_t Filters[] = {OLDFILTER, FILTER_NONE, FILTER_MEDIAN, FILTER_BIQUAD, FILTER_ONEEURO};
+    static const char *Names[] = {"Before (raw, 4)", "None", "Median", "Biquad", "One-Euro"};
+    float Step[5], First[5], Lag[5];
+    uint32_t Still[5];
+    uint8_t Default = 0;
+
+    DefaultInputFilters();
+    printf("At %d ms per packet, sigma 1 count noise:\n", PACEMAKER);
+    printf("%-16s %10s %12s %12s %12s\n", "", "Step ms", "Ramp 1st ms", "Ramp lag ms", "Still sends");
+    for (uint8_t n = 0; n < 5; ++n)
+    {
+        Step[n] = StepLatency(Filters[n]);
+        RampLatency(Filters[n], &First[n], &Lag[n]);
+        Still[n] = StillSends(Filters[n]);
+        printf("%-16s %10.0f %12.0f %12.1f %12u\n", Names[n], Step[n], First[n], Lag[n], (unsigned)Still[n]);
+    }
+    uint8_t StickFilter;
+    DefaultInputFilters();
+    StickFilter = InputFilterType[0];
+    for (uint8_t n = 1; n < 5; ++n)
+    {
+        if (Filters[n] == StickFilter)
+            Default = n;
+    }
+    printf("Sticks default to %s\n", Names[Default]);
+
+    Check(Step[Default] <= Step[0] + PACEMAKER * 2, "Default stick filter is slower to follow a step", Step[Default]);
+    Check(First[Default] < First[0], "Default stick filter is slower to pass a small deliberate movement", First[Default]);
+    Check(Still[Default] < Still[0], "Default stick filter sends more noise", Still[Default]);
+    for (uint8_t n = 1; n < 5; ++n)
+    {
+        Check(Step[n] <= 20, "A filter takes more than 20 ms to follow a step", Filters[n]);
+        Check(Lag[n] <= 30, "A filter lags a slow movement by more than 30 ms", Filters[n]);
+    }
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("Input filters: all passed\n");
+    return 0;
+}
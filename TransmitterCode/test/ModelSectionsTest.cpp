@@ -0,0 +1,216 @@
+// *************************************** ModelSectionsTest.cpp *****************************************
+
+// Host test for the model section directory (TransmitterCode/include/ModelSections.h): a model written section by
+// section must read back from the offsets its directory gives, and a model whose directory doesn't match it must be
+// read as an older model (without the directory) so that the old checksum decides.
+//
+// Build:   g++ -std=c++14 -Wall -I host -o ModelSectionsTest ModelSectionsTest.cpp
+// Use:     ./ModelSectionsTest        (prints each failure, and exits with 1 if there were any)
+
+#include <Arduino.h>
+
+// The firmware's 1Definitions.h needs the whole Teensy build, so the little that ModelSections.h uses is here instead.
+// It must match 1Definitions.h.
+#define Definitions_H
+#define MODELSIZE 1024 * 3
+#define MODELFORMATVERSION 2
+#define MODELDIRECTORYMAGIC 0x5249444D
+#define MODELDIRECTORYOFFSET ((MODELSIZE) - 256)
+#define MAXMODELSECTIONS 16
+#define MSEC_IDENTITY 1
+#define MSEC_CURVES 2
+#define MSEC_MIXES 3
+#define MSEC_TRIMS 4
+#define MSEC_SETTINGS 5
+#define MSEC_CHANNELS 6
+#define MSEC_EXPO 7
+#define MSEC_MACROS 8
+#define MSEC_MODELID 9
+#define MSEC_OUTPUTS 10
+#define MSEC_ROTORFLIGHT 11
+#define MSEC_BANKS 12
+
+struct ModelSectionKind
+{
+    uint8_t ID;
+    uint8_t Version;
+};
+struct ModelSectionEntry
+{
+    uint8_t ID;
+    uint8_t Version;
+    uint16_t Offset;
+    uint16_t Length;
+    uint16_t Spare;
+    uint32_t Crc;
+};
+struct
+{
+    uint32_t Magic;
+    uint8_t Format;
+    uint8_t Count;
+    uint16_t Spare;
+} ModelDirectory;
+ModelSectionEntry ModelSections[MAXMODELSECTIONS];
+bool ModelDirectoryFound = false;
+int8_t OpenModelSection = -1;
+uint8_t SDBlock[MODELSIZE];
+int SDCardAddress = 0;
+int StartLocation = 0;
+
+uint32_t Crc32(const uint8_t *Data, uint32_t Length, uint32_t Crc = 0) // As in Utilities.h
+{
+    static const uint32_t Nibble[16] = {0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+                                        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+    Crc = ~Crc;
+    while (Length--)
+    {
+        Crc ^= *Data++;
+        Crc = (Crc >> 4) ^ Nibble[Crc & 15];
+        Crc = (Crc >> 4) ^ Nibble[Crc & 15];
+    }
+    return ~Crc;
+}
+
+#include "../include/ModelSections.h"
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, int Detail = 0)
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%d)\n", What, Detail);
+    ++Failures;
+}
+
+/*********************************************************************************************************************************/
+// Each section's bytes are made from its ID and length, so that any mix-up shows.
+
+static const uint16_t SectionLengths[] = {31, 320, 374, 170, 75, 176, 68, 128, 8, 141, 600, 65};
+
+static uint8_t SectionByte(uint8_t ID, uint16_t i)
+{
+    return (uint8_t)(ID * 37 + i * 11 + (i >> 8));
+}
+
+static void WriteBytes(uint8_t ID, uint16_t Length)
+{
+    for (uint16_t i = 0; i < Length; ++i)
+        SDBlock[SDCardAddress++] = SectionByte(ID, i);
+}
+
+// Writes a model the way SaveOneModel() does. Skip is a section to leave out (0 = none); with Reverse the sections go
+// in the opposite order, as a later layout might put them.
+static void SaveModel(uint8_t Skip, bool Reverse)
+{
+    memset(SDBlock, 0xFF, sizeof(SDBlock));
+    StartLocation = 0;
+    SDCardAddress = 0;
+    StartModelDirectory();
+    const uint8_t Count = sizeof(ModelSectionKinds) / sizeof(ModelSectionKinds[0]);
+    for (uint8_t k = 0; k < Count; ++k)
+    {
+        uint8_t n = Reverse ? (Count - 1 - k) : k;
+        uint8_t ID = ModelSectionKinds[n].ID;
+        if (ID == Skip)
+            continue;
+        BeginModelSection(ID);
+        WriteBytes(ID, SectionLengths[n]);
+    }
+    WriteModelDirectory();
+}
+
+// Reads a model the way ReadOneModel() does. Returns the number of sections whose bytes all matched.
+static uint8_t ReadModel(uint8_t Skip)
+{
+    uint8_t Matched = 0;
+    SDCardAddress = StartLocation;
+    ReadModelDirectory();
+    for (uint8_t n = 0; n < sizeof(ModelSectionKinds) / sizeof(ModelSectionKinds[0]); ++n)
+    {
+        uint8_t ID = ModelSectionKinds[n].ID;
+        bool Found = SeekModelSection(ID);
+        Check(Found == (ID != Skip), "SeekModelSection() found a missing section, or missed one", ID);
+        if (!Found)
+        {
+            Check(ModelSectionVersion(ID) == 0, "A missing section has a version", ID);
+            continue;
+        }
+        Check(ModelSectionVersion(ID) == ModelSectionKinds[n].Version, "Section version", ID);
+        bool Same = true;
+        for (uint16_t i = 0; i < SectionLengths[n]; ++i)
+            Same = Same && (SDBlock[SDCardAddress + i] == SectionByte(ID, i));
+        Check(Same, "Section read back differs", ID);
+        Matched += Same;
+    }
+    return Matched;
+}
+
+/*********************************************************************************************************************************/
+
+static void TestRoundTrip()
+{
+    SaveModel(0, false);
+    Check(ReadModel(0) == 12, "Round trip");
+    Check(ModelDirectoryFound, "Directory not found after a save");
+
+    SaveModel(0, true);
+    Check(ReadModel(0) == 12, "Round trip with the sections in another order");
+}
+
+static void TestMissingSection()
+{
+    for (uint8_t Skip = MSEC_CURVES; Skip <= MSEC_BANKS; ++Skip)
+    {
+        SaveModel(Skip, false);
+        Check(ReadModel(Skip) == 11, "Round trip without one section", Skip);
+    }
+}
+
+// Older firmware re-saves a model in the old layout without touching the directory: every section CRC must be checked
+// before the directory is believed. Without it the model is read in order, like any older model.
+static void TestStaleDirectory()
+{
+    SaveModel(0, false);
+    SDBlock[ModelSections[3].Offset + 5] ^= 0x40; // a re-saved trim
+    ReadModelDirectory();
+    Check(!ModelDirectoryFound, "A directory that doesn't match its model was believed");
+    SDCardAddress = 100;
+    Check(SeekModelSection(MSEC_TRIMS) && SDCardAddress == 100, "Without a directory, sections are read in order");
+    Check(ModelSectionVersion(MSEC_TRIMS) == 1, "Without a directory, every section is version 1");
+}
+
+static void TestDamagedDirectory()
+{
+    SaveModel(0, false);
+    SDBlock[MODELDIRECTORYOFFSET + 12] ^= 1; // first entry's offset
+    ReadModelDirectory();
+    Check(!ModelDirectoryFound, "A directory with a bad CRC32 was believed");
+
+    SaveModel(0, false);
+    memset(SDBlock + MODELDIRECTORYOFFSET, 0xFF, 256); // written before there were directories
+    ReadModelDirectory();
+    Check(!ModelDirectoryFound, "Found a directory in an older model");
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    const uint8_t Check9[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    Check(Crc32(Check9, 9) == 0xCBF43926, "Crc32() isn't the zip CRC-32");
+    TestRoundTrip();
+    TestMissingSection();
+    TestStaleDirectory();
+    TestDamagedDirectory();
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("Model sections: all passed\n");
+    return 0;
+}
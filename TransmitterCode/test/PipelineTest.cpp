@@ -0,0 +1,270 @@
+// *************************************** PipelineTest.cpp *****************************************
+
+// Host test for incremental evaluation of the channel pipeline (TransmitterCode/include/Pipeline.h): recomputing only
+// the curves that GetDirtyOutputs() names must always give the same results as recomputing every curve, whatever the
+// sticks, the input mixes, the bank and the rate do.
+//
+// Build:   g++ -std=c++14 -Wall -I host -o PipelineTest PipelineTest.cpp
+// Use:     ./PipelineTest        (prints each failure, and exits with 1 if there were any)
+
+#include <Arduino.h>
+
+// The firmware's 1Definitions.h needs the whole Teensy build, so the little that Pipeline.h and Mixes.h use is here
+// instead. It must match 1Definitions.h.
+#define Definitions_H
+#define CHANNELSUSED 16
+#define MAXMIXES 32
+#define PIPELINEFULLREFRESH 100
+#define MINMICROS 500
+#define MAXMICROS 2500
+#define HALFMICROSRANGE (MAXMICROS - MINMICROS) / 2
+#define M_MIX_OUTPUTS 0
+#define M_Bank 1
+#define M_MasterChannel 2
+#define M_SlaveChannel 3
+#define M_Reversed 4
+#define M_Percent 5
+#define M_MIX_INPUTS 6
+#define M_R2 7
+#define M_ONEDIRECTION 8
+#define M_OFFSET 9
+
+uint8_t Mixes[MAXMIXES + 1][17];
+uint8_t Bank = 1;
+uint8_t DualRateValue = 100;
+uint32_t ModelNumber = 1;
+bool PipelineNeedsFullRefresh = true;
+uint16_t InputsBuffer[CHANNELSUSED + 1];
+uint16_t LastRawInputs[CHANNELSUSED + 1];
+uint16_t CurveDeps[CHANNELSUSED];
+uint16_t CurveCache[CHANNELSUSED + 1];
+uint16_t ChannelMax[CHANNELSUSED + 1];
+uint16_t ChannelCentre[CHANNELSUSED + 1];
+uint16_t ChannelMin[CHANNELSUSED + 1];
+uint16_t SendBuffer[CHANNELSUSED + 1];
+uint16_t PreMixBuffer[CHANNELSUSED + 1];
+uint8_t MaxDegrees[5][CHANNELSUSED + 1];
+uint8_t MinDegrees[5][CHANNELSUSED + 1];
+
+static uint32_t Now = 0;
+
+uint32_t millis()
+{
+    return Now;
+}
+
+uint16_t IntoHigherRes(uint8_t LowRes) // As in Utilities.h
+{
+    return map(LowRes, 0, 180, MINMICROS, MAXMICROS);
+}
+
+void BuildSlowedChannels() // Slowed servos come after the curves, so they don't matter here
+{
+}
+
+#include "../include/Mixes.h"
+#include "../include/Pipeline.h"
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, int Detail = 0)
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%d)\n", What, Detail);
+    ++Failures;
+}
+
+static uint32_t RandomState = 12345;
+
+static uint32_t Random(uint32_t Range) // xorshift32, so every run is the same
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState % Range;
+}
+
+/*********************************************************************************************************************************/
+// A curve depends on its channel, the bank, the rate and the mixed input, and nothing else (the curve points themselves
+// only change with an edit, which invalidates the pipeline). Any curve will do as long as every input gives a different
+// output.
+
+static uint16_t Curve(uint16_t OutputChannel, uint16_t Input)
+{
+    return (uint16_t)(Input * (OutputChannel * 2 + 3) + Bank * 1009 + DualRateValue * 7);
+}
+
+static uint16_t Sticks[CHANNELSUSED]; // What GetAllInputs() would read
+
+static void Calibrate()
+{
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+    {
+        ChannelMin[ch] = 300 + Random(200);
+        ChannelCentre[ch] = 1900 + Random(200);
+        ChannelMax[ch] = 3500 + Random(200);
+        if (ch == 5 || ch == 11)
+        {
+            uint16_t Swap = ChannelMin[ch]; // a reversed input
+            ChannelMin[ch] = ChannelMax[ch];
+            ChannelMax[ch] = Swap;
+        }
+        Sticks[ch] = ChannelCentre[ch];
+    }
+}
+
+static void RandomMix(uint8_t MixNumber)
+{
+    memset(Mixes[MixNumber], 0, sizeof(Mixes[MixNumber]));
+    if (Random(4) == 0)
+        return; // not in use
+    Mixes[MixNumber][M_MIX_INPUTS] = 1;
+    Mixes[MixNumber][M_Bank] = Random(5); // 0 = every bank
+    Mixes[MixNumber][M_MasterChannel] = 1 + Random(CHANNELSUSED);
+    Mixes[MixNumber][M_SlaveChannel] = 1 + Random(CHANNELSUSED);
+    Mixes[MixNumber][M_Percent] = Random(101);
+    Mixes[MixNumber][M_Reversed] = Random(2);
+    Mixes[MixNumber][M_ONEDIRECTION] = Random(2);
+    Mixes[MixNumber][M_OFFSET] = 127 - 20 + Random(41);
+}
+
+static void RandomMixes()
+{
+    for (uint8_t MixNumber = 1; MixNumber < MAXMIXES; ++MixNumber)
+        RandomMix(MixNumber);
+}
+
+/*********************************************************************************************************************************/
+// One pass of GetNewChannelValues() as far as the curves, done both ways.
+
+static uint32_t Passes = 0;
+static uint32_t IncrementalPasses = 0;
+static uint32_t CurvesSkipped = 0;
+
+static void Pass()
+{
+    uint16_t Full[CHANNELSUSED];
+    memcpy(InputsBuffer, Sticks, sizeof(Sticks));
+    MixInputs();
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+        Full[ch] = Curve(ch, InputsBuffer[ch]);
+
+    memcpy(InputsBuffer, Sticks, sizeof(Sticks));
+    uint16_t Dirty = GetDirtyOutputs();
+    MixInputs();
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+    {
+        if (Dirty & (1 << ch))
+            CurveCache[ch] = Curve(ch, InputsBuffer[ch]);
+    }
+
+    for (uint16_t ch = 0; ch < CHANNELSUSED; ++ch)
+        Check(CurveCache[ch] == Full[ch], "Incremental curve differs from full recalculation", Passes * 100 + ch);
+    ++Passes;
+    if (Dirty != 0xFFFF)
+    {
+        ++IncrementalPasses;
+        CurvesSkipped += CHANNELSUSED - __builtin_popcount(Dirty);
+    }
+    Now += 4; // a fast packet rate, so there are many passes between the periodic full refreshes
+}
+
+static void MoveSticks()
+{
+    uint8_t Moves = Random(4); // often none, sometimes several
+    for (uint8_t i = 0; i < Moves; ++i)
+    {
+        uint8_t ch = Random(CHANNELSUSED);
+        uint16_t Low = (ChannelMin[ch] < ChannelMax[ch]) ? ChannelMin[ch] : ChannelMax[ch];
+        uint16_t High = (ChannelMin[ch] < ChannelMax[ch]) ? ChannelMax[ch] : ChannelMin[ch];
+        Sticks[ch] = Low + Random(High - Low + 1);
+    }
+}
+
+/*********************************************************************************************************************************/
+
+static void TestRandomFlying()
+{
+    Calibrate();
+    RandomMixes();
+    for (uint32_t Step = 0; Step < 200000; ++Step)
+    {
+        MoveSticks();
+        switch (Random(200))
+        {
+            case 0: // bank switch (4 is the Auto switch)
+                Bank = 1 + Random(4);
+                break;
+            case 1:
+                DualRateValue = (DualRateValue == 100) ? 75 : 100;
+                break;
+            case 2: // a mix edited on the screen: ButtonWasPressed() invalidates the pipeline
+                RandomMix(1 + Random(MAXMIXES - 1));
+                InvalidatePipeline();
+                break;
+            case 3: // another model
+                ++ModelNumber;
+                RandomMixes();
+                break;
+            default:
+                break;
+        }
+        Pass();
+    }
+    Check(IncrementalPasses > Passes / 2, "Too few passes were incremental", IncrementalPasses);
+    Check(CurvesSkipped > IncrementalPasses * (CHANNELSUSED / 2), "Too few curves were skipped", CurvesSkipped);
+}
+
+// A chain of mixes (1 into 2 into 3 ...) must make the end of the chain depend on its start, but a mix that reads a
+// channel BEFORE that channel's own mix runs must not.
+static void TestChains()
+{
+    Calibrate();
+    memset(Mixes, 0, sizeof(Mixes));
+    Bank = 1;
+    for (uint8_t i = 1; i <= 5; ++i)
+    {
+        Mixes[i][M_MIX_INPUTS] = 1;
+        Mixes[i][M_MasterChannel] = i;
+        Mixes[i][M_SlaveChannel] = i + 1;
+        Mixes[i][M_Percent] = 50;
+        Mixes[i][M_OFFSET] = 127;
+    }
+    Mixes[6][M_MIX_INPUTS] = 1; // 9 into 10 before 8 into 9
+    Mixes[6][M_MasterChannel] = 9;
+    Mixes[6][M_SlaveChannel] = 10;
+    Mixes[7][M_MIX_INPUTS] = 1;
+    Mixes[7][M_MasterChannel] = 8;
+    Mixes[7][M_SlaveChannel] = 9;
+    Mixes[8][M_MIX_INPUTS] = 1; // another bank's
+    Mixes[8][M_Bank] = 2;
+    Mixes[8][M_MasterChannel] = 12;
+    Mixes[8][M_SlaveChannel] = 13;
+    BuildPipelineDependencies();
+    Check(CurveDeps[5] == 0x3F, "Chained mixes", CurveDeps[5]);
+    Check(CurveDeps[9] == 0x300, "A mix that runs before its master is mixed", CurveDeps[9]);
+    Check(CurveDeps[8] == 0x180, "Simple mix", CurveDeps[8]);
+    Check(CurveDeps[12] == 0x1000, "Another bank's mix", CurveDeps[12]);
+    Bank = 2;
+    BuildPipelineDependencies();
+    Check(CurveDeps[12] == 0x1800, "This bank's mix", CurveDeps[12]);
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    TestChains();
+    TestRandomFlying();
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("Pipeline: all passed (%u of %u passes incremental, %u curves skipped)\n", (unsigned)IncrementalPasses,
+           (unsigned)Passes, (unsigned)CurvesSkipped);
+    return 0;
+}
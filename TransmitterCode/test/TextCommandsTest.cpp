@@ -0,0 +1,261 @@
+// *************************************** TextCommandsTest.cpp *****************************************
+
+// Host test for the table of Nextion word commands (TransmitterCode/include/TextCommands.h): every command, and every
+// command followed by an argument, must reach the same handler that the old chain of InStrng() tests in
+// ButtonWasPressed() called.
+//
+// Build:   g++ -std=c++14 -Wall -I host -o TextCommandsTest TextCommandsTest.cpp
+// Use:     ./TextCommandsTest        (prints each failure, and exits with 1 if there were any)
+
+#include <Arduino.h>
+
+// The firmware's 1Definitions.h needs the whole Teensy build, so the little that TextCommands.h uses is here instead.
+// It must match 1Definitions.h.
+#define Definitions_H
+#define MAXTEXTIN 1024 * 4
+#define MAXTEXTCOMMAND 16
+#define FNV1A_SEED 2166136261u
+#define TEXTCOMMANDHASHBITS 9
+
+char TextIn[MAXTEXTIN + 2];
+
+uint32_t FNV1aHashByte(uint32_t Hash, uint8_t b) // As in Utilities.h
+{
+    return (Hash ^ b) * 16777619u;
+}
+
+// Each handler just records its name.
+static const char *Called = nullptr;
+
+#define HANDLER(Name)        \
+    void Name()              \
+    {                        \
+        Called = #Name;      \
+    }
+
+HANDLER(SubTrimChannelChosen)
+HANDLER(SubTrimValueEdited)
+HANDLER(MainSetupChosen)
+HANDLER(MarkGPSLocation)
+HANDLER(DataViewEnd)
+HANDLER(ClearDataView)
+HANDLER(ZeroAltitude)
+HANDLER(StartHelpView)
+HANDLER(DecMinute)
+HANDLER(IncMinute)
+HANDLER(DecHour)
+HANDLER(IncHour)
+HANDLER(DecYear)
+HANDLER(IncYear)
+HANDLER(DecDate)
+HANDLER(IncDate)
+HANDLER(DecMonth)
+HANDLER(IncMonth)
+HANDLER(ReturnFromHelp)
+HANDLER(CurveTypeEdited)
+HANDLER(SendModelPressed)
+HANDLER(SaveFailSafe)
+HANDLER(StartFailSafeView)
+HANDLER(StartOneSwitchView)
+HANDLER(SwitchesViewEdited)
+HANDLER(StartInputsView)
+HANDLER(DeleteModFilePressed)
+HANDLER(StartSwitchesView)
+HANDLER(StartCalibrateView)
+HANDLER(ExportModel)
+HANDLER(ImportModel)
+HANDLER(ColoursSetupEnd)
+HANDLER(StartTypeView)
+HANDLER(RXBatteryTypeChosen)
+HANDLER(StartTrimView)
+HANDLER(CentreAllTrims)
+HANDLER(SetupChannel)
+HANDLER(FrontViewShown)
+HANDLER(StartSticksView)
+HANDLER(RescanWaveband)
+HANDLER(CycleScanMode)
+HANDLER(CycleLogSort)
+HANDLER(ShowWorstLinks)
+HANDLER(ExportModelFile)
+HANDLER(StartMixesView)
+HANDLER(MixesViewEdited)
+HANDLER(GraphViewShown)
+HANDLER(StartDataView)
+HANDLER(SelectBank1)
+HANDLER(SelectBank2)
+HANDLER(SelectBank3)
+HANDLER(SelectBank4)
+HANDLER(ResetExpo)
+HANDLER(CurveClickedX)
+HANDLER(CurveClickedY)
+HANDLER(CalibrateButtonPressed)
+
+#include "../include/TextCommands.h"
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, const char *Detail = "")
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%s)\n", What, Detail);
+    ++Failures;
+}
+
+/*********************************************************************************************************************************/
+// The old chain, in its order: the first command found anywhere in TextIn won, except Calibrate1 which had to be all of
+// it. (The CHxNAME= tests that sat in the middle are now HandleChannelNameEvents(). ScanMode, LogSort, WorstLinks and
+// ModFile were added at the end.)
+
+struct OldCommand
+{
+    const char *Name;
+    const char *Handler;
+};
+
+static const OldCommand OldChain[] = {
+    {"StCH", "SubTrimChannelChosen"},
+    {"StEDIT", "SubTrimValueEdited"},
+    {"MainSetup", "MainSetupChosen"},
+    {"Mark", "MarkGPSLocation"},
+    {"DataEnd", "DataViewEnd"},
+    {"Clear", "ClearDataView"},
+    {"AltZero", "ZeroAltitude"},
+    {"HelpView", "StartHelpView"},
+    {"DecMinute", "DecMinute"},
+    {"IncMinute", "IncMinute"},
+    {"DecHour", "DecHour"},
+    {"IncHour", "IncHour"},
+    {"DecYear", "DecYear"},
+    {"IncYear", "IncYear"},
+    {"DecDate", "DecDate"},
+    {"IncDate", "IncDate"},
+    {"DecMonth", "DecMonth"},
+    {"IncMonth", "IncMonth"},
+    {"GOTO:", "ReturnFromHelp"},
+    {"Exrite", "CurveTypeEdited"},
+    {"SendModel", "SendModelPressed"},
+    {"FailSAVE", "SaveFailSafe"},
+    {"FailSafe", "StartFailSafeView"},
+    {"OneSwitchView", "StartOneSwitchView"},
+    {"SwitchesView1", "SwitchesViewEdited"},
+    {"InputsView", "StartInputsView"},
+    {"DelFile", "DeleteModFilePressed"},
+    {"SwitchesView", "StartSwitchesView"},
+    {"CalibrateView", "StartCalibrateView"},
+    {"Export", "ExportModel"},
+    {"Import", "ImportModel"},
+    {"SetupCol", "ColoursSetupEnd"},
+    {"TypeView", "StartTypeView"},
+    {"RXBAT", "RXBatteryTypeChosen"},
+    {"TrimView", "StartTrimView"},
+    {"TRIMS50", "CentreAllTrims"},
+    {"Setup", "SetupChannel"},
+    {"FrontView", "FrontViewShown"},
+    {"SticksView", "StartSticksView"},
+    {"ReScan", "RescanWaveband"},
+    {"MIXESVIEW", "StartMixesView"},
+    {"MixesView", "MixesViewEdited"},
+    {"GraphView", "GraphViewShown"},
+    {"DataView", "StartDataView"},
+    {"FM 1", "SelectBank1"},
+    {"FM 2", "SelectBank2"},
+    {"FM 3", "SelectBank3"},
+    {"FM 4", "SelectBank4"},
+    {"Reset", "ResetExpo"},
+    {"ClickX", "CurveClickedX"},
+    {"ClickY", "CurveClickedY"},
+    {"Calibrate1", "CalibrateButtonPressed"},
+    {"ScanMode", "CycleScanMode"},
+    {"LogSort", "CycleLogSort"},
+    {"WorstLinks", "ShowWorstLinks"},
+    {"ModFile", "ExportModelFile"}};
+
+#define OLDCOMMANDS (sizeof(OldChain) / sizeof(OldChain[0]))
+
+static const char *OldHandler(const char *Text)
+{
+    for (uint8_t i = 0; i < OLDCOMMANDS; ++i)
+    {
+        if (!strcmp(OldChain[i].Name, "Calibrate1") ? !strcmp(Text, "Calibrate1") : (strstr(Text, OldChain[i].Name) != nullptr))
+            return OldChain[i].Handler;
+    }
+    return nullptr;
+}
+
+// Puts Text into TextIn as the Nextion would, and returns the name of the handler the table calls.
+static const char *NewHandler(const char *Text)
+{
+    memset(TextIn, 0, sizeof(TextIn));
+    strncpy(TextIn, Text, MAXTEXTIN);
+    const TextCommand *Command = FindTextCommand();
+    if (!Command)
+        return nullptr;
+    Called = nullptr;
+    Command->Handler();
+    return Called;
+}
+
+static bool SameName(const char *a, const char *b)
+{
+    return (a == b) || (a && b && !strcmp(a, b));
+}
+
+/*********************************************************************************************************************************/
+
+static void TestEveryCommand()
+{
+    Check(TEXTCOMMANDS == OLDCOMMANDS, "The table and the old chain have different numbers of commands");
+    for (uint8_t i = 0; i < TEXTCOMMANDS; ++i)
+    {
+        const char *Old = OldHandler(TextCommands[i].Name);
+        Check(Old != nullptr, "Command wasn't in the old chain", TextCommands[i].Name);
+        Check(SameName(NewHandler(TextCommands[i].Name), Old), "Command reaches a different handler", TextCommands[i].Name);
+    }
+    for (uint8_t i = 0; i < OLDCOMMANDS; ++i)
+        Check(SameName(NewHandler(OldChain[i].Name), OldChain[i].Handler), "Old command lost", OldChain[i].Name);
+}
+
+// What the Nextion sends after a command, and what HandleChannelNameEvents() leaves in front of one.
+static void TestArguments()
+{
+    static const char *Texts[] = {"Setup3", "Setup16", "  FM 2", "FM 4", "GOTO:GraphView", "GOTO:SticksView", "Import MODEL.MOD",
+                                  "DelFile OLDPLANE.MOD", "SwitchesView1", "SwitchesView", "SetupCol", "StCH5", "StEDIT-12",
+                                  "ClickX37", "ClickY120", "RXBAT2", "Exrite3", "TypeView"};
+    for (uint8_t i = 0; i < sizeof(Texts) / sizeof(Texts[0]); ++i)
+        Check(SameName(NewHandler(Texts[i]), OldHandler(Texts[i])), "Command with an argument reaches a different handler", Texts[i]);
+
+    Check(SameName(NewHandler("Setup3"), "SetupChannel"), "Setup3");
+    Check(SameName(NewHandler("  FM 2"), "SelectBank2"), "  FM 2");
+    Check(SameName(NewHandler("GOTO:GraphView"), "ReturnFromHelp"), "GOTO:GraphView");
+    Check(SameName(NewHandler("SetupCol"), "ColoursSetupEnd"), "SetupCol is longer than Setup");
+    Check(SameName(NewHandler("SwitchesView1"), "SwitchesViewEdited"), "SwitchesView1 is longer than SwitchesView");
+
+    char Blanked[40];
+    memset(Blanked, ' ', 14);              // "CH3NAME=Flaps" blanked, then the next command
+    strcpy(Blanked + 14, "FrontView");
+    Check(SameName(NewHandler(Blanked), "FrontViewShown"), "Command after a blanked channel name");
+
+    Check(NewHandler("") == nullptr, "Empty text found a command");
+    Check(NewHandler("    ") == nullptr, "Blanks found a command");
+    Check(NewHandler("NoSuchView") == nullptr, "Unknown text found a command");
+    Check(NewHandler("Calibrate") == nullptr, "A prefix of a command found it");
+    Check(NewHandler("Setu") == nullptr, "A prefix of Setup found it");
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    TestEveryCommand();
+    TestArguments();
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("Text commands: all passed\n");
+    return 0;
+}
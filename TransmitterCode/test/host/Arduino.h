@@ -0,0 +1,28 @@
+// *************************************** Arduino.h (host tests) *****************************************
+
+// Just enough of Arduino.h for the host tests in TransmitterCode/test to include the firmware's own headers.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define FASTRUN
+#define FLASHMEM
+#define PI 3.1415926535897932384626433832795
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+uint32_t millis(); // Each test that needs a clock supplies its own
+uint32_t micros(); //
+
+#endif
@@ -1060,13 +1060,14 @@ bool MTPStorage::updateDateTimeStamps(uint32_t handle, uint32_t dtCreated, uint3
 	return true;
 }
 
-void MTPStorage::read(uint32_t handle, uint32_t pos, char *out, uint32_t bytes)
+uint32_t MTPStorage::read(uint32_t handle, uint32_t pos, char *out, uint32_t bytes)
 {
 	OpenFileByIndex(handle);
 	mtp_lock_storage(true);
 	file_.seek(pos, SeekSet);
-	file_.read(out, bytes);
+	int got = file_.read(out, bytes);
 	mtp_lock_storage(false);
+	return (got > 0) ? got : 0;
 }
 
 
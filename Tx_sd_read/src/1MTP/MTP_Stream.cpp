@@ -0,0 +1,54 @@
+// MTP_Stream.cpp - moves object data between the storage and the bulk endpoints
+// in large pieces. See MTP_Stream.h.
+
+#include <string.h>
+#include "MTP_Stream.h"
+
+// The object is read size_ bytes at a time from a sector boundary, so each read
+// is one multi-block transfer straight into the buffer rather than a single
+// sector through the file system's cache for every USB packet (the 12 byte
+// header puts the packets out of step with the sectors).
+// usb_mtp_send() copies each packet into the USB core's own transmit buffers
+// and returns, so those packets go out while the next piece is being read.
+bool MTPStream::send(MTPStreamPort &port, uint32_t object_id, uint32_t pos, uint32_t size) {
+  uint32_t end = pos + size;
+  uint32_t buffer_pos = 0; // object position of buffer_[0]
+  uint32_t buffer_len = 0; // bytes in buffer_
+  while (pos < end) {
+    if (port.streamAborted()) return false;
+    if (pos >= buffer_pos + buffer_len) {
+      buffer_pos = pos & ~(SECTOR_SIZE - 1);
+      buffer_len = end - buffer_pos;
+      if (buffer_len > size_) buffer_len = size_;
+      uint32_t got = port.streamRead(object_id, buffer_pos, (char *)buffer_, buffer_len);
+      if (got < buffer_len) {
+        memset(buffer_ + got, 0, buffer_len - got); // the host was promised size bytes
+      }
+    }
+    pos += port.streamSend(buffer_ + (pos - buffer_pos), buffer_pos + buffer_len - pos);
+  }
+  return true;
+}
+
+// Received packets are gathered in the buffer and written size_ bytes at a
+// time. The object starts empty, so every write but the last starts and ends on
+// a sector boundary and goes to the card as one multi-block write, instead of a
+// partial sector (through the file system's cache) for every packet.
+bool MTPStream::receive(MTPStreamPort &port, uint32_t size, uint32_t &received) {
+  uint32_t buffered = 0;
+  received = 0;
+  while (received < size) {
+    uint32_t to_copy = size - received;
+    if (to_copy > size_ - buffered) to_copy = size_ - buffered;
+    uint32_t got = port.streamReceive(buffer_ + buffered, to_copy);
+    if (!got) return false;
+    buffered += got;
+    received += got;
+    if ((buffered == size_) || (received == size)) {
+      bool ok = (port.streamWrite((const char *)buffer_, buffered) == buffered);
+      buffered = 0;
+      if (!ok) return false;
+    }
+  }
+  return true;
+}
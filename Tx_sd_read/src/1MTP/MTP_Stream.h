@@ -0,0 +1,51 @@
+// MTP_Stream.h - moves object data between the storage and the bulk endpoints
+// in large pieces, for GetObject, GetPartialObject and SendObject.
+//
+// It knows nothing of the USB core or of any file system: MTP_class hands it
+// both ends as an MTPStreamPort. So it builds on a PC too, where
+// Tx_sd_read/test/MTPStreamBenchmark.cpp checks it and measures its throughput.
+
+#ifndef MTP_STREAM_H
+#define MTP_STREAM_H
+
+#include <stdint.h>
+
+// Both ends of an object transfer.
+class MTPStreamPort {
+public:
+  // true once the host has cancelled the transfer
+  virtual bool streamAborted() = 0;
+  // Reads up to len bytes of the object from pos. Returns the bytes read.
+  virtual uint32_t streamRead(uint32_t object_id, uint32_t pos, char *buffer, uint32_t len) = 0;
+  // Appends len bytes to the object being written. Returns the bytes written.
+  virtual uint32_t streamWrite(const char *data, uint32_t len) = 0;
+  // Copies up to len bytes into the bulk IN packet being filled, and sends
+  // that packet when it is full. Returns the bytes taken.
+  virtual uint32_t streamSend(const uint8_t *data, uint32_t len) = 0;
+  // Copies up to len bytes out of the bulk OUT packets, waiting for the next
+  // packet if need be. Returns the bytes copied, 0 if none came in time.
+  virtual uint32_t streamReceive(uint8_t *data, uint32_t len) = 0;
+};
+
+class MTPStream {
+public:
+  static const uint32_t SECTOR_SIZE = 512;
+
+  // buffer must hold a whole number of sectors
+  MTPStream(uint8_t *buffer, uint32_t size) : buffer_(buffer), size_(size) {}
+
+  // Sends size bytes of an object, from pos, after its data phase header.
+  // false if the host cancelled.
+  bool send(MTPStreamPort &port, uint32_t object_id, uint32_t pos, uint32_t size);
+
+  // Receives size bytes of an object and writes them to the storage.
+  // received is how many bytes were taken from the host, so that the rest can
+  // be drained. false if the host stopped sending or the storage failed.
+  bool receive(MTPStreamPort &port, uint32_t size, uint32_t &received);
+
+private:
+  uint8_t *buffer_;
+  uint32_t size_;
+};
+
+#endif
@@ -48,6 +48,12 @@ Stream *MTP_class::printStream_ = &Serial;
 
 #if defined(__IMXRT1062__)
 DMAMEM uint8_t MTP_class::disk_buffer_[DISK_BUFFER_SIZE] __attribute__((aligned(32)));
+#define STREAM_BUFFER MTP_class::disk_buffer_
+#define STREAM_BUFFER_SIZE MTP_class::DISK_BUFFER_SIZE
+#else
+static uint8_t stream_buffer[512];
+#define STREAM_BUFFER stream_buffer
+#define STREAM_BUFFER_SIZE 512
 #endif
 
 //#define DEBUG 2
@@ -464,27 +470,10 @@ uint32_t MTP_class::SendObject(struct MTPContainer &cmd) {
   // TODO: should we do storage_.Create() here?  Can we preallocate file size?
   uint32_t ret = MTP_RESPONSE_OK;
   uint32_t pos = 0;
-  while (pos < size) {
-    if (receive_buffer.data == NULL) {
-      if (!receive_bulk(100)) {
-        ret = MTP_RESPONSE_OPERATION_NOT_SUPPORTED;
-        break;
-      }
-    }
-    uint32_t to_copy = receive_buffer.len - receive_buffer.index;
-    if (to_copy > size) to_copy = size;
-    //printf("SendObject, pos=%u, write=%u, size=%u\n", pos, to_copy, size);
-    bool ok = storage_.write((char *)(receive_buffer.data + receive_buffer.index), to_copy);
-    if (!ok) {
-      ret = MTP_RESPONSE_OPERATION_NOT_SUPPORTED; // TODO: best response for write error??
-      // maybe send MTP_EVENT_CANCEL_TRANSACTION event??
-      break;
-    }
-    pos += to_copy;
-    receive_buffer.index += to_copy;
-    if (receive_buffer.index >= receive_buffer.len) {
-      free_received_bulk();
-    }
+  MTPStream stream(STREAM_BUFFER, STREAM_BUFFER_SIZE);
+  if (!stream.receive(*this, size, pos)) {
+    ret = MTP_RESPONSE_OPERATION_NOT_SUPPORTED; // TODO: best response for write error??
+    // maybe send MTP_EVENT_CANCEL_TRANSACTION event??
   }
   while (pos < size) {
     // consume remaining incoming data, if we aborted for any reason
@@ -578,25 +567,10 @@ uint32_t MTP_class::GetObject(struct MTPContainer &cmd) {
   uint32_t size = storage_.GetSize(object_id);
   //printf("GetObject, size=%u\n", size);
   writeDataPhaseHeader(cmd, size);
-  uint32_t pos = 0;
-  while (pos < size) {
-    if (usb_mtp_status != 0x01) {
-      //printf("GetObject, abort\n");
-      return 0;
-    }
-    if (transmit_buffer.data == NULL) allocate_transmit_bulk();
-    uint32_t avail = transmit_buffer.size - transmit_buffer.len;
-    uint32_t to_copy = size - pos;
-    if (to_copy > avail) to_copy = avail;
-    //printf("GetObject, read=%u, pos=%u\n", to_copy, pos);
-    // Read directly from storage into usb buffer.
-    storage_.read(object_id, pos,
-                   (char *)(transmit_buffer.data + transmit_buffer.len), to_copy);
-    pos += to_copy;
-    transmit_buffer.len += to_copy;
-    if (transmit_buffer.len >= transmit_buffer.size) {
-      transmit_bulk();
-    }
+  MTPStream stream(STREAM_BUFFER, STREAM_BUFFER_SIZE);
+  if (!stream.send(*this, object_id, 0, size)) {
+    //printf("GetObject, abort\n");
+    return 0;
   }
   write_finish();
   //printf("GetObject, done\n");
@@ -613,28 +587,15 @@ uint32_t MTP_class::GetPartialObject(struct MTPContainer &cmd) {
   uint32_t offset = cmd.params[1];
   uint32_t NumBytes = cmd.params[2];
   uint32_t size = storage_.GetSize(object_id);
-  size -= offset;
+  size = (offset < size) ? size - offset : 0;
   if (NumBytes < size) {
     size = NumBytes;
   }
   writeDataPhaseHeader(cmd, size);
-  uint32_t pos = offset; // into data
-  while (pos < size) {
-    if (usb_mtp_status != 0x01) {
-      //printf("GetPartialObject, abort\n");
-      return 0;
-    }
-    if (transmit_buffer.data == NULL) allocate_transmit_bulk();
-    uint32_t avail = transmit_buffer.size - transmit_buffer.len;
-    uint32_t to_copy = size - pos;
-    if (to_copy > avail) to_copy = avail;
-    storage_.read(object_id, pos,
-                   (char *)(transmit_buffer.data + transmit_buffer.len), to_copy);
-    pos += to_copy;
-    transmit_buffer.len += to_copy;
-    if (transmit_buffer.len >= transmit_buffer.size) {
-      transmit_bulk();
-    }
+  MTPStream stream(STREAM_BUFFER, STREAM_BUFFER_SIZE);
+  if (!stream.send(*this, object_id, offset, size)) {
+    //printf("GetPartialObject, abort\n");
+    return 0;
   }
   write_finish();
   cmd.params[0] = size;
@@ -1507,6 +1468,48 @@ void MTP_class::write(const void *ptr, int len) {
   }
 }
 
+// MTPStreamPort, so that MTPStream can move object data without knowing about
+// the USB core or the file system.
+bool MTP_class::streamAborted() {
+  return usb_mtp_status != 0x01;
+}
+
+uint32_t MTP_class::streamRead(uint32_t object_id, uint32_t pos, char *buffer, uint32_t len) {
+  return storage_.read(object_id, pos, buffer, len);
+}
+
+uint32_t MTP_class::streamWrite(const char *data, uint32_t len) {
+  return storage_.write(data, len);
+}
+
+uint32_t MTP_class::streamSend(const uint8_t *data, uint32_t len) {
+  if (transmit_buffer.data == NULL) allocate_transmit_bulk();
+  uint32_t to_copy = transmit_buffer.size - transmit_buffer.len;
+  if (to_copy > len) to_copy = len;
+  memcpy(transmit_buffer.data + transmit_buffer.len, data, to_copy);
+  transmit_buffer.len += to_copy;
+  if (transmit_buffer.len >= transmit_buffer.size) {
+    transmit_bulk();
+  }
+  return to_copy;
+}
+
+uint32_t MTP_class::streamReceive(uint8_t *data, uint32_t len) {
+  if (receive_buffer.data == NULL && !receive_bulk(100)) return 0;
+  while (receive_buffer.index >= receive_buffer.len) { // an empty packet
+    free_received_bulk();
+    if (!receive_bulk(100)) return 0;
+  }
+  uint32_t to_copy = receive_buffer.len - receive_buffer.index;
+  if (to_copy > len) to_copy = len;
+  memcpy(data, receive_buffer.data + receive_buffer.index, to_copy);
+  receive_buffer.index += to_copy;
+  if (receive_buffer.index >= receive_buffer.len) {
+    free_received_bulk();
+  }
+  return to_copy;
+}
+
 void MTP_class::write_finish() {
   if (transmit_buffer.data == NULL) {
     if (!write_transfer_open) return;
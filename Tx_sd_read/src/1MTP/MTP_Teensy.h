@@ -43,6 +43,7 @@ extern "C" int usb_mtp_sendEvent(const void *buffer, uint32_t len,
 extern "C" int usb_init_events(void);
 
 #include "MTP_Storage.h"
+#include "MTP_Stream.h"
 // modify strings if needed (see MTP.cpp how they are used)
 #define MTP_MANUF "PJRC"
 #define MTP_MODEL "Teensy"
@@ -63,7 +64,7 @@ extern volatile uint8_t usb_configuration;
 
 
 // MTP Responder.
-class MTP_class {
+class MTP_class : private MTPStreamPort {
 public:
   explicit constexpr MTP_class() {}
   int begin();
@@ -165,7 +166,7 @@ private:
 #define MTP_TX_SIZE MTP_TX_SIZE_480
 
   uint8_t tx_data_buffer[MTP_TX_SIZE] __attribute__((aligned(32))) = {0};
-  static const uint32_t DISK_BUFFER_SIZE = 4 * 1024; // used by MTP_Storage
+  static const uint32_t DISK_BUFFER_SIZE = 16 * 1024; // used by MTP_Storage, and by GetObject / SendObject
   uint8_t rx_data_buffer[MTP_RX_SIZE] __attribute__((aligned(32))) = {0};
   static uint8_t disk_buffer_[DISK_BUFFER_SIZE] __attribute__((aligned(32)));
   uint16_t transmit_packet_size_mask = 0x01FF;
@@ -201,6 +202,13 @@ private:
   uint32_t GetObject(struct MTPContainer &cmd);
   uint32_t GetPartialObject(struct MTPContainer &cmd);
 
+  // MTPStreamPort: the storage and the bulk endpoints, for MTPStream
+  bool streamAborted();
+  uint32_t streamRead(uint32_t object_id, uint32_t pos, char *buffer, uint32_t len);
+  uint32_t streamWrite(const char *data, uint32_t len);
+  uint32_t streamSend(const uint8_t *data, uint32_t len);
+  uint32_t streamReceive(uint8_t *data, uint32_t len);
+
   bool read(void *ptr, uint32_t size);
   bool read8(uint8_t *n) { return read(n, 1); }
   bool read16(uint16_t *n) { return read(n, 2); }
@@ -0,0 +1,307 @@
+// *************************************** MTPStreamBenchmark.cpp *****************************************
+
+// Host test and benchmark for the MTP object data path (Tx_sd_read/src/1MTP/MTP_Stream.cpp). A real file stands in
+// for the SD card and a fake bulk endpoint stands in for USB, with 512 byte packets as at high speed.
+// GetObject, GetPartialObject at random offsets and lengths, and SendObject must all move every byte unchanged. Then
+// each is timed with the 16K buffer the Teensy 4.1 uses and with a 512 byte one (one storage call per packet, as
+// before), and the MB/s and the storage calls per MB are printed.
+// The MB/s is the PC's own file system, not an SD card: it is the storage calls per MB that show the difference there.
+//
+// Build:   g++ -std=c++14 -O2 -Wall -I ../src/1MTP -o MTPStreamBenchmark MTPStreamBenchmark.cpp ../src/1MTP/MTP_Stream.cpp
+// Use:     ./MTPStreamBenchmark        (prints the throughput, then each failure, and exits with 1 if there were any)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "MTP_Stream.h"
+
+#define PACKET_SIZE 512             // MTP_TX_SIZE_480 / MTP_RX_SIZE_480
+#define DISK_BUFFER_SIZE (16 * 1024) // MTP_class::DISK_BUFFER_SIZE
+#define FILE_SIZE (8 * 1024 * 1024 + 333)
+
+/*********************************************************************************************************************************/
+
+static int Failures = 0;
+
+static void Check(bool Good, const char *What, long Detail = 0)
+{
+    if (Good)
+        return;
+    printf("FAIL: %s (%ld)\n", What, Detail);
+    ++Failures;
+}
+
+static uint32_t RandomState = 12345;
+
+static uint32_t Random(uint32_t Range) // xorshift32, so every run is the same
+{
+    RandomState ^= RandomState << 13;
+    RandomState ^= RandomState >> 17;
+    RandomState ^= RandomState << 5;
+    return RandomState % Range;
+}
+
+static uint8_t ByteAt(uint32_t Position) // what the test file holds
+{
+    return (uint8_t)((Position * 2654435761u) >> 24);
+}
+
+/*********************************************************************************************************************************/
+// The storage is a file on the PC (what MTPStorage does with the SD card), and the bulk endpoints are packets in memory
+// (what the USB core does).
+
+class FakePort : public MTPStreamPort
+{
+public:
+    FILE *File = nullptr;
+    uint32_t StorageCalls = 0;
+    uint32_t Packets = 0;
+    uint32_t AbortAfterPackets = 0xFFFFFFFF;
+    uint32_t FailWriteAfter = 0xFFFFFFFF; // bytes
+    uint32_t Written = 0;
+
+    // Bulk IN: everything sent, in order
+    std::vector<uint8_t> Sent;
+    uint32_t PacketFill = 0;
+
+    // Bulk OUT: what the host sends, cut into packets
+    std::vector<uint8_t> ToReceive;
+    uint32_t ReceivePos = 0;
+    uint32_t PacketLeft = 0;
+
+    bool streamAborted()
+    {
+        return Packets >= AbortAfterPackets;
+    }
+
+    uint32_t streamRead(uint32_t object_id, uint32_t pos, char *buffer, uint32_t len)
+    {
+        ++StorageCalls;
+        fseek(File, pos, SEEK_SET);
+        return fread(buffer, 1, len, File);
+    }
+
+    uint32_t streamWrite(const char *data, uint32_t len)
+    {
+        ++StorageCalls;
+        if (Written + len > FailWriteAfter)
+            len = FailWriteAfter - Written; // card full
+        Written += len;
+        return fwrite(data, 1, len, File);
+    }
+
+    uint32_t streamSend(const uint8_t *data, uint32_t len)
+    {
+        uint32_t to_copy = PACKET_SIZE - PacketFill;
+        if (to_copy > len)
+            to_copy = len;
+        Sent.insert(Sent.end(), data, data + to_copy);
+        PacketFill += to_copy;
+        if (PacketFill == PACKET_SIZE)
+        {
+            PacketFill = 0;
+            ++Packets;
+        }
+        return to_copy;
+    }
+
+    uint32_t streamReceive(uint8_t *data, uint32_t len)
+    {
+        while (!PacketLeft)
+        {
+            if (ReceivePos >= ToReceive.size())
+                return 0; // the host stopped sending
+            PacketLeft = PACKET_SIZE;
+            ++Packets;
+        }
+        uint32_t to_copy = PacketLeft;
+        if (to_copy > len)
+            to_copy = len;
+        if (to_copy > ToReceive.size() - ReceivePos)
+            to_copy = ToReceive.size() - ReceivePos;
+        memcpy(data, &ToReceive[ReceivePos], to_copy);
+        ReceivePos += to_copy;
+        PacketLeft -= to_copy;
+        return to_copy;
+    }
+};
+
+static uint8_t DiskBuffer[DISK_BUFFER_SIZE];
+static const char *TestFile = "MTPStreamBenchmark.tmp";
+
+static void MakeTestFile(uint32_t Size)
+{
+    FILE *f = fopen(TestFile, "wb");
+    std::vector<uint8_t> Data(Size);
+    for (uint32_t i = 0; i < Size; ++i)
+        Data[i] = ByteAt(i);
+    fwrite(Data.data(), 1, Size, f);
+    fclose(f);
+}
+
+/*********************************************************************************************************************************/
+// GetObject and GetPartialObject: what the host gets must be the file, from the offset, for the length asked.
+
+static bool SendMatches(uint32_t BufferSize, uint32_t Offset, uint32_t Size, uint32_t FileSize)
+{
+    FakePort Port;
+    Port.File = fopen(TestFile, "rb");
+    MTPStream Stream(DiskBuffer, BufferSize);
+    bool Good = Stream.send(Port, 1, Offset, Size) && (Port.Sent.size() == Size);
+    for (uint32_t i = 0; Good && i < Size; ++i)
+        Good = (Port.Sent[i] == ((Offset + i < FileSize) ? ByteAt(Offset + i) : 0)); // past the end it's padded with 0
+    fclose(Port.File);
+    return Good;
+}
+
+static void TestSend()
+{
+    const uint32_t FileSize = 100000;
+    MakeTestFile(FileSize);
+    Check(SendMatches(DISK_BUFFER_SIZE, 0, FileSize, FileSize), "GetObject");
+    Check(SendMatches(DISK_BUFFER_SIZE, 0, 0, FileSize), "Empty object");
+    for (uint32_t n = 0; n < 300; ++n)
+    {
+        uint32_t Offset = Random(FileSize);
+        uint32_t Size = Random(FileSize - Offset + 1);
+        Check(SendMatches(DISK_BUFFER_SIZE, Offset, Size, FileSize), "GetPartialObject", Offset);
+        Check(SendMatches(512, Offset, Size, FileSize), "GetPartialObject with a 512 byte buffer", Offset);
+    }
+    Check(SendMatches(DISK_BUFFER_SIZE, FileSize - 1000, 5000, FileSize), "A short read must be padded");
+
+    FakePort Port;
+    Port.File = fopen(TestFile, "rb");
+    Port.AbortAfterPackets = 20;
+    MTPStream Stream(DiskBuffer, DISK_BUFFER_SIZE);
+    Check(!Stream.send(Port, 1, 0, FileSize), "A cancelled GetObject must stop");
+    Check(Port.Sent.size() == 20 * PACKET_SIZE, "A cancelled GetObject sent too much", Port.Sent.size());
+    fclose(Port.File);
+}
+
+/*********************************************************************************************************************************/
+// SendObject: the file written must be what the host sent, and every write but the last must be whole buffers.
+
+static void FillToReceive(FakePort *Port, uint32_t Size)
+{
+    Port->ToReceive.resize(Size);
+    for (uint32_t i = 0; i < Size; ++i)
+        Port->ToReceive[i] = ByteAt(i + 7);
+}
+
+static bool FileHolds(const std::vector<uint8_t> &Data, uint32_t Size)
+{
+    FILE *f = fopen(TestFile, "rb");
+    std::vector<uint8_t> Got(Size + 1);
+    uint32_t Length = fread(Got.data(), 1, Size + 1, f);
+    fclose(f);
+    return (Length == Size) && !memcmp(Got.data(), Data.data(), Size);
+}
+
+static void TestReceive()
+{
+    for (uint32_t n = 0; n < 40; ++n)
+    {
+        uint32_t Size = (n < 3) ? n * DISK_BUFFER_SIZE : Random(300000);
+        FakePort Port;
+        FillToReceive(&Port, Size);
+        Port.File = fopen(TestFile, "wb");
+        MTPStream Stream(DiskBuffer, DISK_BUFFER_SIZE);
+        uint32_t Received = 0;
+        bool Good = Stream.receive(Port, Size, Received);
+        fclose(Port.File);
+        Check(Good && Received == Size, "SendObject", Size);
+        Check(FileHolds(Port.ToReceive, Size), "SendObject wrote something else", Size);
+        Check(Port.StorageCalls == (Size + DISK_BUFFER_SIZE - 1) / DISK_BUFFER_SIZE, "SendObject's writes weren't whole buffers", Size);
+    }
+
+    FakePort Port; // the host stops early
+    FillToReceive(&Port, 50000);
+    Port.File = fopen(TestFile, "wb");
+    MTPStream Stream(DiskBuffer, DISK_BUFFER_SIZE);
+    uint32_t Received = 0;
+    Check(!Stream.receive(Port, 60000, Received), "SendObject must fail when the host stops sending");
+    Check(Received == 50000, "SendObject lost count of what it received", Received);
+    fclose(Port.File);
+
+    FakePort Full; // the card fills up
+    FillToReceive(&Full, 100000);
+    Full.File = fopen(TestFile, "wb");
+    Full.FailWriteAfter = 40000;
+    Check(!Stream.receive(Full, 100000, Received), "SendObject must fail when the card is full");
+    Check(Received < 100000, "SendObject must leave the rest to be drained", Received);
+    fclose(Full.File);
+}
+
+/*********************************************************************************************************************************/
+
+struct Timing
+{
+    double MBPerSecond;
+    double CallsPerMB;
+};
+
+static Timing TimeSend(uint32_t BufferSize)
+{
+    FakePort Port;
+    Port.File = fopen(TestFile, "rb");
+    Port.Sent.reserve(FILE_SIZE);
+    MTPStream Stream(DiskBuffer, BufferSize);
+    auto Start = std::chrono::steady_clock::now();
+    Stream.send(Port, 1, 0, FILE_SIZE);
+    auto Finish = std::chrono::steady_clock::now();
+    fclose(Port.File);
+    double Seconds = std::chrono::duration<double>(Finish - Start).count();
+    return {FILE_SIZE / Seconds / 1e6, Port.StorageCalls / (FILE_SIZE / 1e6)};
+}
+
+static Timing TimeReceive(uint32_t BufferSize)
+{
+    FakePort Port;
+    FillToReceive(&Port, FILE_SIZE);
+    Port.File = fopen(TestFile, "wb");
+    MTPStream Stream(DiskBuffer, BufferSize);
+    uint32_t Received;
+    auto Start = std::chrono::steady_clock::now();
+    Stream.receive(Port, FILE_SIZE, Received);
+    fflush(Port.File);
+    auto Finish = std::chrono::steady_clock::now();
+    fclose(Port.File);
+    double Seconds = std::chrono::duration<double>(Finish - Start).count();
+    return {FILE_SIZE / Seconds / 1e6, Port.StorageCalls / (FILE_SIZE / 1e6)};
+}
+
+static void Benchmark()
+{
+    MakeTestFile(FILE_SIZE);
+    Timing Read16K = TimeSend(DISK_BUFFER_SIZE);
+    Timing Read512 = TimeSend(512);
+    Timing Write16K = TimeReceive(DISK_BUFFER_SIZE);
+    Timing Write512 = TimeReceive(512);
+    printf("%.1f MB object, %d byte packets:\n", FILE_SIZE / 1e6, PACKET_SIZE);
+    printf("%-28s %10s %16s\n", "", "MB/s", "Storage calls/MB");
+    printf("%-28s %10.1f %16.0f\n", "GetObject, 16K buffer", Read16K.MBPerSecond, Read16K.CallsPerMB);
+    printf("%-28s %10.1f %16.0f\n", "GetObject, 512 byte buffer", Read512.MBPerSecond, Read512.CallsPerMB);
+    printf("%-28s %10.1f %16.0f\n", "SendObject, 16K buffer", Write16K.MBPerSecond, Write16K.CallsPerMB);
+    printf("%-28s %10.1f %16.0f\n", "SendObject, 512 byte buffer", Write512.MBPerSecond, Write512.CallsPerMB);
+    Check(Read16K.CallsPerMB * 16 < Read512.CallsPerMB, "GetObject with 16K makes too many storage calls", Read16K.CallsPerMB);
+    Check(Write16K.CallsPerMB * 16 < Write512.CallsPerMB, "SendObject with 16K makes too many storage calls", Write16K.CallsPerMB);
+}
+
+/*********************************************************************************************************************************/
+
+int main()
+{
+    TestSend();
+    TestReceive();
+    Benchmark();
+    remove(TestFile);
+    if (Failures)
+    {
+        printf("%d failures\n", Failures);
+        return 1;
+    }
+    printf("MTP stream: all passed\n");
+    return 0;
+}